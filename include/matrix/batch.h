@@ -0,0 +1,375 @@
+/**
+ * @brief Batches of equally sized small matricies and the batched kernels over them
+ * @author Will Sharpsteen - wisharpsteen@gmail.com
+ */
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <cmath>
+#include <sycl/sycl.hpp>
+#include "templates.h"
+#include "customexceptions.h"
+#include "exec.h"
+#include "gpu.h"
+#include "vect.h"
+#include "matrix.h"
+#include "gemm.h"
+
+#ifndef BATCH_H
+#define BATCH_H
+
+namespace SKAS::matrix
+{
+    /**
+     * @brief count row-major rows x cols matricies stored back to back in one vect, item i starting at i * stride( ).
+     * batched operations run every item in one kernel launch under policy::device and over exec::pool( ) in chunks of
+     * items otherwise, so a batch of small systems pays one allocation, transfer and launch instead of one per matrix
+     */
+    template < SKAS::FlAd T >
+    class batch
+    {
+        private:
+        size_t items = 0;
+        size_t dim_n = 0;
+        size_t dim_m = 0;
+        vect::vect< T > data;
+
+        public:
+        batch( ) = default;
+
+        batch( const size_t count, const size_t rows, const size_t cols, const T initial_value, const exec::policy t_policy = exec::policy::seq )
+            : items( count ), dim_n( rows ), dim_m( cols ), data( count * rows * cols, initial_value, t_policy ) { }
+
+        /**
+         * @brief gathers matricies of one shape into a batch
+         * @exception matrixDimError thrown when the shapes differ
+         */
+        batch( const std::vector< matrix< T > >& pieces, const exec::policy t_policy = exec::policy::seq )
+            : items( pieces.size( ) ), dim_n( pieces.empty( ) ? 0 : pieces.front( ).nrow( ) ), dim_m( pieces.empty( ) ? 0 : pieces.front( ).ncol( ) )
+        {
+            std::vector< T > values;
+            values.reserve( items * dim_n * dim_m );
+            for ( const matrix< T >& piece : pieces )
+            {
+                if ( piece.nrow( ) != dim_n || piece.ncol( ) != dim_m ) throw matrixDimError{"CANNOT BATCH MATRICIES OF DIFFERENT DIMENSIONS"};
+                values.insert( values.end( ), piece.storage( ).begin( ), piece.storage( ).end( ) );
+            }
+            data = vect::vect< T >( std::move( values ), t_policy );
+        }
+
+        auto size( ) const -> size_t
+        {
+            return items;
+        }
+
+        auto nrow( ) const -> size_t
+        {
+            return dim_n;
+        }
+
+        auto ncol( ) const -> size_t
+        {
+            return dim_m;
+        }
+
+        auto stride( ) const -> size_t
+        {
+            return dim_n * dim_m;
+        }
+
+        /**
+         * @brief zero-copy view of item index
+         * @exception matrixDimError thrown for an index outside the batch
+         */
+        auto item( const size_t index ) const -> block_view< const vect::vect< T > >
+        {
+            if ( index >= items ) throw matrixDimError{"CANNOT VIEW ITEM OUTSIDE BATCH"};
+            return { &data, index * stride( ), dim_n, dim_m, dim_m };
+        }
+
+        auto item( const size_t index ) -> block_view< vect::vect< T > >
+        {
+            if ( index >= items ) throw matrixDimError{"CANNOT VIEW ITEM OUTSIDE BATCH"};
+            return { &data, index * stride( ), dim_n, dim_m, dim_m };
+        }
+
+        /**
+         * @brief copy of item index
+         */
+        auto get( const size_t index ) const -> matrix< T >
+        {
+            return matrix< T >( item( index ) );
+        }
+
+        auto storage( ) const -> const vect::vect< T >&
+        {
+            return data;
+        }
+
+        auto storage( ) -> vect::vect< T >&
+        {
+            return data;
+        }
+
+        auto get_policy( ) const -> exec::policy
+        {
+            return data.get_policy( );
+        }
+
+        auto set_policy( const exec::policy t_policy ) -> void
+        {
+            data.set_policy( t_policy );
+        }
+    };
+
+    /**
+     * @brief runs f( item ) for every item of a batch: one kernel launch of one work-item per item under policy::device,
+     * chunks of items over exec::pool( ) under policy::threaded. f returns 0 for an item that succeeded
+     * @param item_work rough flops per item, sizing the host chunks
+     * @return true when f failed for any item
+     */
+    template < typename F >
+    auto batch_for( const exec::policy p, const size_t count, const size_t item_work, F f ) -> bool
+    {
+        if ( !count ) return false;
+        if ( p == exec::policy::device )
+        {
+            sycl::queue& q = gpu::ctx( ).q;
+            size_t* dev_info = gpu::ctx( ).pool.allocate< size_t >( count );
+            q.parallel_for( sycl::range< 1 >( count ), [=]( sycl::id< 1 > id ) {
+                const size_t i = id;
+                dev_info[ i ] = f( i );
+            } );
+            std::vector< size_t > info( count );
+            q.memcpy( info.data( ), dev_info, count * sizeof( size_t ) ).wait( );
+            gpu::ctx( ).pool.deallocate( dev_info );
+            return std::any_of( info.begin( ), info.end( ), []( size_t v ) { return v != 0; } );
+        }
+        std::vector< size_t > info( count );
+        size_t* host_info = info.data( );
+        exec::for_chunks( p, count, std::max< size_t >( 1, exec::grain / std::max< size_t >( item_work, 1 ) ), [=]( size_t lo, size_t hi ) {
+            for ( size_t i = lo; i < hi; ++i ) host_info[ i ] = f( i );
+        } );
+        return std::any_of( info.begin( ), info.end( ), []( size_t v ) { return v != 0; } );
+    }
+
+    /**
+     * @brief cholesky of one n x n item in place: L on and below the diagonal, zeros above. runs on the host and in kernels
+     * @return 0 on success, otherwise 1 + the first column whose pivot is not positive
+     */
+    template < SKAS::FlAd T >
+    inline auto batch_chol_item( T* a, const size_t n ) -> size_t
+    {
+        const size_t info = chol_diag( a, n, 0, n );
+        if ( info ) return info;
+        for ( size_t i = 0; i < n; ++i )
+        {
+            for ( size_t j = i + 1; j < n; ++j ) a[ i * n + j ] = T{0};
+        }
+        return 0;
+    }
+
+    /**
+     * @brief solves one n x n system against its n x nrhs right-hand sides in place. LU with partial pivoting applies each
+     * row interchange and elimination to b as it factors, so no pivot vector is kept, then U is back substituted.
+     * a is overwritten. runs on the host and in kernels
+     * @return 0 on success, otherwise 1 + the first column without a nonzero pivot
+     */
+    template < SKAS::FlAd T >
+    inline auto batch_lu_solve_item( T* a, T* b, const size_t n, const size_t nrhs ) -> size_t
+    {
+        for ( size_t j = 0; j < n; ++j )
+        {
+            size_t pivot = j;
+            for ( size_t i = j + 1; i < n; ++i )
+            {
+                if ( std::abs( a[ i * n + j ] ) > std::abs( a[ pivot * n + j ] ) ) pivot = i;
+            }
+            if ( a[ pivot * n + j ] == T{0} ) return j + 1;
+            if ( pivot != j )
+            {
+                for ( size_t c = j; c < n; ++c )
+                {
+                    const T held = a[ j * n + c ];
+                    a[ j * n + c ] = a[ pivot * n + c ];
+                    a[ pivot * n + c ] = held;
+                }
+                for ( size_t c = 0; c < nrhs; ++c )
+                {
+                    const T held = b[ j * nrhs + c ];
+                    b[ j * nrhs + c ] = b[ pivot * nrhs + c ];
+                    b[ pivot * nrhs + c ] = held;
+                }
+            }
+            const T diag = a[ j * n + j ];
+            for ( size_t i = j + 1; i < n; ++i )
+            {
+                const T l = a[ i * n + j ] / diag;
+                for ( size_t c = j + 1; c < n; ++c ) a[ i * n + c ] -= l * a[ j * n + c ];
+                for ( size_t c = 0; c < nrhs; ++c ) b[ i * nrhs + c ] -= l * b[ j * nrhs + c ];
+            }
+        }
+        trsm_columns( false, false, false, n, a, n, b, nrhs, 0, nrhs );
+        return 0;
+    }
+
+    /**
+     * @brief triangular solve of one item in place of its right-hand sides, see trsm. runs on the host and in kernels
+     * @return 0 on success, otherwise 1 + the first zero on the diagonal
+     */
+    template < SKAS::FlAd T >
+    inline auto batch_trsm_item( const bool lower, const bool trans, const bool unit, const T* a, T* b, const size_t n, const size_t nrhs ) -> size_t
+    {
+        if ( !unit )
+        {
+            for ( size_t i = 0; i < n; ++i ) if ( a[ i * n + i ] == T{0} ) return i + 1;
+        }
+        trsm_columns( lower, trans, unit, n, a, n, b, nrhs, 0, nrhs );
+        return 0;
+    }
+
+    /**
+     * @brief C_i = alpha * op( A_i ) % op( B_i ) + beta * C_i for every item i. one work-item per element of every C_i on the
+     * device, the packed host gemm per item over exec::pool( ) otherwise (matmul kind for automatic)
+     * @exception matrixDimError thrown for incompatible dimensions or batch sizes, or an output aliasing an input.
+     * with beta == 0 a mis-shaped c_batch is replaced by the result
+     */
+    template < SKAS::FlAd T >
+    auto gemm( const bool trans_a, const bool trans_b, const T alpha, const batch< T >& a_batch, const batch< T >& b_batch, const T beta, batch< T >& c_batch ) -> void
+    {
+        const size_t count = a_batch.size( );
+        const size_t m = trans_a ? a_batch.ncol( ) : a_batch.nrow( );
+        const size_t k = trans_a ? a_batch.nrow( ) : a_batch.ncol( );
+        const size_t n = trans_b ? b_batch.nrow( ) : b_batch.ncol( );
+        if ( b_batch.size( ) != count || k != ( trans_b ? b_batch.ncol( ) : b_batch.nrow( ) ) ) throw matrixDimError{"CANNOT GEMM BATCHES OF INCOMPATIBLE DIMENSIONS"};
+        if ( &c_batch == &a_batch || &c_batch == &b_batch ) throw matrixDimError{"GEMM OUTPUT CANNOT ALIAS AN INPUT"};
+        if ( c_batch.size( ) != count || c_batch.nrow( ) != m || c_batch.ncol( ) != n )
+        {
+            if ( beta != T{0} ) throw matrixDimError{"GEMM OUTPUT DIMENSIONS DO NOT MATCH op( A ) % op( B )"};
+            c_batch = batch< T >( count, m, n, T{0}, exec::common( a_batch.get_policy( ), b_batch.get_policy( ) ) );
+        }
+        if ( !count || !m || !n ) return;
+
+        const exec::policy all = exec::common( exec::common( a_batch.get_policy( ), b_batch.get_policy( ) ), c_batch.get_policy( ) );
+        const exec::policy p = gpu::resolve( all, gpu::op_kind::matmul, count * m * n * k );
+        const size_t lda = a_batch.ncol( );
+        const size_t ldb = b_batch.ncol( );
+        const size_t a_stride = a_batch.stride( );
+        const size_t b_stride = b_batch.stride( );
+        const size_t c_stride = c_batch.stride( );
+        if ( p == exec::policy::device )
+        {
+            const T* dev_a = a_batch.storage( ).dev_data( );
+            const T* dev_b = b_batch.storage( ).dev_data( );
+            T* dev_c = beta == T{0} ? c_batch.storage( ).dev_discard( ) : c_batch.storage( ).dev_data( );
+            gpu::ctx( ).q.parallel_for( sycl::range< 1 >( count * m * n ), [=]( sycl::id< 1 > id ) {
+                const size_t e = id;
+                const size_t item = e / ( m * n );
+                const size_t r = e % ( m * n ) / n;
+                const size_t c = e % n;
+                const T* a_i = dev_a + item * a_stride;
+                const T* b_i = dev_b + item * b_stride;
+                T sum{ 0 };
+                for ( size_t kk = 0; kk < k; ++kk )
+                {
+                    sum += ( trans_a ? a_i[ kk * lda + r ] : a_i[ r * lda + kk ] ) * ( trans_b ? b_i[ c * ldb + kk ] : b_i[ kk * ldb + c ] );
+                }
+                T* out = dev_c + item * c_stride + r * n + c;
+                *out = beta == T{0} ? alpha * sum : alpha * sum + beta * *out;
+            } ).wait( );
+            return;
+        }
+
+        const T* a = a_batch.storage( ).data( );
+        const T* b = b_batch.storage( ).data( );
+        T* c = c_batch.storage( ).data( );
+        const exec::policy inner = p == exec::policy::threaded ? exec::policy::simd : p;
+        exec::for_chunks( p, count, std::max< size_t >( 1, exec::grain / std::max< size_t >( m * n * k, 1 ) ), [=]( size_t lo, size_t hi ) {
+            for ( size_t i = lo; i < hi; ++i )
+            {
+                host_matr::gemm( inner, trans_a, trans_b, m, n, k, alpha, a + i * a_stride, lda, b + i * b_stride, ldb, beta, c + i * c_stride, n );
+            }
+        } );
+    }
+
+    /**
+     * @brief cholesky factor L of every item, L_i L_i^T = A_i, in one launch
+     * @exception matrixDimError thrown for non-square items
+     * @exception solutionError thrown when any item is not positive definite
+     */
+    template < SKAS::FlAd T >
+    auto cholesky( const batch< T >& t_batch ) -> batch< T >
+    {
+        if ( t_batch.nrow( ) != t_batch.ncol( ) ) throw matrixDimError{"CANNOT FACTOR NON-SQUARE MATRIX"};
+        const size_t n = t_batch.nrow( );
+        const size_t stride = t_batch.stride( );
+        batch< T > L( t_batch );
+        const exec::policy p = gpu::resolve( t_batch.get_policy( ), gpu::op_kind::matmul, t_batch.size( ) * n * n * n / 3 );
+        T* base = p == exec::policy::device ? L.storage( ).dev_data( ) : L.storage( ).data( );
+        if ( batch_for( p, L.size( ), n * n * n / 3, [=]( size_t i ) { return batch_chol_item( base + i * stride, n ); } ) )
+        {
+            throw solutionError{"MATRIX IS NOT POSITIVE DEFINITE"};
+        }
+        return L;
+    }
+
+    /**
+     * @brief solves op( A_i ) X_i = B_i for triangular A_i in place of every B_i, in one launch. see trsm
+     * @exception matrixDimError thrown for incompatible dimensions or batch sizes
+     * @exception solutionError thrown for a zero on the diagonal of any item
+     */
+    template < SKAS::FlAd T >
+    auto trsm( const bool lower, const bool trans, const batch< T >& t_batch, batch< T >& b_batch, const bool unit = false ) -> void
+    {
+        const size_t n = t_batch.nrow( );
+        const size_t nrhs = b_batch.ncol( );
+        if ( t_batch.ncol( ) != n || b_batch.nrow( ) != n || b_batch.size( ) != t_batch.size( ) ) throw matrixDimError{"CANNOT SOLVE BATCHES OF INCOMPATIBLE DIMENSIONS"};
+        const size_t a_stride = t_batch.stride( );
+        const size_t b_stride = b_batch.stride( );
+        const exec::policy p = gpu::resolve( exec::common( t_batch.get_policy( ), b_batch.get_policy( ) ), gpu::op_kind::matmul, t_batch.size( ) * n * n * nrhs );
+        const T* a = p == exec::policy::device ? t_batch.storage( ).dev_data( ) : t_batch.storage( ).data( );
+        T* b = p == exec::policy::device ? b_batch.storage( ).dev_data( ) : b_batch.storage( ).data( );
+        if ( batch_for( p, t_batch.size( ), n * n * nrhs, [=]( size_t i ) { return batch_trsm_item( lower, trans, unit, a + i * a_stride, b + i * b_stride, n, nrhs ); } ) )
+        {
+            throw solutionError{"CANNOT SOLVE SINGULAR TRIANGULAR MATRIX"};
+        }
+    }
+
+    /**
+     * @brief solves A_i X_i = B_i for every item without forming inverses
+     * @param type std::string. "lu" (partial pivoting, one launch) or "spd" (cholesky and two triangular solves)
+     * @exception matrixDimError thrown for incompatible dimensions or batch sizes
+     * @exception solutionError thrown for a singular or indefinite item, or an incorrect type
+     */
+    template < SKAS::FlAd T >
+    auto solve( const batch< T >& a_batch, const batch< T >& b_batch, std::string type = "lu" ) -> batch< T >
+    {
+        const size_t n = a_batch.nrow( );
+        if ( a_batch.ncol( ) != n || b_batch.nrow( ) != n || b_batch.size( ) != a_batch.size( ) ) throw matrixDimError{"CANNOT SOLVE BATCHES OF INCOMPATIBLE DIMENSIONS"};
+        batch< T > x( b_batch );
+        if ( type == "spd" )
+        {
+            const batch< T > L = cholesky( a_batch );
+            trsm( true, false, L, x );
+            trsm( true, true, L, x );
+            return x;
+        }
+        if ( type != "lu" ) throw solutionError{"INCORRECT TYPE PARAMETER"};
+
+        const size_t nrhs = x.ncol( );
+        const size_t a_stride = a_batch.stride( );
+        const size_t b_stride = x.stride( );
+        batch< T > lu( a_batch );
+        const exec::policy p = gpu::resolve( exec::common( a_batch.get_policy( ), b_batch.get_policy( ) ), gpu::op_kind::matmul, a_batch.size( ) * n * n * ( n + nrhs ) );
+        T* a = p == exec::policy::device ? lu.storage( ).dev_data( ) : lu.storage( ).data( );
+        T* b = p == exec::policy::device ? x.storage( ).dev_data( ) : x.storage( ).data( );
+        if ( batch_for( p, a_batch.size( ), n * n * ( n + nrhs ), [=]( size_t i ) { return batch_lu_solve_item( a + i * a_stride, b + i * b_stride, n, nrhs ); } ) )
+        {
+            throw solutionError{"NON-INVERTIBLE MATRIX CANNOT BE SOLVED"};
+        }
+        return x;
+    }
+
+}; // namespace SKAS::matrix -end
+
+#endif
@@ -0,0 +1,659 @@
+/**
+ * @brief Fixed-size vectors and matricies with inline storage for small dense kernels
+ * @author Will Sharpsteen - wisharpsteen@gmail.com
+ */
+#include <iostream>
+#include <array>
+#include <vector>
+#include <algorithm>
+#include <concepts>
+#include <utility>
+#include <type_traits>
+#include <cmath>
+#include "templates.h"
+#include "customexceptions.h"
+#include "exec.h"
+#include "vect.h"
+#include "matrix.h"
+
+#ifndef FIXED_H
+#define FIXED_H
+
+namespace SKAS::fixed
+{
+    /**
+     * @brief calls f( std::integral_constant< size_t, I >{ } ) for every I in [ 0, N ), expanded at compile time
+     */
+    template < size_t N, typename F >
+    constexpr auto unroll( F&& f ) -> void
+    {
+        [&]< size_t... I >( std::index_sequence< I... > ) { ( f( std::integral_constant< size_t, I >{ } ), ... ); }( std::make_index_sequence< N >{ } );
+    }
+
+    /**
+     * @brief vector of N values stored inline. no heap, no policy and no device mirror: every operation is an
+     * unrolled host loop, so it is meant for the 2 to 4 element geometry done per record. converts to and from
+     * SKAS::vect::vect for anything larger
+     */
+    template < SKAS::FlAd T, size_t N >
+        requires ( N > 0 )
+    class vect
+    {
+        private:
+        std::array< T, N > elems{ };
+
+        public:
+        using value_type = T;
+
+        constexpr vect( ) = default;
+
+        template < typename... A >
+            requires ( sizeof...( A ) == N && ( std::convertible_to< A, T > && ... ) )
+        constexpr vect( const A... values ) : elems{ static_cast< T >( values )... } { }
+
+        /**
+         * @brief copies a dynamic vect of N values
+         * @exception vectDimError thrown when t_vect.size( ) != N
+         */
+        explicit vect( const SKAS::vect::vect< T >& t_vect )
+        {
+            if ( t_vect.size( ) != N ) throw vectDimError{"CANNOT COPY VECTOR INTO FIXED VECTOR OF DIFFERENT SIZE"};
+            std::copy_n( t_vect.data( ), N, elems.begin( ) );
+        }
+
+        static constexpr auto size( ) -> size_t
+        {
+            return N;
+        }
+
+        constexpr auto operator[]( const size_t index ) -> T&
+        {
+            return elems[ index ];
+        }
+
+        constexpr auto operator[]( const size_t index ) const -> const T&
+        {
+            return elems[ index ];
+        }
+
+        constexpr auto data( ) -> T*
+        {
+            return elems.data( );
+        }
+
+        constexpr auto data( ) const -> const T*
+        {
+            return elems.data( );
+        }
+
+        constexpr auto begin( ) const -> const T*
+        {
+            return elems.data( );
+        }
+
+        constexpr auto end( ) const -> const T*
+        {
+            return elems.data( ) + N;
+        }
+
+        /**
+         * @brief dynamic copy of the values, running under t_policy
+         */
+        auto toVect( const exec::policy t_policy = exec::policy::seq ) const -> SKAS::vect::vect< T >
+        {
+            return SKAS::vect::vect< T >( std::vector< T >( elems.begin( ), elems.end( ) ), t_policy );
+        }
+
+        constexpr auto operator+=( const vect& other ) -> vect&
+        {
+            unroll< N >( [&]( auto i ) { elems[ i ] += other[ i ]; } );
+            return *this;
+        }
+
+        constexpr auto operator-=( const vect& other ) -> vect&
+        {
+            unroll< N >( [&]( auto i ) { elems[ i ] -= other[ i ]; } );
+            return *this;
+        }
+
+        constexpr auto operator*=( const T scalar ) -> vect&
+        {
+            unroll< N >( [&]( auto i ) { elems[ i ] *= scalar; } );
+            return *this;
+        }
+
+        constexpr auto operator==( const vect& other ) const -> bool = default;
+    };
+
+    /**
+     * @brief R x C matrix stored inline in row-major order. dimensions are part of the type, so products and
+     * solves need no dimension checks and their loops unroll; determinant, inverse and cholesky are closed form
+     * up to the sizes where that pays. converts to and from SKAS::matrix::matrix
+     */
+    template < SKAS::FlAd T, size_t R, size_t C >
+        requires ( R > 0 && C > 0 )
+    class matrix
+    {
+        private:
+        std::array< T, R * C > elems{ };
+
+        public:
+        using value_type = T;
+
+        constexpr matrix( ) = default;
+
+        /**
+         * @brief values in row-major order
+         */
+        template < typename... A >
+            requires ( sizeof...( A ) == R * C && ( std::convertible_to< A, T > && ... ) )
+        constexpr matrix( const A... values ) : elems{ static_cast< T >( values )... } { }
+
+        /**
+         * @brief copies a dynamic matrix of any layout
+         * @exception matrixDimError thrown when t_matrix is not R x C
+         */
+        template < typename L >
+        explicit matrix( const SKAS::matrix::matrix< T, L >& t_matrix )
+        {
+            if ( t_matrix.nrow( ) != R || t_matrix.ncol( ) != C ) throw matrixDimError{"CANNOT COPY MATRIX INTO FIXED MATRIX OF DIFFERENT DIMENSIONS"};
+            if constexpr ( std::same_as< L, SKAS::matrix::row_major > )
+            {
+                std::copy_n( t_matrix.storage( ).data( ), R * C, elems.begin( ) );
+            }
+            else
+            {
+                for ( size_t r = 0; r < R; ++r )
+                {
+                    for ( size_t c = 0; c < C; ++c ) elems[ r * C + c ] = t_matrix.at( r, c );
+                }
+            }
+        }
+
+        static constexpr auto identity( ) -> matrix
+            requires ( R == C )
+        {
+            matrix out;
+            unroll< R >( [&]( auto i ) { out( i, i ) = T{1}; } );
+            return out;
+        }
+
+        static constexpr auto nrow( ) -> size_t
+        {
+            return R;
+        }
+
+        static constexpr auto ncol( ) -> size_t
+        {
+            return C;
+        }
+
+        constexpr auto operator()( const size_t row, const size_t col ) -> T&
+        {
+            return elems[ row * C + col ];
+        }
+
+        constexpr auto operator()( const size_t row, const size_t col ) const -> const T&
+        {
+            return elems[ row * C + col ];
+        }
+
+        constexpr auto data( ) -> T*
+        {
+            return elems.data( );
+        }
+
+        constexpr auto data( ) const -> const T*
+        {
+            return elems.data( );
+        }
+
+        constexpr auto row( const size_t index ) const -> vect< T, C >
+        {
+            vect< T, C > out;
+            unroll< C >( [&]( auto c ) { out[ c ] = elems[ index * C + c ]; } );
+            return out;
+        }
+
+        constexpr auto col( const size_t index ) const -> vect< T, R >
+        {
+            vect< T, R > out;
+            unroll< R >( [&]( auto r ) { out[ r ] = elems[ r * C + index ]; } );
+            return out;
+        }
+
+        constexpr auto t( ) const -> matrix< T, C, R >
+        {
+            matrix< T, C, R > out;
+            unroll< R >( [&]( auto r ) { unroll< C >( [&]( auto c ) { out( c, r ) = elems[ r * C + c ]; } ); } );
+            return out;
+        }
+
+        /**
+         * @brief dynamic row-major copy, running under t_policy
+         */
+        auto toMatrix( const exec::policy t_policy = exec::policy::seq ) const -> SKAS::matrix::matrix< T >
+        {
+            return SKAS::matrix::matrix< T >( SKAS::vect::vect< T >( std::vector< T >( elems.begin( ), elems.end( ) ) ), R, C, t_policy );
+        }
+
+        constexpr auto operator+=( const matrix& other ) -> matrix&
+        {
+            unroll< R * C >( [&]( auto i ) { elems[ i ] += other.elems[ i ]; } );
+            return *this;
+        }
+
+        constexpr auto operator-=( const matrix& other ) -> matrix&
+        {
+            unroll< R * C >( [&]( auto i ) { elems[ i ] -= other.elems[ i ]; } );
+            return *this;
+        }
+
+        constexpr auto operator*=( const T scalar ) -> matrix&
+        {
+            unroll< R * C >( [&]( auto i ) { elems[ i ] *= scalar; } );
+            return *this;
+        }
+
+        constexpr auto operator==( const matrix& other ) const -> bool = default;
+    };
+
+    //-----------------------VECT OPERATORS-----------------------
+
+    template < SKAS::FlAd T, size_t N >
+    constexpr auto operator+( vect< T, N > first, const vect< T, N >& last ) -> vect< T, N >
+    {
+        return first += last;
+    }
+
+    template < SKAS::FlAd T, size_t N >
+    constexpr auto operator-( vect< T, N > first, const vect< T, N >& last ) -> vect< T, N >
+    {
+        return first -= last;
+    }
+
+    template < SKAS::FlAd T, size_t N >
+    constexpr auto operator-( vect< T, N > t_vec ) -> vect< T, N >
+    {
+        return t_vec *= T{-1};
+    }
+
+    template < SKAS::FlAd T, size_t N, typename S >
+        requires std::is_arithmetic_v< S >
+    constexpr auto operator*( vect< T, N > t_vec, const S scalar ) -> vect< T, N >
+    {
+        return t_vec *= static_cast< T >( scalar );
+    }
+
+    template < SKAS::FlAd T, size_t N, typename S >
+        requires std::is_arithmetic_v< S >
+    constexpr auto operator*( const S scalar, vect< T, N > t_vec ) -> vect< T, N >
+    {
+        return t_vec *= static_cast< T >( scalar );
+    }
+
+    /**
+     * @brief dot product
+     */
+    template < SKAS::FlAd T, size_t N >
+    constexpr auto operator*( const vect< T, N >& first, const vect< T, N >& last ) -> T
+    {
+        T sum{ 0 };
+        unroll< N >( [&]( auto i ) { sum += first[ i ] * last[ i ]; } );
+        return sum;
+    }
+
+    /**
+     * @brief Euclidean norm
+     */
+    template < SKAS::FlAd T, size_t N >
+    auto mag( const vect< T, N >& t_vec ) -> T
+    {
+        return std::sqrt( t_vec * t_vec );
+    }
+
+    template < SKAS::FlAd T >
+    constexpr auto cross( const vect< T, 3 >& a, const vect< T, 3 >& b ) -> vect< T, 3 >
+    {
+        return { a[ 1 ] * b[ 2 ] - a[ 2 ] * b[ 1 ], a[ 2 ] * b[ 0 ] - a[ 0 ] * b[ 2 ], a[ 0 ] * b[ 1 ] - a[ 1 ] * b[ 0 ] };
+    }
+
+    //-----------------------MATRIX OPERATORS-----------------------
+
+    template < SKAS::FlAd T, size_t R, size_t C >
+    constexpr auto operator+( matrix< T, R, C > first, const matrix< T, R, C >& last ) -> matrix< T, R, C >
+    {
+        return first += last;
+    }
+
+    template < SKAS::FlAd T, size_t R, size_t C >
+    constexpr auto operator-( matrix< T, R, C > first, const matrix< T, R, C >& last ) -> matrix< T, R, C >
+    {
+        return first -= last;
+    }
+
+    template < SKAS::FlAd T, size_t R, size_t C >
+    constexpr auto operator-( matrix< T, R, C > t_matrix ) -> matrix< T, R, C >
+    {
+        return t_matrix *= T{-1};
+    }
+
+    template < SKAS::FlAd T, size_t R, size_t C, typename S >
+        requires std::is_arithmetic_v< S >
+    constexpr auto operator*( matrix< T, R, C > t_matrix, const S scalar ) -> matrix< T, R, C >
+    {
+        return t_matrix *= static_cast< T >( scalar );
+    }
+
+    template < SKAS::FlAd T, size_t R, size_t C, typename S >
+        requires std::is_arithmetic_v< S >
+    constexpr auto operator*( const S scalar, matrix< T, R, C > t_matrix ) -> matrix< T, R, C >
+    {
+        return t_matrix *= static_cast< T >( scalar );
+    }
+
+    /**
+     * @brief matrix product. rows and depth are unrolled; each step broadcasts a( i, k ) over a row of b, so the
+     * inner loop over the columns vectorizes
+     */
+    template < SKAS::FlAd T, size_t R, size_t K, size_t C >
+    constexpr auto operator%( const matrix< T, R, K >& a_matrix, const matrix< T, K, C >& b_matrix ) -> matrix< T, R, C >
+    {
+        matrix< T, R, C > product;
+        unroll< R >( [&]( auto i ) {
+            unroll< K >( [&]( auto k ) {
+                const T a_ik = a_matrix( i, k );
+                for ( size_t j = 0; j < C; ++j ) product( i, j ) += a_ik * b_matrix( k, j );
+            } );
+        } );
+        return product;
+    }
+
+    template < SKAS::FlAd T, size_t R, size_t C >
+    constexpr auto operator%( const matrix< T, R, C >& a_matrix, const vect< T, C >& x_vect ) -> vect< T, R >
+    {
+        vect< T, R > y;
+        unroll< R >( [&]( auto i ) { unroll< C >( [&]( auto j ) { y[ i ] += a_matrix( i, j ) * x_vect[ j ]; } ); } );
+        return y;
+    }
+
+    template < SKAS::FlAd T, size_t R, size_t C >
+    constexpr auto operator%( const vect< T, R >& x_vect, const matrix< T, R, C >& a_matrix ) -> vect< T, C >
+    {
+        vect< T, C > y;
+        unroll< R >( [&]( auto i ) { unroll< C >( [&]( auto j ) { y[ j ] += x_vect[ i ] * a_matrix( i, j ); } ); } );
+        return y;
+    }
+
+    //-----------------------FACTORIZATIONS-----------------------
+
+    /**
+     * @brief determinant. closed form through 4 x 4 ( the 4 x 4 from its 2 x 2 minors ), Gaussian elimination
+     * with partial pivoting beyond
+     */
+    template < SKAS::FlAd T, size_t N >
+    constexpr auto det( const matrix< T, N, N >& a ) -> T
+    {
+        if constexpr ( N == 1 ) return a( 0, 0 );
+        else if constexpr ( N == 2 ) return a( 0, 0 ) * a( 1, 1 ) - a( 0, 1 ) * a( 1, 0 );
+        else if constexpr ( N == 3 )
+        {
+            return a( 0, 0 ) * ( a( 1, 1 ) * a( 2, 2 ) - a( 1, 2 ) * a( 2, 1 ) )
+                 - a( 0, 1 ) * ( a( 1, 0 ) * a( 2, 2 ) - a( 1, 2 ) * a( 2, 0 ) )
+                 + a( 0, 2 ) * ( a( 1, 0 ) * a( 2, 1 ) - a( 1, 1 ) * a( 2, 0 ) );
+        }
+        else if constexpr ( N == 4 )
+        {
+            const T s0 = a( 0, 0 ) * a( 1, 1 ) - a( 1, 0 ) * a( 0, 1 );
+            const T s1 = a( 0, 0 ) * a( 1, 2 ) - a( 1, 0 ) * a( 0, 2 );
+            const T s2 = a( 0, 0 ) * a( 1, 3 ) - a( 1, 0 ) * a( 0, 3 );
+            const T s3 = a( 0, 1 ) * a( 1, 2 ) - a( 1, 1 ) * a( 0, 2 );
+            const T s4 = a( 0, 1 ) * a( 1, 3 ) - a( 1, 1 ) * a( 0, 3 );
+            const T s5 = a( 0, 2 ) * a( 1, 3 ) - a( 1, 2 ) * a( 0, 3 );
+            const T c5 = a( 2, 2 ) * a( 3, 3 ) - a( 3, 2 ) * a( 2, 3 );
+            const T c4 = a( 2, 1 ) * a( 3, 3 ) - a( 3, 1 ) * a( 2, 3 );
+            const T c3 = a( 2, 1 ) * a( 3, 2 ) - a( 3, 1 ) * a( 2, 2 );
+            const T c2 = a( 2, 0 ) * a( 3, 3 ) - a( 3, 0 ) * a( 2, 3 );
+            const T c1 = a( 2, 0 ) * a( 3, 2 ) - a( 3, 0 ) * a( 2, 2 );
+            const T c0 = a( 2, 0 ) * a( 3, 1 ) - a( 3, 0 ) * a( 2, 1 );
+            return s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+        }
+        else
+        {
+            matrix< T, N, N > u = a;
+            T product{ 1 };
+            for ( size_t k = 0; k < N; ++k )
+            {
+                size_t pivot = k;
+                for ( size_t r = k + 1; r < N; ++r ) if ( std::abs( u( r, k ) ) > std::abs( u( pivot, k ) ) ) pivot = r;
+                if ( u( pivot, k ) == T{0} ) return T{0};
+                if ( pivot != k )
+                {
+                    for ( size_t c = k; c < N; ++c ) std::swap( u( k, c ), u( pivot, c ) );
+                    product = -product;
+                }
+                product *= u( k, k );
+                for ( size_t r = k + 1; r < N; ++r )
+                {
+                    const T factor = u( r, k ) / u( k, k );
+                    for ( size_t c = k + 1; c < N; ++c ) u( r, c ) -= factor * u( k, c );
+                }
+            }
+            return product;
+        }
+    }
+
+    /**
+     * @brief inverse. closed-form adjugate through 4 x 4, Gauss-Jordan elimination with partial pivoting beyond
+     * @exception solutionError thrown for a singular matrix
+     */
+    template < SKAS::FlAd T, size_t N >
+    auto invert( const matrix< T, N, N >& a ) -> matrix< T, N, N >
+    {
+        if constexpr ( N == 1 )
+        {
+            if ( a( 0, 0 ) == T{0} ) throw solutionError{"NON-INVERTIBLE MATRIX CANNOT BE SOLVED"};
+            return { T{1} / a( 0, 0 ) };
+        }
+        else if constexpr ( N == 2 )
+        {
+            const T d = det( a );
+            if ( d == T{0} ) throw solutionError{"NON-INVERTIBLE MATRIX CANNOT BE SOLVED"};
+            const T s = T{1} / d;
+            return { a( 1, 1 ) * s, -a( 0, 1 ) * s, -a( 1, 0 ) * s, a( 0, 0 ) * s };
+        }
+        else if constexpr ( N == 3 )
+        {
+            const T b00 = a( 1, 1 ) * a( 2, 2 ) - a( 1, 2 ) * a( 2, 1 );
+            const T b10 = a( 1, 2 ) * a( 2, 0 ) - a( 1, 0 ) * a( 2, 2 );
+            const T b20 = a( 1, 0 ) * a( 2, 1 ) - a( 1, 1 ) * a( 2, 0 );
+            const T d = a( 0, 0 ) * b00 + a( 0, 1 ) * b10 + a( 0, 2 ) * b20;
+            if ( d == T{0} ) throw solutionError{"NON-INVERTIBLE MATRIX CANNOT BE SOLVED"};
+            const T s = T{1} / d;
+            return { b00 * s, ( a( 0, 2 ) * a( 2, 1 ) - a( 0, 1 ) * a( 2, 2 ) ) * s, ( a( 0, 1 ) * a( 1, 2 ) - a( 0, 2 ) * a( 1, 1 ) ) * s,
+                     b10 * s, ( a( 0, 0 ) * a( 2, 2 ) - a( 0, 2 ) * a( 2, 0 ) ) * s, ( a( 0, 2 ) * a( 1, 0 ) - a( 0, 0 ) * a( 1, 2 ) ) * s,
+                     b20 * s, ( a( 0, 1 ) * a( 2, 0 ) - a( 0, 0 ) * a( 2, 1 ) ) * s, ( a( 0, 0 ) * a( 1, 1 ) - a( 0, 1 ) * a( 1, 0 ) ) * s };
+        }
+        else if constexpr ( N == 4 )
+        {
+            const T s0 = a( 0, 0 ) * a( 1, 1 ) - a( 1, 0 ) * a( 0, 1 );
+            const T s1 = a( 0, 0 ) * a( 1, 2 ) - a( 1, 0 ) * a( 0, 2 );
+            const T s2 = a( 0, 0 ) * a( 1, 3 ) - a( 1, 0 ) * a( 0, 3 );
+            const T s3 = a( 0, 1 ) * a( 1, 2 ) - a( 1, 1 ) * a( 0, 2 );
+            const T s4 = a( 0, 1 ) * a( 1, 3 ) - a( 1, 1 ) * a( 0, 3 );
+            const T s5 = a( 0, 2 ) * a( 1, 3 ) - a( 1, 2 ) * a( 0, 3 );
+            const T c5 = a( 2, 2 ) * a( 3, 3 ) - a( 3, 2 ) * a( 2, 3 );
+            const T c4 = a( 2, 1 ) * a( 3, 3 ) - a( 3, 1 ) * a( 2, 3 );
+            const T c3 = a( 2, 1 ) * a( 3, 2 ) - a( 3, 1 ) * a( 2, 2 );
+            const T c2 = a( 2, 0 ) * a( 3, 3 ) - a( 3, 0 ) * a( 2, 3 );
+            const T c1 = a( 2, 0 ) * a( 3, 2 ) - a( 3, 0 ) * a( 2, 2 );
+            const T c0 = a( 2, 0 ) * a( 3, 1 ) - a( 3, 0 ) * a( 2, 1 );
+            const T d = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+            if ( d == T{0} ) throw solutionError{"NON-INVERTIBLE MATRIX CANNOT BE SOLVED"};
+            const T s = T{1} / d;
+            return { ( a( 1, 1 ) * c5 - a( 1, 2 ) * c4 + a( 1, 3 ) * c3 ) * s,
+                     ( -a( 0, 1 ) * c5 + a( 0, 2 ) * c4 - a( 0, 3 ) * c3 ) * s,
+                     ( a( 3, 1 ) * s5 - a( 3, 2 ) * s4 + a( 3, 3 ) * s3 ) * s,
+                     ( -a( 2, 1 ) * s5 + a( 2, 2 ) * s4 - a( 2, 3 ) * s3 ) * s,
+                     ( -a( 1, 0 ) * c5 + a( 1, 2 ) * c2 - a( 1, 3 ) * c1 ) * s,
+                     ( a( 0, 0 ) * c5 - a( 0, 2 ) * c2 + a( 0, 3 ) * c1 ) * s,
+                     ( -a( 3, 0 ) * s5 + a( 3, 2 ) * s2 - a( 3, 3 ) * s1 ) * s,
+                     ( a( 2, 0 ) * s5 - a( 2, 2 ) * s2 + a( 2, 3 ) * s1 ) * s,
+                     ( a( 1, 0 ) * c4 - a( 1, 1 ) * c2 + a( 1, 3 ) * c0 ) * s,
+                     ( -a( 0, 0 ) * c4 + a( 0, 1 ) * c2 - a( 0, 3 ) * c0 ) * s,
+                     ( a( 3, 0 ) * s4 - a( 3, 1 ) * s2 + a( 3, 3 ) * s0 ) * s,
+                     ( -a( 2, 0 ) * s4 + a( 2, 1 ) * s2 - a( 2, 3 ) * s0 ) * s,
+                     ( -a( 1, 0 ) * c3 + a( 1, 1 ) * c1 - a( 1, 2 ) * c0 ) * s,
+                     ( a( 0, 0 ) * c3 - a( 0, 1 ) * c1 + a( 0, 2 ) * c0 ) * s,
+                     ( -a( 3, 0 ) * s3 + a( 3, 1 ) * s1 - a( 3, 2 ) * s0 ) * s,
+                     ( a( 2, 0 ) * s3 - a( 2, 1 ) * s1 + a( 2, 2 ) * s0 ) * s };
+        }
+        else
+        {
+            matrix< T, N, N > u = a;
+            matrix< T, N, N > inv = matrix< T, N, N >::identity( );
+            for ( size_t k = 0; k < N; ++k )
+            {
+                size_t pivot = k;
+                for ( size_t r = k + 1; r < N; ++r ) if ( std::abs( u( r, k ) ) > std::abs( u( pivot, k ) ) ) pivot = r;
+                if ( u( pivot, k ) == T{0} ) throw solutionError{"NON-INVERTIBLE MATRIX CANNOT BE SOLVED"};
+                if ( pivot != k )
+                {
+                    for ( size_t c = 0; c < N; ++c )
+                    {
+                        std::swap( u( k, c ), u( pivot, c ) );
+                        std::swap( inv( k, c ), inv( pivot, c ) );
+                    }
+                }
+                const T scale = T{1} / u( k, k );
+                for ( size_t c = 0; c < N; ++c )
+                {
+                    u( k, c ) *= scale;
+                    inv( k, c ) *= scale;
+                }
+                for ( size_t r = 0; r < N; ++r )
+                {
+                    if ( r == k || u( r, k ) == T{0} ) continue;
+                    const T factor = u( r, k );
+                    for ( size_t c = 0; c < N; ++c )
+                    {
+                        u( r, c ) -= factor * u( k, c );
+                        inv( r, c ) -= factor * inv( k, c );
+                    }
+                }
+            }
+            return inv;
+        }
+    }
+
+    /**
+     * @brief lower triangular L with L L^T = a, read from the lower triangle of a. closed form for 2 x 2 and 3 x 3
+     * @exception solutionError thrown when a is not positive definite
+     */
+    template < SKAS::FlAd T, size_t N >
+    auto cholesky( const matrix< T, N, N >& a ) -> matrix< T, N, N >
+    {
+        auto root = []( const T value ) -> T {
+            if ( !( value > T{0} ) ) throw solutionError{"MATRIX IS NOT POSITIVE DEFINITE"};
+            return std::sqrt( value );
+        };
+        if constexpr ( N == 1 ) return { root( a( 0, 0 ) ) };
+        else if constexpr ( N == 2 )
+        {
+            const T l00 = root( a( 0, 0 ) );
+            const T l10 = a( 1, 0 ) / l00;
+            return { l00, T{0}, l10, root( a( 1, 1 ) - l10 * l10 ) };
+        }
+        else if constexpr ( N == 3 )
+        {
+            const T l00 = root( a( 0, 0 ) );
+            const T l10 = a( 1, 0 ) / l00;
+            const T l20 = a( 2, 0 ) / l00;
+            const T l11 = root( a( 1, 1 ) - l10 * l10 );
+            const T l21 = ( a( 2, 1 ) - l20 * l10 ) / l11;
+            return { l00, T{0}, T{0}, l10, l11, T{0}, l20, l21, root( a( 2, 2 ) - l20 * l20 - l21 * l21 ) };
+        }
+        else
+        {
+            matrix< T, N, N > L;
+            for ( size_t j = 0; j < N; ++j )
+            {
+                T diag = a( j, j );
+                for ( size_t k = 0; k < j; ++k ) diag -= L( j, k ) * L( j, k );
+                L( j, j ) = root( diag );
+                for ( size_t i = j + 1; i < N; ++i )
+                {
+                    T sum = a( i, j );
+                    for ( size_t k = 0; k < j; ++k ) sum -= L( i, k ) * L( j, k );
+                    L( i, j ) = sum / L( j, j );
+                }
+            }
+            return L;
+        }
+    }
+
+    /**
+     * @brief solves a x = b. through the closed-form inverse up to 3 x 3, Gaussian elimination with partial pivoting beyond
+     * @exception solutionError thrown for a singular matrix
+     */
+    template < SKAS::FlAd T, size_t N >
+    auto solve( const matrix< T, N, N >& a, const vect< T, N >& b ) -> vect< T, N >
+    {
+        if constexpr ( N <= 3 ) return invert( a ) % b;
+        else
+        {
+            matrix< T, N, N > u = a;
+            vect< T, N > x = b;
+            for ( size_t k = 0; k < N; ++k )
+            {
+                size_t pivot = k;
+                for ( size_t r = k + 1; r < N; ++r ) if ( std::abs( u( r, k ) ) > std::abs( u( pivot, k ) ) ) pivot = r;
+                if ( u( pivot, k ) == T{0} ) throw solutionError{"NON-INVERTIBLE MATRIX CANNOT BE SOLVED"};
+                if ( pivot != k )
+                {
+                    for ( size_t c = k; c < N; ++c ) std::swap( u( k, c ), u( pivot, c ) );
+                    std::swap( x[ k ], x[ pivot ] );
+                }
+                for ( size_t r = k + 1; r < N; ++r )
+                {
+                    const T factor = u( r, k ) / u( k, k );
+                    for ( size_t c = k + 1; c < N; ++c ) u( r, c ) -= factor * u( k, c );
+                    x[ r ] -= factor * x[ k ];
+                }
+            }
+            for ( size_t k = N; k-- > 0; )
+            {
+                T sum = x[ k ];
+                for ( size_t c = k + 1; c < N; ++c ) sum -= u( k, c ) * x[ c ];
+                x[ k ] = sum / u( k, k );
+            }
+            return x;
+        }
+    }
+
+    //-----------------------MISC-----------------------
+
+    template < SKAS::FlAd T, size_t N >
+    auto operator<<( std::ostream& os, const vect< T, N >& t_vec ) -> std::ostream&
+    {
+        os << "[";
+        for ( size_t i = 0; i < N; ++i ) os << t_vec[ i ] << ( i + 1 < N ? ", " : "" );
+        os << "]";
+        return os;
+    }
+
+    template < SKAS::FlAd T, size_t R, size_t C >
+    auto operator<<( std::ostream& os, const matrix< T, R, C >& t_matrix ) -> std::ostream&
+    {
+        for ( size_t r = 0; r < R; ++r )
+        {
+            os << "[ ";
+            for ( size_t c = 0; c < C; ++c ) os << t_matrix( r, c ) << " ";
+            os << "]\n";
+        }
+        return os;
+    }
+
+}; // namespace SKAS::fixed -end
+
+#endif
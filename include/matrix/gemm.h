@@ -0,0 +1,236 @@
+/**
+ * @brief Cache-blocked, packed host GEMM used by the host matrix paths
+ * @author Will Sharpsteen - wisharpsteen@gmail.com
+ */
+#include <cstddef>
+#include <algorithm>
+#include <vector>
+#include <functional>
+#include "templates.h"
+#include "exec.h"
+
+#ifndef GEMM_H
+#define GEMM_H
+
+namespace SKAS::matrix::host_matr
+{
+    /**
+     * @brief register and cache blocking of the packed GEMM. an MR x NR tile of C stays in registers
+     * through the micro-kernel, an MC x KC block of A is sized for L2 and a KC x NC panel of B for L3
+     */
+    template < SKAS::FlAd T >
+    struct gemm_blocking;
+
+    template < >
+    struct gemm_blocking< double >
+    {
+        static constexpr size_t MR = 4;
+        static constexpr size_t NR = 8;
+        static constexpr size_t MC = 96;
+        static constexpr size_t KC = 256;
+        static constexpr size_t NC = 2048;
+    };
+
+    template < >
+    struct gemm_blocking< float >
+    {
+        static constexpr size_t MR = 4;
+        static constexpr size_t NR = 16;
+        static constexpr size_t MC = 96;
+        static constexpr size_t KC = 512;
+        static constexpr size_t NC = 4096;
+    };
+
+    /**
+     * @brief packs rows [ row0, row0 + mc ) and depth [ p0, p0 + kc ) of op( A ) into MR-row panels,
+     * each stored depth-major ( MR values per depth step ) and zero padded to a full panel
+     */
+    template < SKAS::FlAd T >
+    auto pack_a( const exec::policy p, const T* a, const size_t lda, const bool trans, const size_t row0, const size_t mc, const size_t p0, const size_t kc, T* packed ) -> void
+    {
+        constexpr size_t MR = gemm_blocking< T >::MR;
+        const size_t panels = ( mc + MR - 1 ) / MR;
+        exec::for_chunks( p, panels, 4, [=]( size_t lo, size_t hi ) {
+            for ( size_t panel = lo; panel < hi; ++panel )
+            {
+                T* dst = packed + panel * MR * kc;
+                const size_t rows = std::min( MR, mc - panel * MR );
+                const size_t r0 = row0 + panel * MR;
+                for ( size_t d = 0; d < kc; ++d )
+                {
+                    for ( size_t i = 0; i < MR; ++i )
+                    {
+                        dst[ d * MR + i ] = i < rows ? ( trans ? a[ ( p0 + d ) * lda + r0 + i ] : a[ ( r0 + i ) * lda + p0 + d ] ) : T{0};
+                    }
+                }
+            }
+        } );
+    }
+
+    /**
+     * @brief packs depth [ p0, p0 + kc ) and columns [ col0, col0 + nc ) of op( B ) into NR-column panels,
+     * each stored depth-major ( NR values per depth step ) and zero padded to a full panel
+     */
+    template < SKAS::FlAd T >
+    auto pack_b( const exec::policy p, const T* b, const size_t ldb, const bool trans, const size_t p0, const size_t kc, const size_t col0, const size_t nc, T* packed ) -> void
+    {
+        constexpr size_t NR = gemm_blocking< T >::NR;
+        const size_t panels = ( nc + NR - 1 ) / NR;
+        exec::for_chunks( p, panels, 4, [=]( size_t lo, size_t hi ) {
+            for ( size_t panel = lo; panel < hi; ++panel )
+            {
+                T* dst = packed + panel * NR * kc;
+                const size_t cols = std::min( NR, nc - panel * NR );
+                const size_t c0 = col0 + panel * NR;
+                for ( size_t d = 0; d < kc; ++d )
+                {
+                    for ( size_t j = 0; j < NR; ++j )
+                    {
+                        dst[ d * NR + j ] = j < cols ? ( trans ? b[ ( c0 + j ) * ldb + p0 + d ] : b[ ( p0 + d ) * ldb + c0 + j ] ) : T{0};
+                    }
+                }
+            }
+        } );
+    }
+
+    /**
+     * @brief C[ 0:mr, 0:nr ] = alpha * Ap * Bp + beta * C for one packed MR-row panel of A and NR-column
+     * panel of B. beta == 0 overwrites C without reading it
+     */
+    template < SKAS::FlAd T >
+    inline auto micro_kernel( const size_t kc, const T* a, const T* b, const T alpha, const T beta, T* c, const size_t ldc, const size_t mr, const size_t nr ) -> void
+    {
+        constexpr size_t MR = gemm_blocking< T >::MR;
+        constexpr size_t NR = gemm_blocking< T >::NR;
+        T acc[ MR ][ NR ] = { };
+        for ( size_t d = 0; d < kc; ++d, a += MR, b += NR )
+        {
+            for ( size_t i = 0; i < MR; ++i )
+            {
+                const T a_i = a[ i ];
+                SKAS_SIMD
+                for ( size_t j = 0; j < NR; ++j ) acc[ i ][ j ] += a_i * b[ j ];
+            }
+        }
+        for ( size_t i = 0; i < mr; ++i )
+        {
+            T* c_row = c + i * ldc;
+            if ( beta == T{0} )
+            {
+                for ( size_t j = 0; j < nr; ++j ) c_row[ j ] = alpha * acc[ i ][ j ];
+            }
+            else
+            {
+                for ( size_t j = 0; j < nr; ++j ) c_row[ j ] = alpha * acc[ i ][ j ] + beta * c_row[ j ];
+            }
+        }
+    }
+
+    /**
+     * @brief C = alpha * op( A ) * op( B ) + beta * C on the host for row-major storage, where op( X ) is X or
+     * its transpose. C is m x n, op( A ) m x k and op( B ) k x n; lda / ldb / ldc are row strides of the
+     * stored arrays. B and A are packed per cache block, and the micro-tiles of each block are spread over
+     * exec::pool( ) under policy::threaded
+     */
+    template < SKAS::FlAd T >
+    auto gemm( const exec::policy p, const bool trans_a, const bool trans_b, const size_t m, const size_t n, const size_t k,
+               const T alpha, const T* a, const size_t lda, const T* b, const size_t ldb, const T beta, T* c, const size_t ldc ) -> void
+    {
+        using blocking = gemm_blocking< T >;
+        constexpr size_t MR = blocking::MR;
+        constexpr size_t NR = blocking::NR;
+
+        if ( !m || !n ) return;
+        if ( !k || alpha == T{0} )
+        {
+            for ( size_t i = 0; i < m; ++i )
+            {
+                for ( size_t j = 0; j < n; ++j ) c[ i * ldc + j ] = beta == T{0} ? T{0} : beta * c[ i * ldc + j ];
+            }
+            return;
+        }
+
+        // packing buffers are reused across calls on the same thread
+        static thread_local std::vector< T > packed_a;
+        static thread_local std::vector< T > packed_b;
+        packed_a.resize( ( blocking::MC + MR ) * blocking::KC );
+        packed_b.resize( ( blocking::NC + NR ) * blocking::KC );
+        T* pa = packed_a.data( );
+        T* pb = packed_b.data( );
+
+        for ( size_t jc = 0; jc < n; jc += blocking::NC )
+        {
+            const size_t nc = std::min( blocking::NC, n - jc );
+            const size_t n_panels = ( nc + NR - 1 ) / NR;
+            for ( size_t pc = 0; pc < k; pc += blocking::KC )
+            {
+                const size_t kc = std::min( blocking::KC, k - pc );
+                const T beta_block = pc == 0 ? beta : T{1};
+                pack_b( p, b, ldb, trans_b, pc, kc, jc, nc, pb );
+
+                for ( size_t ic = 0; ic < m; ic += blocking::MC )
+                {
+                    const size_t mc = std::min( blocking::MC, m - ic );
+                    const size_t m_panels = ( mc + MR - 1 ) / MR;
+                    pack_a( p, a, lda, trans_a, ic, mc, pc, kc, pa );
+
+                    // tiles run column-panel major so consecutive tiles share the same packed B panel
+                    const size_t tiles = m_panels * n_panels;
+                    const size_t min_tiles = std::max< size_t >( 1, ( size_t{1} << 16 ) / ( MR * NR * kc ) );
+                    exec::for_chunks( p, tiles, min_tiles, [=]( size_t lo, size_t hi ) {
+                        for ( size_t tile = lo; tile < hi; ++tile )
+                        {
+                            const size_t jr = tile / m_panels;
+                            const size_t ir = tile % m_panels;
+                            const size_t mr = std::min( MR, mc - ir * MR );
+                            const size_t nr = std::min( NR, nc - jr * NR );
+                            micro_kernel< T >( kc, pa + ir * MR * kc, pb + jr * NR * kc, alpha, beta_block,
+                                               c + ( ic + ir * MR ) * ldc + jc + jr * NR, ldc, mr, nr );
+                        }
+                    } );
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief y = alpha * op( A ) * x + beta * y on the host for a row-major rows x cols A with row stride lda.
+     * the plain form reduces each row against x, rows spread over exec::pool( ) under policy::threaded; the
+     * transposed form streams rows of A into a column slice of y per chunk, so A is read in storage order either way.
+     * beta == 0 overwrites y without reading it
+     */
+    template < SKAS::FlAd T >
+    auto gemv( const exec::policy p, const bool trans, const size_t rows, const size_t cols,
+               const T alpha, const T* a, const size_t lda, const T* x, const T beta, T* y ) -> void
+    {
+        const exec::policy inner = p == exec::policy::threaded ? exec::policy::simd : p;
+        if ( !trans )
+        {
+            const size_t min_rows = std::max< size_t >( 1, exec::grain / std::max< size_t >( cols, 1 ) );
+            exec::for_chunks( p, rows, min_rows, [=]( size_t lo, size_t hi ) {
+                for ( size_t i = lo; i < hi; ++i )
+                {
+                    const T* a_row = a + i * lda;
+                    const T sum = exec::reduce_n( inner, cols, T{0}, [=]( T& acc, size_t j ) { acc += a_row[ j ] * x[ j ]; }, std::plus< T >( ) );
+                    y[ i ] = beta == T{0} ? alpha * sum : alpha * sum + beta * y[ i ];
+                }
+            } );
+            return;
+        }
+
+        const size_t min_cols = std::max< size_t >( 64, exec::grain / std::max< size_t >( rows, 1 ) );
+        exec::for_chunks( p, cols, min_cols, [=]( size_t lo, size_t hi ) {
+            for ( size_t j = lo; j < hi; ++j ) y[ j ] = beta == T{0} ? T{0} : beta * y[ j ];
+            for ( size_t i = 0; i < rows; ++i )
+            {
+                const T scale = alpha * x[ i ];
+                const T* a_row = a + i * lda;
+                SKAS_SIMD
+                for ( size_t j = lo; j < hi; ++j ) y[ j ] += scale * a_row[ j ];
+            }
+        } );
+    }
+
+}; // namespace SKAS::matrix::host_matr -end
+
+#endif
@@ -0,0 +1,757 @@
+/**
+ * @brief Krylov iterative solvers ( CG, BiCGSTAB, GMRES ) and their preconditioners
+ * @author Will Sharpsteen - wisharpsteen@gmail.com
+ */
+#include <vector>
+#include <memory>
+#include <cmath>
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <sycl/sycl.hpp>
+#include "templates.h"
+#include "customexceptions.h"
+#include "exec.h"
+#include "gpu.h"
+#include "vect.h"
+#include "matrix.h"
+#include "gemm.h"
+#include "sparse.h"
+
+#ifndef KRYLOV_H
+#define KRYLOV_H
+
+namespace SKAS::matrix
+{
+    /**
+     * @brief stopping rule of an iterative solve
+     */
+    template < SKAS::FlAd T >
+    struct krylov_options
+    {
+        T tolerance = T( 1e-8 );        // stop once ||r|| <= tolerance * ||b||
+        size_t max_iterations = 1000;
+        size_t check_every = 10;        // iterations between host reads of the residual norm
+        size_t restart = 30;            // gmres basis size before a restart
+    };
+
+    /**
+     * @brief outcome of an iterative solve. residual is ||r|| / ||b|| at the last check ( ||r|| when b is zero )
+     */
+    template < SKAS::FlAd T >
+    struct krylov_result
+    {
+        size_t iterations = 0;
+        T residual = T{0};
+        bool converged = false;
+    };
+
+    /**
+     * @brief the vector kernels a Krylov iteration is built from, over raw host or device pointers as the policy picks.
+     * under policy::device every kernel goes to the in-order gpu::ctx( ).q without waiting and the iteration scalars live
+     * in device memory, where scalar( ) tasks update them, so nothing travels back to the host until read( )
+     */
+    template < SKAS::FlAd T >
+    class krylov_engine
+    {
+        private:
+        exec::policy pol;
+        size_t dim;
+        std::vector< T > host_slots;
+        T* dev_slots = nullptr;
+
+        public:
+        krylov_engine( const exec::policy t_policy, const size_t n, const size_t slots ) : pol( t_policy ), dim( n )
+        {
+            if ( pol == exec::policy::device )
+            {
+                dev_slots = gpu::ctx( ).pool.allocate< T >( slots );
+                gpu::ctx( ).q.memset( dev_slots, 0, slots * sizeof( T ) );
+            }
+            else
+            {
+                host_slots.assign( slots, T{0} );
+            }
+        }
+
+        krylov_engine( const krylov_engine& ) = delete;
+        krylov_engine& operator=( const krylov_engine& ) = delete;
+
+        ~krylov_engine( )
+        {
+            if ( dev_slots )
+            {
+                gpu::ctx( ).q.wait( );
+                gpu::ctx( ).pool.deallocate( dev_slots );
+            }
+        }
+
+        auto on_device( ) const -> bool
+        {
+            return pol == exec::policy::device;
+        }
+
+        auto get_policy( ) const -> exec::policy
+        {
+            return pol;
+        }
+
+        auto size( ) const -> size_t
+        {
+            return dim;
+        }
+
+        /**
+         * @brief scalar slots, in device memory under policy::device
+         */
+        auto slots( ) -> T*
+        {
+            return on_device( ) ? dev_slots : host_slots.data( );
+        }
+
+        auto ptr( vect::vect< T >& t_vect ) -> T*
+        {
+            return on_device( ) ? t_vect.dev_data( ) : t_vect.data( );
+        }
+
+        auto ptr( const vect::vect< T >& t_vect ) -> const T*
+        {
+            return on_device( ) ? t_vect.dev_data( ) : t_vect.data( );
+        }
+
+        /**
+         * @brief writable values of a vect whose old values are not needed, so nothing is uploaded
+         */
+        auto fresh( vect::vect< T >& t_vect ) -> T*
+        {
+            return on_device( ) ? t_vect.dev_discard( ) : t_vect.data( );
+        }
+
+        /**
+         * @brief f( i ) for i in [ 0, count )
+         */
+        template < typename F >
+        auto each( const size_t count, F f ) -> void
+        {
+            if ( !count ) return;
+            if ( on_device( ) )
+            {
+                gpu::ctx( ).q.parallel_for( sycl::range< 1 >( count ), [=]( sycl::id< 1 > id ) { f( size_t( id ) ); } );
+                return;
+            }
+            exec::for_n( pol, count, f );
+        }
+
+        template < typename F >
+        auto each( F f ) -> void
+        {
+            each( dim, f );
+        }
+
+        /**
+         * @brief *out = f( 0 ) + ... + f( size( ) - 1 ), out being a slot
+         */
+        template < typename F >
+        auto reduce( F f, T* out ) -> void
+        {
+            if ( on_device( ) )
+            {
+                gpu::transform_reduce_n( dim, f, std::plus< T >( ), T{0}, out );
+                return;
+            }
+            *out = exec::reduce_n( pol, dim, T{0}, [=]( T& acc, size_t i ) { acc += f( i ); }, std::plus< T >( ) );
+        }
+
+        /**
+         * @brief f( ) once, in order with the kernels around it, for updating slots
+         */
+        template < typename F >
+        auto scalar( F f ) -> void
+        {
+            if ( on_device( ) )
+            {
+                gpu::ctx( ).q.single_task( f );
+                return;
+            }
+            f( );
+        }
+
+        /**
+         * @brief value of a slot on the host. the only point an iteration waits on the device
+         */
+        auto read( const size_t slot ) -> T
+        {
+            if ( !on_device( ) ) return host_slots[ slot ];
+            T value;
+            gpu::ctx( ).q.memcpy( &value, dev_slots + slot, sizeof( T ) ).wait( );
+            return value;
+        }
+    };
+
+    /**
+     * @brief y = A x for a sparse A through spmv's kernels. on the device the product is only enqueued, in order with the
+     * rest of the iteration
+     */
+    template < SKAS::FlAd T >
+    auto krylov_apply( krylov_engine< T >& eng, const sparse_matrix< T >& a_matrix, const vect::vect< T >& x, vect::vect< T >& y ) -> void
+    {
+        if ( eng.on_device( ) )
+        {
+            accel_matr::PM_spmv_into( T{1}, a_matrix, x, T{0}, y );
+            return;
+        }
+        host_matr::spmv( eng.get_policy( ), a_matrix.nrow( ), a_matrix.nnz( ), a_matrix.row_offsets( ).data( ), a_matrix.columns( ).data( ),
+                         a_matrix.values( ).data( ), T{1}, x.data( ), T{0}, y.data( ) );
+    }
+
+    /**
+     * @brief y = A x for a dense row-major A through gemv's kernels. on the device the product is only enqueued, in order
+     * with the rest of the iteration
+     */
+    template < SKAS::FlAd T >
+    auto krylov_apply( krylov_engine< T >& eng, const matrix< T >& a_matrix, const vect::vect< T >& x, vect::vect< T >& y ) -> void
+    {
+        if ( eng.on_device( ) )
+        {
+            accel_matr::PM_gemv_into( false, T{1}, a_matrix, x, T{0}, y );
+            return;
+        }
+        host_matr::gemv( eng.get_policy( ), false, a_matrix.nrow( ), a_matrix.ncol( ), T{1}, a_matrix.storage( ).data( ), a_matrix.ncol( ), x.data( ), T{0}, y.data( ) );
+    }
+
+    /**
+     * @brief z = r, for unpreconditioned solves
+     */
+    template < SKAS::FlAd T >
+    struct identity_preconditioner
+    {
+        auto apply( krylov_engine< T >& eng, const T* r, T* z ) const -> void
+        {
+            eng.each( [=]( size_t i ) { z[ i ] = r[ i ]; } );
+        }
+    };
+
+    /**
+     * @brief Jacobi preconditioner, z = D^-1 r for the diagonal D of A
+     */
+    template < SKAS::FlAd T >
+    class jacobi
+    {
+        private:
+        vect::vect< T > inv_diag;
+
+        template < typename A >
+        auto build( const A& a_matrix ) -> void
+        {
+            if ( a_matrix.nrow( ) != a_matrix.ncol( ) ) throw matrixDimError{"CANNOT PRECONDITION NON-SQUARE MATRIX"};
+            std::vector< T > d( a_matrix.nrow( ) );
+            for ( size_t i = 0; i < d.size( ); ++i )
+            {
+                const T a_ii = a_matrix.at( i, i );
+                if ( a_ii == T{0} ) throw solutionError{"JACOBI PRECONDITIONER NEEDS A NONZERO DIAGONAL"};
+                d[ i ] = T{1} / a_ii;
+            }
+            inv_diag = vect::vect< T >( std::move( d ), a_matrix.get_policy( ) );
+        }
+
+        public:
+        explicit jacobi( const matrix< T >& a_matrix )
+        {
+            build( a_matrix );
+        }
+
+        explicit jacobi( const sparse_matrix< T >& a_matrix )
+        {
+            build( a_matrix );
+        }
+
+        auto apply( krylov_engine< T >& eng, const T* r, T* z ) const -> void
+        {
+            const T* d = eng.ptr( inv_diag );
+            eng.each( [=]( size_t i ) { z[ i ] = d[ i ] * r[ i ]; } );
+        }
+    };
+
+    /**
+     * @brief rows of a sparse triangle grouped into levels, every row depending only on rows of earlier levels, so a
+     * triangular solve takes one parallel step per level. the row order is mirrored to the device on first use
+     */
+    class level_schedule
+    {
+        private:
+        struct rows_mirror
+        {
+            std::vector< size_t > rows;
+            mutable size_t* dev_rows = nullptr;
+
+            explicit rows_mirror( std::vector< size_t > t_rows ) : rows( std::move( t_rows ) ) { }
+
+            rows_mirror( const rows_mirror& ) = delete;
+            rows_mirror& operator=( const rows_mirror& ) = delete;
+
+            ~rows_mirror( )
+            {
+                if ( dev_rows ) gpu::ctx( ).pool.deallocate( dev_rows );
+            }
+        };
+
+        std::vector< size_t > offsets{ 0 };
+        std::shared_ptr< const rows_mirror > order;
+
+        public:
+        level_schedule( ) = default;
+
+        /**
+         * @param tri triangle in CSR, its diagonal stored
+         * @param lower true when tri is lower triangular ( rows depend on earlier rows ), false for upper
+         */
+        template < SKAS::FlAd T >
+        level_schedule( const sparse_matrix< T >& tri, const bool lower )
+        {
+            const size_t n = tri.nrow( );
+            const std::vector< size_t >& row_offsets = tri.row_offsets( );
+            const std::vector< size_t >& cols = tri.columns( );
+            std::vector< size_t > level( n, 0 );
+            size_t levels = n ? 1 : 0;
+            for ( size_t step = 0; step < n; ++step )
+            {
+                const size_t i = lower ? step : n - 1 - step;
+                for ( size_t e = row_offsets[ i ]; e < row_offsets[ i + 1 ]; ++e )
+                {
+                    if ( cols[ e ] != i ) level[ i ] = std::max( level[ i ], level[ cols[ e ] ] + 1 );
+                }
+                levels = std::max( levels, level[ i ] + 1 );
+            }
+            offsets.assign( levels + 1, 0 );
+            for ( const size_t l : level ) ++offsets[ l + 1 ];
+            std::inclusive_scan( offsets.begin( ), offsets.end( ), offsets.begin( ) );
+            std::vector< size_t > next( offsets.begin( ), offsets.end( ) - 1 );
+            std::vector< size_t > rows( n );
+            for ( size_t i = 0; i < n; ++i ) rows[ next[ level[ i ] ]++ ] = i;
+            order = std::make_shared< const rows_mirror >( std::move( rows ) );
+        }
+
+        auto levels( ) const -> size_t
+        {
+            return offsets.size( ) - 1;
+        }
+
+        auto level_begin( const size_t l ) const -> size_t
+        {
+            return offsets[ l ];
+        }
+
+        auto level_size( const size_t l ) const -> size_t
+        {
+            return offsets[ l + 1 ] - offsets[ l ];
+        }
+
+        /**
+         * @brief rows ordered by level, on the device or the host
+         */
+        auto rows( const bool device ) const -> const size_t*
+        {
+            if ( !device ) return order->rows.data( );
+            if ( !order->dev_rows )
+            {
+                order->dev_rows = gpu::ctx( ).pool.allocate< size_t >( std::max< size_t >( order->rows.size( ), 1 ) );
+                gpu::ctx( ).q.memcpy( order->dev_rows, order->rows.data( ), order->rows.size( ) * sizeof( size_t ) ).wait( );
+            }
+            return order->dev_rows;
+        }
+    };
+
+    /**
+     * @brief incomplete cholesky IC( 0 ) preconditioner of a sparse symmetric positive definite A: L keeps the pattern of
+     * A's lower triangle, and z = ( L L^T )^-1 r by two level-scheduled triangular solves, one kernel per level
+     */
+    template < SKAS::FlAd T >
+    class ichol
+    {
+        private:
+        sparse_matrix< T > lower;
+        sparse_matrix< T > upper;
+        level_schedule forward;
+        level_schedule backward;
+
+        public:
+        /**
+         * @exception matrixDimError thrown for a non-square matrix
+         * @exception solutionError thrown when a pivot is not positive, including a missing diagonal
+         */
+        explicit ichol( const sparse_matrix< T >& a_matrix )
+        {
+            if ( a_matrix.nrow( ) != a_matrix.ncol( ) ) throw matrixDimError{"CANNOT PRECONDITION NON-SQUARE MATRIX"};
+            const size_t n = a_matrix.nrow( );
+            const std::vector< size_t >& a_offsets = a_matrix.row_offsets( );
+            const std::vector< size_t >& a_cols = a_matrix.columns( );
+            const T* a_v = a_matrix.values( ).data( );
+
+            std::vector< size_t > offsets( n + 1, 0 );
+            std::vector< size_t > cols;
+            std::vector< T > vals;
+            for ( size_t i = 0; i < n; ++i )
+            {
+                for ( size_t e = a_offsets[ i ]; e < a_offsets[ i + 1 ] && a_cols[ e ] <= i; ++e )
+                {
+                    cols.push_back( a_cols[ e ] );
+                    vals.push_back( a_v[ e ] );
+                }
+                offsets[ i + 1 ] = cols.size( );
+                if ( cols.size( ) == offsets[ i ] || cols.back( ) != i ) throw solutionError{"MATRIX IS NOT POSITIVE DEFINITE"};
+            }
+
+            // row i in column order: L_ik = ( A_ik - sum_{ j < k } L_ij L_kj ) / L_kk, then the diagonal
+            for ( size_t i = 0; i < n; ++i )
+            {
+                const size_t diag = offsets[ i + 1 ] - 1;
+                T diag_sum = vals[ diag ];
+                for ( size_t e = offsets[ i ]; e < diag; ++e )
+                {
+                    const size_t k = cols[ e ];
+                    T sum = vals[ e ];
+                    size_t ie = offsets[ i ];
+                    size_t ke = offsets[ k ];
+                    const size_t k_diag = offsets[ k + 1 ] - 1;
+                    while ( ie < e && ke < k_diag )
+                    {
+                        if ( cols[ ie ] < cols[ ke ] ) ++ie;
+                        else if ( cols[ ke ] < cols[ ie ] ) ++ke;
+                        else sum -= vals[ ie++ ] * vals[ ke++ ];
+                    }
+                    vals[ e ] = sum / vals[ k_diag ];
+                    diag_sum -= vals[ e ] * vals[ e ];
+                }
+                if ( !( diag_sum > T{0} ) ) throw solutionError{"MATRIX IS NOT POSITIVE DEFINITE"};
+                vals[ diag ] = std::sqrt( diag_sum );
+            }
+
+            lower = sparse_matrix< T >( n, n, std::move( offsets ), std::move( cols ), std::move( vals ), a_matrix.get_policy( ) );
+            upper = lower.t( );
+            forward = level_schedule( lower, true );
+            backward = level_schedule( upper, false );
+        }
+
+        /**
+         * @brief the incomplete factor L
+         */
+        auto factor( ) const -> const sparse_matrix< T >&
+        {
+            return lower;
+        }
+
+        auto apply( krylov_engine< T >& eng, const T* r, T* z ) const -> void
+        {
+            const bool device = eng.on_device( );
+            {
+                const size_t* offsets = device ? lower.dev_row_offsets( ) : lower.row_offsets( ).data( );
+                const size_t* cols = device ? lower.dev_columns( ) : lower.columns( ).data( );
+                const T* v = eng.ptr( lower.values( ) );
+                const size_t* order = forward.rows( device );
+                for ( size_t l = 0; l < forward.levels( ); ++l )
+                {
+                    const size_t begin = forward.level_begin( l );
+                    eng.each( forward.level_size( l ), [=]( size_t t ) {
+                        const size_t i = order[ begin + t ];
+                        const size_t diag = offsets[ i + 1 ] - 1;
+                        T sum = r[ i ];
+                        for ( size_t e = offsets[ i ]; e < diag; ++e ) sum -= v[ e ] * z[ cols[ e ] ];
+                        z[ i ] = sum / v[ diag ];
+                    } );
+                }
+            }
+            const size_t* offsets = device ? upper.dev_row_offsets( ) : upper.row_offsets( ).data( );
+            const size_t* cols = device ? upper.dev_columns( ) : upper.columns( ).data( );
+            const T* v = eng.ptr( upper.values( ) );
+            const size_t* order = backward.rows( device );
+            for ( size_t l = 0; l < backward.levels( ); ++l )
+            {
+                const size_t begin = backward.level_begin( l );
+                eng.each( backward.level_size( l ), [=]( size_t t ) {
+                    const size_t i = order[ begin + t ];
+                    const size_t diag = offsets[ i ];
+                    T sum = z[ i ];
+                    for ( size_t e = diag + 1; e < offsets[ i + 1 ]; ++e ) sum -= v[ e ] * z[ cols[ e ] ];
+                    z[ i ] = sum / v[ diag ];
+                } );
+            }
+        }
+    };
+
+    /**
+     * @brief checks a square system and sizes x to it, zero filled when it was not. returns the policy of the solve
+     */
+    template < SKAS::FlAd T, typename A >
+    auto krylov_prepare( const A& a_matrix, const vect::vect< T >& b, vect::vect< T >& x ) -> exec::policy
+    {
+        if ( a_matrix.nrow( ) != a_matrix.ncol( ) || b.size( ) != a_matrix.nrow( ) ) throw matrixDimError{"CANNOT SOLVE SYSTEM OF INCOMPATIBLE DIMENSIONS"};
+        if ( x.size( ) != b.size( ) ) x = vect::vect< T >( b.size( ), T{0}, b.get_policy( ) );
+        const exec::policy all = exec::common( exec::common( a_matrix.get_policy( ), b.get_policy( ) ), x.get_policy( ) );
+        return gpu::resolve( all, gpu::op_kind::reduction, b.size( ) );
+    }
+
+    /**
+     * @brief reads the squared residual norm in slot and records it. true when the solve should stop
+     */
+    template < SKAS::FlAd T >
+    auto krylov_check( krylov_engine< T >& eng, const size_t slot, const T b_norm, const krylov_options< T >& opts, krylov_result< T >& result ) -> bool
+    {
+        const T r_norm = std::sqrt( eng.read( slot ) );
+        result.residual = b_norm > T{0} ? r_norm / b_norm : r_norm;
+        result.converged = result.residual <= opts.tolerance;
+        return result.converged || !std::isfinite( result.residual );
+    }
+
+    /**
+     * @brief preconditioned conjugate gradients for symmetric positive definite A. x is the initial guess and receives the
+     * solution. all iteration vectors and scalars stay where the policy runs; the residual norm is read every
+     * opts.check_every iterations
+     * @param a_matrix matrix or sparse_matrix
+     * @param precond identity_preconditioner, jacobi, ichol, or anything with the same apply( )
+     * @exception matrixDimError thrown for incompatible dimensions
+     */
+    template < SKAS::FlAd T, typename A, typename M = identity_preconditioner< T > >
+    auto cg( const A& a_matrix, const vect::vect< T >& b, vect::vect< T >& x, const krylov_options< T >& opts = { }, const M& precond = { } ) -> krylov_result< T >
+    {
+        const exec::policy p = krylov_prepare( a_matrix, b, x );
+        const size_t n = b.size( );
+        enum slot : size_t { bb, rz, pq, alpha, rz_next, beta, rr, slot_count };
+        krylov_engine< T > eng( p, n, slot_count );
+        vect::vect< T > r( n, p ), z( n, p ), d( n, p ), q( n, p );
+        T* xs = eng.ptr( x );
+        const T* bs = eng.ptr( b );
+        T* rs = eng.fresh( r );
+        T* zs = eng.fresh( z );
+        T* ds = eng.fresh( d );
+        T* qs = eng.fresh( q );
+        T* s = eng.slots( );
+
+        krylov_apply( eng, a_matrix, x, q );
+        eng.each( [=]( size_t i ) { rs[ i ] = bs[ i ] - qs[ i ]; } );
+        precond.apply( eng, rs, zs );
+        eng.each( [=]( size_t i ) { ds[ i ] = zs[ i ]; } );
+        eng.reduce( [=]( size_t i ) { return bs[ i ] * bs[ i ]; }, s + bb );
+        eng.reduce( [=]( size_t i ) { return rs[ i ] * zs[ i ]; }, s + rz );
+        eng.reduce( [=]( size_t i ) { return rs[ i ] * rs[ i ]; }, s + rr );
+
+        krylov_result< T > result;
+        const T b_norm = std::sqrt( eng.read( bb ) );
+        if ( krylov_check( eng, rr, b_norm, opts, result ) ) return result;
+
+        for ( size_t it = 1; it <= opts.max_iterations; ++it )
+        {
+            krylov_apply( eng, a_matrix, d, q );
+            eng.reduce( [=]( size_t i ) { return ds[ i ] * qs[ i ]; }, s + pq );
+            eng.scalar( [=]( ) { s[ alpha ] = s[ pq ] != T{0} ? s[ rz ] / s[ pq ] : T{0}; } );
+            eng.each( [=]( size_t i ) {
+                xs[ i ] += s[ alpha ] * ds[ i ];
+                rs[ i ] -= s[ alpha ] * qs[ i ];
+            } );
+            precond.apply( eng, rs, zs );
+            eng.reduce( [=]( size_t i ) { return rs[ i ] * zs[ i ]; }, s + rz_next );
+            eng.scalar( [=]( ) {
+                s[ beta ] = s[ rz ] != T{0} ? s[ rz_next ] / s[ rz ] : T{0};
+                s[ rz ] = s[ rz_next ];
+            } );
+            eng.each( [=]( size_t i ) { ds[ i ] = zs[ i ] + s[ beta ] * ds[ i ]; } );
+            result.iterations = it;
+            if ( it % std::max< size_t >( opts.check_every, 1 ) && it != opts.max_iterations ) continue;
+            eng.reduce( [=]( size_t i ) { return rs[ i ] * rs[ i ]; }, s + rr );
+            if ( krylov_check( eng, rr, b_norm, opts, result ) ) break;
+        }
+        return result;
+    }
+
+    /**
+     * @brief right-preconditioned BiCGSTAB for general square A. x is the initial guess and receives the solution; vectors
+     * and scalars stay where the policy runs and the residual norm is read every opts.check_every iterations
+     * @exception matrixDimError thrown for incompatible dimensions
+     */
+    template < SKAS::FlAd T, typename A, typename M = identity_preconditioner< T > >
+    auto bicgstab( const A& a_matrix, const vect::vect< T >& b, vect::vect< T >& x, const krylov_options< T >& opts = { }, const M& precond = { } ) -> krylov_result< T >
+    {
+        const exec::policy p = krylov_prepare( a_matrix, b, x );
+        const size_t n = b.size( );
+        enum slot : size_t { bb, rho, rho_old, alpha, omega, beta, r0v, ts, tt, rr, slot_count };
+        krylov_engine< T > eng( p, n, slot_count );
+        vect::vect< T > r( n, p ), r0( n, p ), d( n, p ), v( n, p ), dh( n, p ), sv( n, p ), sh( n, p ), t( n, p );
+        T* xs = eng.ptr( x );
+        const T* bs = eng.ptr( b );
+        T* rs = eng.fresh( r );
+        T* r0s = eng.fresh( r0 );
+        T* ds = eng.fresh( d );
+        T* vs = eng.fresh( v );
+        T* dhs = eng.fresh( dh );
+        T* svs = eng.fresh( sv );
+        T* shs = eng.fresh( sh );
+        T* ts_ = eng.fresh( t );
+        T* s = eng.slots( );
+
+        krylov_apply( eng, a_matrix, x, t );
+        eng.each( [=]( size_t i ) {
+            rs[ i ] = bs[ i ] - ts_[ i ];
+            r0s[ i ] = rs[ i ];
+            ds[ i ] = T{0};
+            vs[ i ] = T{0};
+        } );
+        eng.reduce( [=]( size_t i ) { return bs[ i ] * bs[ i ]; }, s + bb );
+        eng.reduce( [=]( size_t i ) { return rs[ i ] * rs[ i ]; }, s + rr );
+        eng.scalar( [=]( ) { s[ rho_old ] = s[ alpha ] = s[ omega ] = T{1}; } );
+
+        krylov_result< T > result;
+        const T b_norm = std::sqrt( eng.read( bb ) );
+        if ( krylov_check( eng, rr, b_norm, opts, result ) ) return result;
+
+        for ( size_t it = 1; it <= opts.max_iterations; ++it )
+        {
+            eng.reduce( [=]( size_t i ) { return r0s[ i ] * rs[ i ]; }, s + rho );
+            eng.scalar( [=]( ) { s[ beta ] = s[ rho_old ] != T{0} && s[ omega ] != T{0} ? ( s[ rho ] / s[ rho_old ] ) * ( s[ alpha ] / s[ omega ] ) : T{0}; } );
+            eng.each( [=]( size_t i ) { ds[ i ] = rs[ i ] + s[ beta ] * ( ds[ i ] - s[ omega ] * vs[ i ] ); } );
+            precond.apply( eng, ds, dhs );
+            krylov_apply( eng, a_matrix, dh, v );
+            eng.reduce( [=]( size_t i ) { return r0s[ i ] * vs[ i ]; }, s + r0v );
+            eng.scalar( [=]( ) { s[ alpha ] = s[ r0v ] != T{0} ? s[ rho ] / s[ r0v ] : T{0}; } );
+            eng.each( [=]( size_t i ) { svs[ i ] = rs[ i ] - s[ alpha ] * vs[ i ]; } );
+            precond.apply( eng, svs, shs );
+            krylov_apply( eng, a_matrix, sh, t );
+            eng.reduce( [=]( size_t i ) { return ts_[ i ] * svs[ i ]; }, s + ts );
+            eng.reduce( [=]( size_t i ) { return ts_[ i ] * ts_[ i ]; }, s + tt );
+            eng.scalar( [=]( ) {
+                s[ omega ] = s[ tt ] != T{0} ? s[ ts ] / s[ tt ] : T{0};
+                s[ rho_old ] = s[ rho ];
+            } );
+            eng.each( [=]( size_t i ) {
+                xs[ i ] += s[ alpha ] * dhs[ i ] + s[ omega ] * shs[ i ];
+                rs[ i ] = svs[ i ] - s[ omega ] * ts_[ i ];
+            } );
+            result.iterations = it;
+            if ( it % std::max< size_t >( opts.check_every, 1 ) && it != opts.max_iterations ) continue;
+            eng.reduce( [=]( size_t i ) { return rs[ i ] * rs[ i ]; }, s + rr );
+            if ( krylov_check( eng, rr, b_norm, opts, result ) ) break;
+        }
+        return result;
+    }
+
+    /**
+     * @brief restarted, right-preconditioned GMRES( opts.restart ) for general square A, with modified Gram-Schmidt
+     * Arnoldi and Givens rotations. the Krylov basis, Hessenberg matrix and rotations stay where the policy runs; the
+     * rotated residual estimate is read every opts.check_every iterations, and the true residual at each restart
+     * @exception matrixDimError thrown for incompatible dimensions
+     */
+    template < SKAS::FlAd T, typename A, typename M = identity_preconditioner< T > >
+    auto gmres( const A& a_matrix, const vect::vect< T >& b, vect::vect< T >& x, const krylov_options< T >& opts = { }, const M& precond = { } ) -> krylov_result< T >
+    {
+        const exec::policy p = krylov_prepare( a_matrix, b, x );
+        const size_t n = b.size( );
+        const size_t m = std::max< size_t >( 1, std::min( opts.restart, std::max< size_t >( n, 1 ) ) );
+
+        // slots: H ( m + 1 ) x m row-major, then cs, sn, g, y, and the squared norms
+        const size_t h_at = 0;
+        const size_t cs_at = h_at + ( m + 1 ) * m;
+        const size_t sn_at = cs_at + m;
+        const size_t g_at = sn_at + m;
+        const size_t y_at = g_at + m + 1;
+        const size_t rr = y_at + m;
+        const size_t bb = rr + 1;
+        krylov_engine< T > eng( p, n, bb + 1 );
+        vect::vect< T > basis( ( m + 1 ) * n, p ), w( n, p ), z( n, p );
+        T* xs = eng.ptr( x );
+        const T* bs = eng.ptr( b );
+        T* V = eng.fresh( basis );
+        T* ws = eng.fresh( w );
+        T* zs = eng.fresh( z );
+        T* s = eng.slots( );
+        T* H = s + h_at;
+        T* cs = s + cs_at;
+        T* sn = s + sn_at;
+        T* g = s + g_at;
+        T* y = s + y_at;
+
+        eng.reduce( [=]( size_t i ) { return bs[ i ] * bs[ i ]; }, s + bb );
+        krylov_result< T > result;
+        const T b_norm = std::sqrt( eng.read( bb ) );
+        const size_t check_every = std::max< size_t >( opts.check_every, 1 );
+
+        while ( true )
+        {
+            krylov_apply( eng, a_matrix, x, w );
+            eng.each( [=]( size_t i ) { ws[ i ] = bs[ i ] - ws[ i ]; } );
+            eng.reduce( [=]( size_t i ) { return ws[ i ] * ws[ i ]; }, s + rr );
+            if ( krylov_check( eng, rr, b_norm, opts, result ) || result.iterations >= opts.max_iterations ) break;
+            eng.scalar( [=]( ) {
+                g[ 0 ] = std::sqrt( s[ rr ] );
+                for ( size_t i = 1; i <= m; ++i ) g[ i ] = T{0};
+            } );
+            eng.each( [=]( size_t i ) { V[ i ] = g[ 0 ] != T{0} ? ws[ i ] / g[ 0 ] : T{0}; } );
+
+            size_t k = 0;
+            bool stop = false;
+            for ( size_t j = 0; j < m && result.iterations < opts.max_iterations; ++j )
+            {
+                const T* v_j = V + j * n;
+                T* v_next = V + ( j + 1 ) * n;
+                precond.apply( eng, v_j, zs );
+                krylov_apply( eng, a_matrix, z, w );
+                for ( size_t i = 0; i <= j; ++i )
+                {
+                    const T* v_i = V + i * n;
+                    T* h_ij = H + i * m + j;
+                    eng.reduce( [=]( size_t e ) { return ws[ e ] * v_i[ e ]; }, h_ij );
+                    eng.each( [=]( size_t e ) { ws[ e ] -= *h_ij * v_i[ e ]; } );
+                }
+                T* h_next = H + ( j + 1 ) * m + j;
+                eng.reduce( [=]( size_t e ) { return ws[ e ] * ws[ e ]; }, h_next );
+                eng.scalar( [=]( ) { *h_next = std::sqrt( *h_next ); } );
+                eng.each( [=]( size_t e ) { v_next[ e ] = *h_next != T{0} ? ws[ e ] / *h_next : T{0}; } );
+                eng.scalar( [=]( ) {
+                    for ( size_t i = 0; i < j; ++i )
+                    {
+                        const T upper = cs[ i ] * H[ i * m + j ] + sn[ i ] * H[ ( i + 1 ) * m + j ];
+                        H[ ( i + 1 ) * m + j ] = -sn[ i ] * H[ i * m + j ] + cs[ i ] * H[ ( i + 1 ) * m + j ];
+                        H[ i * m + j ] = upper;
+                    }
+                    const T a_jj = H[ j * m + j ];
+                    const T b_jj = H[ ( j + 1 ) * m + j ];
+                    const T den = std::sqrt( a_jj * a_jj + b_jj * b_jj );
+                    cs[ j ] = den != T{0} ? a_jj / den : T{1};
+                    sn[ j ] = den != T{0} ? b_jj / den : T{0};
+                    H[ j * m + j ] = cs[ j ] * a_jj + sn[ j ] * b_jj;
+                    H[ ( j + 1 ) * m + j ] = T{0};
+                    g[ j + 1 ] = -sn[ j ] * g[ j ];
+                    g[ j ] = cs[ j ] * g[ j ];
+                    s[ rr ] = g[ j + 1 ] * g[ j + 1 ];
+                } );
+                k = j + 1;
+                ++result.iterations;
+                if ( result.iterations % check_every && result.iterations != opts.max_iterations ) continue;
+                if ( krylov_check( eng, rr, b_norm, opts, result ) )
+                {
+                    stop = true;
+                    break;
+                }
+            }
+
+            // x += M^-1 V_k y with H_k y = g_k
+            eng.scalar( [=]( ) {
+                for ( size_t i = k; i-- > 0; )
+                {
+                    T sum = g[ i ];
+                    for ( size_t c = i + 1; c < k; ++c ) sum -= H[ i * m + c ] * y[ c ];
+                    y[ i ] = H[ i * m + i ] != T{0} ? sum / H[ i * m + i ] : T{0};
+                }
+            } );
+            eng.each( [=]( size_t i ) {
+                T sum{ 0 };
+                for ( size_t c = 0; c < k; ++c ) sum += y[ c ] * V[ c * n + i ];
+                ws[ i ] = sum;
+            } );
+            precond.apply( eng, ws, zs );
+            eng.each( [=]( size_t i ) { xs[ i ] += zs[ i ]; } );
+            if ( stop || result.iterations >= opts.max_iterations ) break;
+        }
+        return result;
+    }
+
+}; // namespace SKAS::matrix -end
+
+#endif
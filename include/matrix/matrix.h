@@ -7,68 +7,471 @@
 #include <concepts>
 #include <algorithm>
 #include <cmath>
+#include <memory>
+#include <array>
+#include <utility>
+#include <type_traits>
 #include <sycl/sycl.hpp>
 #include <hipSYCL/algorithms/numeric.hpp>
 #include <hipSYCL/algorithms/algorithm.hpp>
 #include "templates.h"
 #include "gpu.h"
 #include "customexceptions.h"
+#include "expr.h"
+#include "exec.h"
 #include "vect.h"
+#include "gemm.h"
 
 #ifndef MATRIX_H
 #define MATRIX_H
 
 namespace SKAS::matrix
 {
-    template < SKAS::FlAd T >                    
+    /**
+     * @brief storage layouts a matrix is templated on. offset( r, c, rows, cols ) is the position of element ( r, c )
+     * in the flat storage; it is constexpr and callable inside kernels
+     */
+    struct row_major
+    {
+        static constexpr auto offset( const size_t r, const size_t c, const size_t, const size_t cols ) -> size_t
+        {
+            return r * cols + c;
+        }
+    };
+
+    struct col_major
+    {
+        static constexpr auto offset( const size_t r, const size_t c, const size_t rows, const size_t ) -> size_t
+        {
+            return c * rows + r;
+        }
+    };
+
+    /**
+     * @brief B x B tiles stored tile row by tile row, each tile row-major inside. edge tiles are cut short
+     * rather than padded, so the storage stays rows * cols elements
+     */
+    template < size_t B >
+    struct tiled
+    {
+        static constexpr auto offset( const size_t r, const size_t c, const size_t rows, const size_t cols ) -> size_t
+        {
+            const size_t tile_r = r / B * B;
+            const size_t tile_c = c / B * B;
+            const size_t height = rows - tile_r < B ? rows - tile_r : B;
+            const size_t width = cols - tile_c < B ? cols - tile_c : B;
+            return tile_r * cols + tile_c * height + ( r - tile_r ) * width + ( c - tile_c );
+        }
+    };
+
+    /**
+     * @brief layouts whose storage is the row-major storage of the matrix or of its transpose, so the row-major
+     * kernels take them directly. other layouts go through relayout( )
+     */
+    template < typename L >
+    concept strided_layout = std::same_as< L, row_major > || std::same_as< L, col_major >;
+
+    /**
+     * @brief lazy element-wise matrix expression. E is a vect expression over the storage of operands that
+     * share layout L; it is evaluated in one fused pass when assigned to a matrix of that layout
+     */
+    template < SKAS::expr::expression E, typename L = row_major >
+    struct matr_expr
+    {
+        using value_type = typename E::value_type;
+
+        E e;
+        size_t rows;
+        size_t cols;
+
+        auto nrow( ) const -> size_t
+        {
+            return rows;
+        }
+
+        auto ncol( ) const -> size_t
+        {
+            return cols;
+        }
+
+        auto get_policy( ) const -> SKAS::exec::policy
+        {
+            return e.get_policy( );
+        }
+    };
+
+    /**
+     * @brief writes expression e into n elements of store from offset, element i landing at offset + at( i ).
+     * runs wherever exec::common of the expression's and the store's policies resolves to
+     * @exception matrixDimError thrown when e does not hold n elements
+     */
+    template < typename V, SKAS::expr::expression E, typename At >
+    auto view_assign( V& store, const size_t offset, const size_t n, const E& e, At at ) -> void
+    {
+        using T = typename V::value_type;
+        if ( e.size( ) != n ) throw matrixDimError{"CANNOT ASSIGN TO A VIEW OF DIFFERENT SIZE"};
+        const exec::policy p = gpu::resolve( exec::common( e.get_policy( ), store.get_policy( ) ), gpu::op_kind::elementwise, n );
+        if ( p == exec::policy::device )
+        {
+            auto ev = e.device( );
+            T* out = store.dev_data( ) + offset;
+            if ( n ) gpu::ctx( ).q.parallel_for( sycl::range< 1 >( n ), [=]( sycl::id< 1 > i ) { out[ at( i ) ] = ev( i ); } ).wait( );
+            return;
+        }
+        auto ev = e.host( );
+        T* out = store.data( ) + offset;
+        exec::for_n( p, n, [=]( size_t i ) { out[ at( i ) ] = ev( i ); } );
+    }
+
+    // views below are non-owning windows into a matrix's row-major storage. they are expression leaves, so the lazy
+    // operators, dot products and kernels read them in place. V is const vect< T > for views of a const matrix and
+    // vect< T > for writable ones, which assign element-wise into the matrix. a view does not keep its matrix alive,
+    // and anything that reshapes the matrix invalidates it. assigning between overlapping views is undefined.
+
+    /**
+     * @brief count consecutive elements from offset: one row of a matrix
+     */
+    template < typename V >
+    struct row_view
+    {
+        using value_type = typename std::remove_const_t< V >::value_type;
+
+        V* store;
+        size_t offset;
+        size_t count;
+
+        row_view( V* t_store, const size_t t_offset, const size_t t_count ) : store( t_store ), offset( t_offset ), count( t_count ) { }
+
+        row_view( const row_view& ) = default;
+
+        auto size( ) const -> size_t
+        {
+            return count;
+        }
+
+        auto get_policy( ) const -> exec::policy
+        {
+            return store->get_policy( );
+        }
+
+        auto host( ) const
+        {
+            return SKAS::expr::ptr_eval< value_type >{ std::as_const( *store ).data( ) + offset };
+        }
+
+        auto device( ) const
+        {
+            return SKAS::expr::ptr_eval< value_type >{ std::as_const( *store ).dev_data( ) + offset };
+        }
+
+        auto operator[]( const size_t i ) const -> value_type
+        {
+            return std::as_const( *store )[ offset + i ];
+        }
+
+        operator row_view< const V >( ) const requires ( !std::is_const_v< V > )
+        {
+            return { store, offset, count };
+        }
+
+        auto operator=( const row_view& other ) const -> const row_view& requires ( !std::is_const_v< V > )
+        {
+            view_assign( *store, offset, count, other, []( size_t i ) { return i; } );
+            return *this;
+        }
+
+        template < SKAS::vect::vect_operand X >
+            requires ( !std::is_const_v< V > )
+        auto operator=( const X& x ) const -> const row_view&
+        {
+            view_assign( *store, offset, count, SKAS::vect::as_expr( x ), []( size_t i ) { return i; } );
+            return *this;
+        }
+    };
+
+    /**
+     * @brief count elements from offset, stride apart: one column of a matrix
+     */
+    template < typename V >
+    struct col_view
+    {
+        using value_type = typename std::remove_const_t< V >::value_type;
+
+        V* store;
+        size_t offset;
+        size_t count;
+        size_t stride;
+
+        col_view( V* t_store, const size_t t_offset, const size_t t_count, const size_t t_stride )
+            : store( t_store ), offset( t_offset ), count( t_count ), stride( t_stride ) { }
+
+        col_view( const col_view& ) = default;
+
+        auto size( ) const -> size_t
+        {
+            return count;
+        }
+
+        auto get_policy( ) const -> exec::policy
+        {
+            return store->get_policy( );
+        }
+
+        auto host( ) const
+        {
+            return SKAS::expr::strided_eval< value_type >{ std::as_const( *store ).data( ) + offset, stride };
+        }
+
+        auto device( ) const
+        {
+            return SKAS::expr::strided_eval< value_type >{ std::as_const( *store ).dev_data( ) + offset, stride };
+        }
+
+        auto operator[]( const size_t i ) const -> value_type
+        {
+            return std::as_const( *store )[ offset + i * stride ];
+        }
+
+        operator col_view< const V >( ) const requires ( !std::is_const_v< V > )
+        {
+            return { store, offset, count, stride };
+        }
+
+        auto operator=( const col_view& other ) const -> const col_view& requires ( !std::is_const_v< V > )
+        {
+            view_assign( *store, offset, count, other, [step = stride]( size_t i ) { return i * step; } );
+            return *this;
+        }
+
+        template < SKAS::vect::vect_operand X >
+            requires ( !std::is_const_v< V > )
+        auto operator=( const X& x ) const -> const col_view&
+        {
+            view_assign( *store, offset, count, SKAS::vect::as_expr( x ), [step = stride]( size_t i ) { return i * step; } );
+            return *this;
+        }
+    };
+
+    /**
+     * @brief rows x cols block from offset with row stride ld: a sub-matrix. accepted by the element-wise matrix
+     * operators, gemm and gemv, and a matrix can be built from one. blocks of one matrix may be passed together
+     * as long as an output does not overlap an input
+     */
+    template < typename V >
+    struct block_view
+    {
+        using value_type = typename std::remove_const_t< V >::value_type;
+
+        V* store;
+        size_t offset;
+        size_t rows;
+        size_t cols;
+        size_t ld;
+
+        block_view( V* t_store, const size_t t_offset, const size_t t_rows, const size_t t_cols, const size_t t_ld )
+            : store( t_store ), offset( t_offset ), rows( t_rows ), cols( t_cols ), ld( t_ld ) { }
+
+        block_view( const block_view& ) = default;
+
+        auto nrow( ) const -> size_t
+        {
+            return rows;
+        }
+
+        auto ncol( ) const -> size_t
+        {
+            return cols;
+        }
+
+        auto get_policy( ) const -> exec::policy
+        {
+            return store->get_policy( );
+        }
+
+        auto elements( ) const -> SKAS::expr::window< vect::vect< value_type > >
+        {
+            return { store, offset, rows, cols, ld };
+        }
+
+        auto operator()( const size_t row, const size_t col ) const -> value_type
+        {
+            return std::as_const( *store )[ offset + row * ld + col ];
+        }
+
+        /**
+         * @brief storage elements from offset the block spans, first to last row
+         */
+        auto extent( ) const -> size_t
+        {
+            return rows && cols ? ( rows - 1 ) * ld + cols : 0;
+        }
+
+        operator block_view< const V >( ) const requires ( !std::is_const_v< V > )
+        {
+            return { store, offset, rows, cols, ld };
+        }
+
+        auto operator=( const block_view& other ) const -> const block_view& requires ( !std::is_const_v< V > )
+        {
+            if ( other.rows != rows || other.cols != cols ) throw matrixDimError{"CANNOT ASSIGN TO A BLOCK OF DIFFERENT DIMENSIONS"};
+            view_assign( *store, offset, rows * cols, other.elements( ), [width = cols, step = ld]( size_t i ) { return ( i / width ) * step + i % width; } );
+            return *this;
+        }
+
+        /**
+         * @brief element-wise copy of a matrix, matrix expression or block of the same dimensions into this block
+         * @exception matrixDimError thrown for different dimensions
+         */
+        template < typename X >
+            requires ( !std::is_const_v< V > ) && requires( const X& x ) { x.nrow( ); x.ncol( ); }
+        auto operator=( const X& x ) const -> const block_view&
+        {
+            if ( x.nrow( ) != rows || x.ncol( ) != cols ) throw matrixDimError{"CANNOT ASSIGN TO A BLOCK OF DIFFERENT DIMENSIONS"};
+            view_assign( *store, offset, rows * cols, as_vexpr( x ), [width = cols, step = ld]( size_t i ) { return ( i / width ) * step + i % width; } );
+            return *this;
+        }
+    };
+
+    /**
+     * @brief whether two blocks touch a common storage element
+     */
+    template < typename VA, typename VB >
+    auto blocks_overlap( const block_view< VA >& a, const block_view< VB >& b ) -> bool
+    {
+        if ( static_cast< const void* >( a.store ) != static_cast< const void* >( b.store ) || !a.extent( ) || !b.extent( ) ) return false;
+        if ( a.ld != b.ld || !a.ld ) return a.offset < b.offset + b.extent( ) && b.offset < a.offset + a.extent( );
+        const size_t a_row = a.offset / a.ld, a_col = a.offset % a.ld;
+        const size_t b_row = b.offset / b.ld, b_col = b.offset % b.ld;
+        return a_row < b_row + b.rows && b_row < a_row + a.rows && a_col < b_col + b.cols && b_col < a_col + a.cols;
+    }
+
+    /**
+     * @brief dense matrix stored in layout L ( row_major, col_major or tiled< B > ). its exec::policy is the policy
+     * of the underlying vect, so operations on it run (and results come back) under the same backend. element-wise
+     * operators, gemm, gemv and % take every layout; the factorizations take row-major and other layouts convert
+     * with relayout( )
+     */
+    template < SKAS::FlAd T, typename L = row_major >
     class matrix
     {
         private:
         size_t dim_n; //row size
         size_t dim_m; //col size
         SKAS::vect::vect< T > data;
-        bool parallel;
+
+        template < SKAS::FlAd, typename >
+        friend class matrix;
+
+        /**
+         * @brief inserts values[ l ] at position index of each of lines contiguous lines of width elements, in place.
+         * lines move right from the last one down, each split around its new element
+         */
+        static auto widen( vect::vect< T >& store, const size_t lines, const size_t width, const std::vector< T >& values, const size_t index ) -> void
+        {
+            store.resize( lines * ( width + 1 ) );
+            T* d = store.data( );
+            for ( size_t l = lines; l-- > 0; )
+            {
+                T* src = d + l * width;
+                T* dst = d + l * ( width + 1 );
+                std::copy_backward( src + index, src + width, dst + width + 1 );
+                dst[ index ] = values[ l ];
+                std::copy_backward( src, src + index, dst + index );
+            }
+        }
+
+        /**
+         * @brief removes position index from each of lines contiguous lines of width elements, compacting in place
+         */
+        static auto narrow( vect::vect< T >& store, const size_t lines, const size_t width, const size_t index ) -> void
+        {
+            T* d = store.data( );
+            T* out = d;
+            for ( size_t l = 0; l < lines; ++l )
+            {
+                const T* line = d + l * width;
+                out = std::copy( line, line + index, out );
+                out = std::copy( line + index + 1, line + width, out );
+            }
+            store.resize( lines * ( width - 1 ) );
+        }
 
         public:
-        matrix( ) : dim_n( 0 ), dim_m( 0 ), parallel( false ) { };
+        using value_type = T;
+        using layout = L;
+
+        matrix( ) : dim_n( 0 ), dim_m( 0 ) { };
 
         ~matrix( ) { };
 
-        matrix( const matrix &original )
+        matrix( const matrix &original ) : dim_n( original.dim_n ), dim_m( original.dim_m ), data( original.data ) { }
+
+        /**
+         * @brief takes original's storage. original is left empty
+         */
+        matrix( matrix&& original ) noexcept
+            : dim_n( std::exchange( original.dim_n, 0 ) ), dim_m( std::exchange( original.dim_m, 0 ) ), data( std::move( original.data ) ) { }
+
+        template < typename E >
+            requires std::same_as< typename E::value_type, T >
+        matrix( const matr_expr< E, L >& expression )
+            : dim_n( expression.nrow( ) ), dim_m( expression.ncol( ) ), data( expression.e ) { }
+
+        template < typename E >
+            requires std::same_as< typename E::value_type, T >
+        matrix& operator=( const matr_expr< E, L >& expression )
         {
-            clear( );
-            data = original.data;
-            dim_m = original.dim_m;
-            dim_n = original.dim_n;
-            parallel = original.parallel;
-        }   
+            data = expression.e;
+            dim_n = expression.nrow( );
+            dim_m = expression.ncol( );
+            return *this;
+        }
 
-        matrix( const vect::vect< T >& t_data, const size_t row_dim, const size_t col_dim, const bool is_parallel = false )
+        matrix& operator=( const matrix& other ) = default;
+
+        matrix& operator=( matrix&& other ) noexcept
         {
-            data = t_data;
-            dim_n = row_dim;
-            dim_m = col_dim;
-            parallel = is_parallel;
+            if ( this != &other )
+            {
+                dim_n = std::exchange( other.dim_n, 0 );
+                dim_m = std::exchange( other.dim_m, 0 );
+                data = std::move( other.data );
+            }
+            return *this;
         }
 
-        matrix( std::initializer_list< T > init, const size_t row_dim, const size_t col_dim, const bool is_parallel = false )
+        template < typename V >
+            requires std::same_as< typename V::value_type, T > && std::same_as< L, row_major >
+        matrix( const block_view< V >& view )
+            : dim_n( view.nrow( ) ), dim_m( view.ncol( ) ), data( view.elements( ) ) { }
+
+        matrix( const vect::vect< T >& t_data, const size_t row_dim, const size_t col_dim, const exec::policy t_policy )
+            : dim_n( row_dim ), dim_m( col_dim ), data( t_data )
         {
-            vect::vect< T > outdata( init );
-            data = outdata;
-            dim_n = row_dim;
-            dim_m = col_dim;
-            parallel = is_parallel;
+            data.set_policy( t_policy );
         }
 
-        matrix( T initial_value, const size_t& rowcount, const size_t& colcount, const bool is_parallel = false )
+        matrix( const vect::vect< T >& t_data, const size_t row_dim, const size_t col_dim, const bool is_parallel = false )
+            : matrix( t_data, row_dim, col_dim, exec::of( is_parallel ) ) { }
+
+        matrix( vect::vect< T >&& t_data, const size_t row_dim, const size_t col_dim, const exec::policy t_policy )
+            : dim_n( row_dim ), dim_m( col_dim ), data( std::move( t_data ) )
         {
-            vect::vect< T > outdata(rowcount * colcount, initial_value, parallel );
-            data = outdata;
-            dim_m = colcount;
-            dim_n = rowcount;
-            parallel = is_parallel;
+            data.set_policy( t_policy );
         }
 
+        matrix( std::initializer_list< T > init, const size_t row_dim, const size_t col_dim, const exec::policy t_policy )
+            : dim_n( row_dim ), dim_m( col_dim ), data( init, t_policy ) { }
+
+        matrix( std::initializer_list< T > init, const size_t row_dim, const size_t col_dim, const bool is_parallel = false )
+            : matrix( init, row_dim, col_dim, exec::of( is_parallel ) ) { }
+
+        matrix( T initial_value, const size_t& rowcount, const size_t& colcount, const exec::policy t_policy )
+            : dim_n( rowcount ), dim_m( colcount ), data( rowcount * colcount, initial_value, t_policy ) { }
+
+        matrix( T initial_value, const size_t& rowcount, const size_t& colcount, const bool is_parallel = false )
+            : matrix( initial_value, rowcount, colcount, exec::of( is_parallel ) ) { }
+
         /**
          * @brief full memory clear of matrix
          * @return void
@@ -80,6 +483,22 @@ namespace SKAS::matrix
             dim_m = 0;
         }   
 
+        /**
+         * @brief makes room for rowcount x colcount elements, so appending rows (or columns) up to that size does not reallocate
+         */
+        auto reserve( const size_t& rowcount, const size_t& colcount ) -> void
+        {
+            data.reserve( rowcount * colcount );
+        }
+
+        /**
+         * @brief elements the matrix can hold before its storage reallocates
+         */
+        auto capacity( ) const -> size_t
+        {
+            return data.capacity( );
+        }
+
         /**
          * @brief row count (vertical dimension) of matrix
          * @return int
@@ -108,16 +527,14 @@ namespace SKAS::matrix
 
         auto getrow( const size_t& index ) const -> vect::vect< T >
         {
-            if ( index >= nrow( ) )
-            {
-                throw matrixDimError{"CANNOT RETREIVE ROW OUTSIDE MATRIX"};
-            }
-            vect::vect< T > output( ncol( ) );
-            for ( int i = 0; i < ncol( ); ++i )
+            if constexpr ( strided_layout< L > ) return vect::vect< T >( row( index ) );
+            else
             {
-                output[ i ] = data[ i + ncol( ) * index ];
+                if ( index >= nrow( ) ) throw matrixDimError{"CANNOT RETREIVE ROW OUTSIDE MATRIX"};
+                vect::vect< T > output( ncol( ), get_policy( ) );
+                for ( size_t c = 0; c < ncol( ); ++c ) output[ c ] = data[ L::offset( index, c, nrow( ), ncol( ) ) ];
+                return output;
             }
-            return output;
         }
 
         /**
@@ -128,16 +545,111 @@ namespace SKAS::matrix
          */
         auto getcol( const size_t& index ) const -> vect::vect< T >
         {
-            if ( index >= ncol( ) )
+            if constexpr ( strided_layout< L > ) return vect::vect< T >( col( index ) );
+            else
             {
-                throw matrixDimError{"CANNOT RETREIVE COL OUTSIDE MATRIX"};
+                if ( index >= ncol( ) ) throw matrixDimError{"CANNOT RETREIVE COL OUTSIDE MATRIX"};
+                vect::vect< T > output( nrow( ), get_policy( ) );
+                for ( size_t r = 0; r < nrow( ); ++r ) output[ r ] = data[ L::offset( r, index, nrow( ), ncol( ) ) ];
+                return output;
             }
-            vect::vect< T > final( nrow( ) );
-            for ( int i = 0; i < nrow( ); ++i )
+        }
+
+        /**
+         * @brief zero-copy view of the row at index: a row_view for row-major storage, a col_view for column-major.
+         * writable when the matrix is
+         * @exception matrixDimError for index outside matrix dimension
+         */
+        auto row( const size_t index ) const requires strided_layout< L >
+        {
+            if ( index >= nrow( ) ) throw matrixDimError{"CANNOT RETREIVE ROW OUTSIDE MATRIX"};
+            if constexpr ( std::same_as< L, row_major > ) return row_view< const vect::vect< T > >{ &data, index * ncol( ), ncol( ) };
+            else return col_view< const vect::vect< T > >{ &data, index, ncol( ), nrow( ) };
+        }
+
+        auto row( const size_t index ) requires strided_layout< L >
+        {
+            if ( index >= nrow( ) ) throw matrixDimError{"CANNOT RETREIVE ROW OUTSIDE MATRIX"};
+            if constexpr ( std::same_as< L, row_major > ) return row_view< vect::vect< T > >{ &data, index * ncol( ), ncol( ) };
+            else return col_view< vect::vect< T > >{ &data, index, ncol( ), nrow( ) };
+        }
+
+        /**
+         * @brief zero-copy view of the col at index: a col_view for row-major storage, a row_view for column-major.
+         * writable when the matrix is
+         * @exception matrixDimError for index outside matrix dimension
+         */
+        auto col( const size_t index ) const requires strided_layout< L >
+        {
+            if ( index >= ncol( ) ) throw matrixDimError{"CANNOT RETREIVE COL OUTSIDE MATRIX"};
+            if constexpr ( std::same_as< L, row_major > ) return col_view< const vect::vect< T > >{ &data, index, nrow( ), ncol( ) };
+            else return row_view< const vect::vect< T > >{ &data, index * nrow( ), nrow( ) };
+        }
+
+        auto col( const size_t index ) requires strided_layout< L >
+        {
+            if ( index >= ncol( ) ) throw matrixDimError{"CANNOT RETREIVE COL OUTSIDE MATRIX"};
+            if constexpr ( std::same_as< L, row_major > ) return col_view< vect::vect< T > >{ &data, index, nrow( ), ncol( ) };
+            else return row_view< vect::vect< T > >{ &data, index * nrow( ), nrow( ) };
+        }
+
+        /**
+         * @brief zero-copy view of the rowcount x colcount block whose top left element is ( row0, col0 ), see block_view.
+         * row-major storage only
+         * @exception matrixDimError thrown when the block does not fit inside the matrix
+         */
+        auto block( const size_t row0, const size_t col0, const size_t rowcount, const size_t colcount ) const -> block_view< const vect::vect< T > >
+            requires std::same_as< L, row_major >
+        {
+            if ( row0 + rowcount > nrow( ) || col0 + colcount > ncol( ) ) throw matrixDimError{"CANNOT VIEW BLOCK OUTSIDE MATRIX"};
+            return { &data, row0 * ncol( ) + col0, rowcount, colcount, ncol( ) };
+        }
+
+        auto block( const size_t row0, const size_t col0, const size_t rowcount, const size_t colcount ) -> block_view< vect::vect< T > >
+            requires std::same_as< L, row_major >
+        {
+            if ( row0 + rowcount > nrow( ) || col0 + colcount > ncol( ) ) throw matrixDimError{"CANNOT VIEW BLOCK OUTSIDE MATRIX"};
+            return { &data, row0 * ncol( ) + col0, rowcount, colcount, ncol( ) };
+        }
+
+        /**
+         * @brief copy of this matrix stored in layout L2, converted in one pass on the host or the device.
+         * the same layout returns a copy, which shares storage
+         */
+        template < typename L2 >
+        auto relayout( ) const -> matrix< T, L2 >
+        {
+            if constexpr ( std::same_as< L, L2 > ) return *this;
+            else
             {
-                final[ i ] = data[ index + i * ncol( ) ];
+                const size_t rows = nrow( );
+                const size_t cols = ncol( );
+                const size_t n = rows * cols;
+                matrix< T, L2 > output;
+                output.dim_n = rows;
+                output.dim_m = cols;
+                output.data = vect::vect< T >( n, get_policy( ) );
+                const exec::policy p = gpu::resolve( get_policy( ), gpu::op_kind::elementwise, n );
+                if ( p == exec::policy::device )
+                {
+                    const T* src = data.dev_data( );
+                    T* dst = output.data.dev_discard( );
+                    if ( n ) gpu::ctx( ).q.parallel_for( sycl::range< 1 >( n ), [=]( sycl::id< 1 > id ) {
+                        const size_t i = id;
+                        dst[ L2::offset( i / cols, i % cols, rows, cols ) ] = src[ L::offset( i / cols, i % cols, rows, cols ) ];
+                    } ).wait( );
+                    return output;
+                }
+                const T* src = data.data( );
+                T* dst = output.data.data( );
+                exec::for_chunks( p, rows, std::max< size_t >( 1, exec::grain / std::max< size_t >( cols, 1 ) ), [=]( size_t lo, size_t hi ) {
+                    for ( size_t r = lo; r < hi; ++r )
+                    {
+                        for ( size_t c = 0; c < cols; ++c ) dst[ L2::offset( r, c, rows, cols ) ] = src[ L::offset( r, c, rows, cols ) ];
+                    }
+                } );
+                return output;
             }
-            return final;
         }
 
         /**
@@ -153,7 +665,7 @@ namespace SKAS::matrix
             {
                 throw matrixDimError{"CANNOT getelem OUTSIDE OF MATRIX DIMENSIONS"};
             }
-            return data[ col + row * ncol( ) ];
+            return data[ L::offset( row, col, nrow( ), ncol( ) ) ];
         }
 
         auto at( const size_t& row_index, const size_t& col_index ) const -> T
@@ -175,7 +687,7 @@ namespace SKAS::matrix
             {
                 throw matrixDimError{"CANNOT setelem OUTSIDE OF MATRIX DIMENSIONS"};
             }
-            data[ col + row * ncol( ) ] = value;
+            data[ L::offset( row, col, nrow( ), ncol( ) ) ] = value;
         }
 
         /**
@@ -185,7 +697,7 @@ namespace SKAS::matrix
          * @exception matrixDimError thrown when either index is outside of matrix or if row size is not compatible with matrix
          */
 
-        auto insertrow( std::vector< T > t_row, const size_t& index ) -> void
+        auto insertrow( const std::vector< T >& t_row, const size_t& index ) -> void
         {
             if ( !ncol( ) )
             {
@@ -197,74 +709,30 @@ namespace SKAS::matrix
             {
                 throw matrixDimError{"CANNOT APPEND ROW OF SIZE NOT EQUAL TO COL DIMENSION!"};
             }
-            else
+            else if constexpr ( std::same_as< L, row_major > )
             {
-                vect::vect< T > new_data( data.size( ) + t_row.size( ) );
-                int j = 0;
-                int i = 0;
-                int l = 0;
-                for ( int j = 0; j < nrow( ) + 1; ++j )
-                {
-                    if ( j == index )
-                    {
-                        for ( int k = 0; k < ncol( ); ++k )
-                        {
-                            new_data[ i++ ] = t_row[ k ];
-                        }
-                    }
-                    if ( j != index )
-                    {
-                        for ( int k = 0; k < ncol( ); ++k )
-                        {
-                            new_data[ i++ ] = data[ l++ ];
-                        }
-                    }
-                }
-                data = new_data;
+                // indicies past the end append
+                data.insert( data.begin( ) + std::min( index, nrow( ) ) * ncol( ), t_row.begin( ), t_row.end( ) );
                 dim_n++;
             }
-        }
-
-        auto insertrow( SKAS::vect::vect< T > t_row, const size_t& index ) -> void
-        {
-            if ( !ncol( ) )
+            else if constexpr ( std::same_as< L, col_major > )
             {
-                data = t_row;
-                dim_n = 1;
-                dim_m = t_row.size( );
-            }
-            else if ( t_row.size( ) != dim_m )
-            {
-                throw matrixDimError{"CANNOT APPEND ROW OF SIZE NOT EQUAL TO COL DIMENSION!"};
+                widen( data, ncol( ), nrow( ), t_row, std::min( index, nrow( ) ) );
+                dim_n++;
             }
             else
             {
-                vect::vect< T > new_data( data.size( ) + t_row.size( ) );
-                int j = 0;
-                int i = 0;
-                int l = 0;
-                for ( int j = 0; j < nrow( ) + 1; ++j )
-                {
-                    if ( j == index )
-                    {
-                        for ( int k = 0; k < ncol( ); ++k )
-                        {
-                            new_data[ i++ ] = t_row[ k ];
-                        }
-                    }
-                    if ( j != index )
-                    {
-                        for ( int k = 0; k < ncol( ); ++k )
-                        {
-                            new_data[ i++ ] = data[ l++ ];
-                        }
-                    }
-                }
-                data = new_data;
-                dim_n++;
+                matrix< T > rows = relayout< row_major >( );
+                rows.insertrow( t_row, index );
+                *this = rows.template relayout< L >( );
             }
         }
 
+        auto insertrow( const SKAS::vect::vect< T >& t_row, const size_t& index ) -> void
+        {
+            insertrow( t_row.toVect( ), index );
+        }
+
         /**
          * @brief append row to bottom of matrix
          * @param t_row std::vector< T > row to append
@@ -287,7 +755,7 @@ namespace SKAS::matrix
          * @exception matrixDimError thrown when either index is outside of matrix or if col size is not compatible with matrix
          */
 
-        auto insertcol( std::vector< T > t_col, const size_t& index_t, int quantity = 1 ) -> void
+        auto insertcol( const std::vector< T >& t_col, const size_t& index_t, int quantity = 1 ) -> void
         {
             if ( !dim_n )
             {
@@ -299,60 +767,28 @@ namespace SKAS::matrix
             {
                 throw matrixDimError{"CANNOT APPEND COLUMN OF SIZE NOT EQUAL TO ROW DIMENSION"};
             }
-            else
+            else if constexpr ( std::same_as< L, row_major > )
             {
-                int index = index_t;
-                std::vector< T > new_data( data.size( ) + t_col.size( ) );
-                int j = 0;
-                int k = 0;
-                for ( int i = 0; i < new_data.size( ); i++ )
-                {
-                    if ( ( std::abs( index - i ) % ( ncol( ) + 1 ) ) == 0 )
-                    {
-                        new_data[ i ] = t_col[ k++ ];
-                    }
-                    else
-                    {
-                        new_data[ i ] = data[ j++ ];
-                    }
-                }
+                // indicies past the end append
+                widen( data, nrow( ), ncol( ), t_col, std::min( index_t, ncol( ) ) );
                 dim_m++;
-                data = new_data;
-            }    
-        }
-
-        auto insertcol( SKAS::vect::vect< T > t_col, const size_t& index_t, int quantity = 1 ) -> void
-        {
-            if ( !dim_n )
-            {
-                data = t_col;
-                dim_m = 1;
-                dim_n = t_col.size( );
             }
-            else if ( t_col.size( ) != dim_n )
+            else if constexpr ( std::same_as< L, col_major > )
             {
-                throw matrixDimError{"CANNOT APPEND COLUMN OF SIZE NOT EQUAL TO ROW DIMENSION"};
+                data.insert( data.begin( ) + std::min( index_t, ncol( ) ) * nrow( ), t_col.begin( ), t_col.end( ) );
+                dim_m++;
             }
             else
             {
-                std::vector< T > new_data( data.size( ) + t_col.size( ) );
-                int j = 0;
-                int k = 0;
-                int index = index_t;
-                for ( int i = 0; i < new_data.size( ); i++ )
-                {
-                    if ( ( std::abs( index - i ) % ( ncol( ) + 1 ) ) == 0 )
-                    {
-                        new_data[ i ] = t_col[ k++ ];
-                    }
-                    else
-                    {
-                        new_data[ i ] = data[ j++ ];
-                    }
-                }
-                dim_m++;
-                data = new_data;
-            }    
+                matrix< T > rows = relayout< row_major >( );
+                rows.insertcol( t_col, index_t, quantity );
+                *this = rows.template relayout< L >( );
+            }
+        }
+
+        auto insertcol( const SKAS::vect::vect< T >& t_col, const size_t& index_t, int quantity = 1 ) -> void
+        {
+            insertcol( t_col.toVect( ), index_t, quantity );
         }
 
         /**
@@ -379,16 +815,16 @@ namespace SKAS::matrix
         auto t( ) const -> matrix
         {
             if ( is_empty( ) ) return *this;
+            const size_t rows = nrow( );
+            const size_t cols = ncol( );
             vect::vect< T > outdata( data.size( ) );
-            for ( int i = 0; i < ncol( ); ++i )
+            const T* src = data.data( );
+            T* dst = outdata.data( );
+            for ( size_t r = 0; r < rows; ++r )
             {
-                for ( int j = 0; j < nrow( ); ++j )
-                {
-                    outdata[ j + i*nrow( ) ] = data[ j * ncol( ) + i ];
-                }
+                for ( size_t c = 0; c < cols; ++c ) dst[ L::offset( c, r, cols, rows ) ] = src[ L::offset( r, c, rows, cols ) ];
             }
-            matrix out( outdata, ncol( ), nrow( ), is_parallel( ) );
-            return out;
+            return matrix( std::move( outdata ), cols, rows, get_policy( ) );
         }
         
         /**
@@ -403,7 +839,15 @@ namespace SKAS::matrix
             {
                 throw matrixDimError{"CANNOT DROP ROW OUTSIDE MATRIX DIMENSIONS"};
             }
-            data.erase(data.begin( ) + ( index * ncol( ) ), data.begin( ) + ( ( index + 1 ) * ( ncol( ) ) ) );
+            if constexpr ( std::same_as< L, row_major > ) data.erase( data.begin( ) + ( index * ncol( ) ), data.begin( ) + ( ( index + 1 ) * ( ncol( ) ) ) );
+            else if constexpr ( std::same_as< L, col_major > ) narrow( data, ncol( ), nrow( ), index );
+            else
+            {
+                matrix< T > rows = relayout< row_major >( );
+                rows.droprow( index );
+                *this = rows.template relayout< L >( );
+                return;
+            }
             dim_n--;
         }
 
@@ -418,39 +862,76 @@ namespace SKAS::matrix
             {
                 throw matrixDimError{"CANNOT DROP ROW OUTSIDE MATRIX DIMENSIONS"};
             }
-            for ( int i = nrow( ) - 1; i >= 0; i-- )
+            if constexpr ( std::same_as< L, row_major > ) narrow( data, nrow( ), ncol( ), index );
+            else if constexpr ( std::same_as< L, col_major > ) data.erase( data.begin( ) + ( index * nrow( ) ), data.begin( ) + ( ( index + 1 ) * nrow( ) ) );
+            else
             {
-            data.erase( data.begin( ) + index + i * ncol( ), data.begin( ) + index + i * ncol( ) + 1 );
+                matrix< T > rows = relayout< row_major >( );
+                rows.dropcol( index );
+                *this = rows.template relayout< L >( );
+                return;
             }
             dim_m--;
         }
 
         auto is_parallel( ) const -> bool
         {
-            return parallel;
+            return data.is_parallel( );
+        }
+
+        /**
+         * @brief execution policy of operations on this matrix
+         */
+        auto get_policy( ) const -> exec::policy
+        {
+            return data.get_policy( );
+        }
+
+        auto set_policy( const exec::policy t_policy ) -> void
+        {
+            data.set_policy( t_policy );
         }
 
+        /**
+         * @brief copy of the underlying vect, in layout L. O( 1 ): it shares the matrix's buffer until either side is written
+         */
         auto getinterior( ) const -> vect::vect< T >
         {
             return data;
         }
 
+        /**
+         * @brief read-only access to the underlying vect, in layout L, without copying it (keeps its device mirror)
+         */
+        auto storage( ) const -> const vect::vect< T >&
+        {
+            return data;
+        }
+
+        /**
+         * @brief writable access to the underlying vect, in layout L. its size must stay nrow( ) * ncol( )
+         */
+        auto storage( ) -> vect::vect< T >&
+        {
+            return data;
+        }
+
         auto it_at( const size_t rowIndex, const size_t colIndex ) -> std::vector< T >::iterator
         {
             if ( rowIndex >= nrow( ) || colIndex >= ncol( ) ) throw matrixDimError{"CANNOT RETRIEVE ITERATOR TO ELEMENT OUTSIDE OF MATRIX DIM"};
-            return data.begin( ) + rowIndex*ncol( ) + colIndex;
+            return data.begin( ) + L::offset( rowIndex, colIndex, nrow( ), ncol( ) );
         }
 
         auto it_at( const size_t rowIndex, const size_t colIndex ) const -> std::vector< T >::const_iterator
         {
             if ( rowIndex >= nrow( ) || colIndex >= ncol( ) ) throw matrixDimError{"CANNOT RETRIEVE ITERATOR TO ELEMENT OUTSIDE OF MATRIX DIM"};
-            return data.begin( ) + rowIndex*ncol( ) + colIndex;
+            return data.begin( ) + L::offset( rowIndex, colIndex, nrow( ), ncol( ) );
         }
 
         auto operator==( const matrix& c_matrix ) const -> bool
         {
             if ( c_matrix.ncol( ) != ncol( ) || c_matrix.nrow( ) != nrow( ) ) return false;
-            if ( c_matrix.getinterior( ) != getinterior( ) ) return false;
+            if ( c_matrix.storage( ) != storage( ) ) return false;
             else return true;
         }
 
@@ -461,6 +942,9 @@ namespace SKAS::matrix
 
     }; // =========================END OF MEMBER FUNCTIONS FOR MATRIX CLASS=========================
 
+    // panel width of the blocked factorizations
+    inline constexpr size_t factor_block = 32;
+
 }; // namespace SKAS::matrix -end
 
 namespace SKAS::matrix::accel_matr
@@ -477,6 +961,42 @@ namespace SKAS::matrix::accel_matr
     template < SKAS::FlAd T1 >
     auto PM_mul( const SKAS::matrix::matrix< T1 >& a_matrix, const SKAS::matrix::matrix< T1 >& b_matrix ) -> SKAS::matrix::matrix< T1 >;
 
+    // non-blocking variants, see SKAS::gpu::pending. operands must stay alive until the handle has completed.
+
+    template < SKAS::FlAd T1 >
+    auto PM_scale_async( const SKAS::matrix::matrix< T1 >& t_matrix, T1 scalar, const std::vector< sycl::event >& deps = { } ) -> gpu::pending< SKAS::matrix::matrix< T1 > >;
+
+    template < SKAS::FlAd T1 >
+    auto PM_add_async( const SKAS::matrix::matrix< T1 >& a_matrix, const SKAS::matrix::matrix< T1 >& b_matrix, const std::vector< sycl::event >& deps = { } ) -> gpu::pending< SKAS::matrix::matrix< T1 > >;
+
+    template < SKAS::FlAd T1 >
+    auto PM_sub_async( const SKAS::matrix::matrix< T1 >& a_matrix, const SKAS::matrix::matrix< T1 >& b_matrix, const std::vector< sycl::event >& deps = { } ) -> gpu::pending< SKAS::matrix::matrix< T1 > >;
+
+    template < SKAS::FlAd T1 >
+    auto PM_mul_async( const SKAS::matrix::matrix< T1 >& a_matrix, const SKAS::matrix::matrix< T1 >& b_matrix, const std::vector< sycl::event >& deps = { } ) -> gpu::pending< SKAS::matrix::matrix< T1 > >;
+
+    template < SKAS::FlAd T1 >
+    auto PM_gemv_into( const bool trans, const T1 alpha, const SKAS::matrix::matrix< T1 >& a_matrix, const SKAS::vect::vect< T1 >& x_vect, const T1 beta, SKAS::vect::vect< T1 >& y_vect, const std::vector< sycl::event >& deps = { } ) -> sycl::event;
+
+    template < SKAS::FlAd T >
+    auto gemm_tiled( const bool trans_a, const bool trans_b, const size_t m, const size_t n, const size_t k,
+                     const T alpha, const T* dev_a, const size_t lda, const T* dev_b, const size_t ldb,
+                     const T beta, T* dev_c, const size_t ldc, const std::vector< sycl::event >& deps ) -> sycl::event;
+
+    template < SKAS::FlAd T1 >
+    auto PM_gemm_into( const bool trans_a, const bool trans_b, const T1 alpha, const SKAS::matrix::matrix< T1 >& a_matrix, const SKAS::matrix::matrix< T1 >& b_matrix, const T1 beta, SKAS::matrix::matrix< T1 >& c_matrix, const std::vector< sycl::event >& deps = { } ) -> sycl::event;
+
+    template < SKAS::FlAd T1 >
+    auto PM_cholesky_panel( SKAS::vect::vect< T1 >& a, const size_t n, const size_t k0, const size_t nb ) -> size_t;
+
+    template < SKAS::FlAd T1 >
+    auto PM_trsm_block( const bool lower, const bool trans, const bool unit, const size_t nb, const T1* dev_a, const size_t lda, T1* dev_b, const size_t ldb, const size_t k, const std::vector< sycl::event >& deps = { } ) -> sycl::event;
+
+    template < SKAS::FlAd T1 >
+    auto PM_zero_diagonal( const T1* dev_a, const size_t n ) -> size_t;
+
+    template < SKAS::FlAd T1 >
+    auto PM_lu_swap_rows( T1* dev_a, const size_t n, const size_t k0, const size_t nb, const std::array< size_t, SKAS::matrix::factor_block >& pivots, const std::vector< sycl::event >& deps = { } ) -> sycl::event;
 
 }; // namespace SKAS::matrix::accel_matr -end
 
@@ -487,115 +1007,213 @@ namespace SKAS::matrix
      * @param os stream
      * @param t_matrix matrix to insert
      */
-    template < SKAS::FlAd T > 
-    auto operator<<( std::ostream& os, const matrix< T >& t_matrix ) -> std::ostream&
+    template < SKAS::FlAd T, typename L > 
+    auto operator<<( std::ostream& os, const matrix< T, L >& t_matrix ) -> std::ostream&
     {
-        auto it = t_matrix.it_at( 0, 0 );
         for ( int j = 0; j < t_matrix.nrow( ); ++j )
         {
             std::cout << "[ ";
             for ( int i = 0; i < t_matrix.ncol( ); ++i ) 
             {
-                std::cout << *it << " ";
-                ++it;
+                std::cout << t_matrix.at( j, i ) << " ";
             }
             std::cout << "]\n";
         }
         return os;
     }
 
+    template < typename E, typename L >
+    auto operator<<( std::ostream& os, const matr_expr< E, L >& expression ) -> std::ostream&
+    {
+        return os << matrix< typename E::value_type, L >( expression );
+    }
+
+    template < typename X >
+    inline constexpr bool is_matrix_v = false;
+
+    template < SKAS::FlAd T, typename L >
+    inline constexpr bool is_matrix_v< matrix< T, L > > = true;
+
+    template < typename E, typename L >
+    inline constexpr bool is_matrix_v< matr_expr< E, L > > = true;
+
+    template < typename V >
+    inline constexpr bool is_matrix_v< block_view< V > > = true;
+
+    /**
+     * @brief anything the element-wise matrix operators accept: a matrix, a block_view or a pending matr_expr
+     */
+    template < typename X >
+    concept matrix_operand = is_matrix_v< X >;
+
+    /**
+     * @brief storage layout of a matrix operand. block views are windows of row-major storage
+     */
+    template < typename X >
+    struct layout_of
+    {
+        using type = row_major;
+    };
+
+    template < SKAS::FlAd T, typename L >
+    struct layout_of< matrix< T, L > >
+    {
+        using type = L;
+    };
+
+    template < typename E, typename L >
+    struct layout_of< matr_expr< E, L > >
+    {
+        using type = L;
+    };
+
+    template < typename X >
+    using layout_of_t = typename layout_of< X >::type;
+
+    /**
+     * @brief element-wise operands must agree on value type and layout, so their flat storage lines up
+     */
+    template < typename X, typename Y >
+    concept elementwise_compatible = std::same_as< typename X::value_type, typename Y::value_type > && std::same_as< layout_of_t< X >, layout_of_t< Y > >;
+
+    template < matrix_operand X >
+    auto as_vexpr( const X& x )
+    {
+        if constexpr ( requires { x.storage( ); } ) return SKAS::vect::as_expr( x.storage( ) );
+        else if constexpr ( requires { x.elements( ); } ) return x.elements( );
+        else return x.e;
+    }
+
+    template < typename L, SKAS::expr::expression E >
+    auto make_matr_expr( E e, const size_t rows, const size_t cols ) -> matr_expr< E, L >
+    {
+        return matr_expr< E, L >{ e, rows, cols };
+    }
+
     /**
-     * @brief matrix scale support
+     * @brief matrix scale support. lazy: scaling is computed when assigned to a matrix
      * @param t_matrix matrix to scale
-     * @param scalar long double
-     * @return scaled matrix
+     * @param scalar .numeric
+     * @return scaled matrix expression
      */
-    template < SKAS::FlAd T > 
-    auto operator*( const matrix< T >& t_matrix, T scalar ) -> matrix< T >
+    template < matrix_operand X, typename S >
+        requires std::is_arithmetic_v< S >
+    auto operator*( const X& t_matrix, S scalar )
     {
-        if ( t_matrix.is_parallel( ) ) return accel_matr::PM_scale( t_matrix, scalar );
-        matrix< T > output = t_matrix;
-        for ( int i = 0; i < t_matrix.nrow( ); ++i )
-        {
-            for ( int j = 0; j < t_matrix.ncol( ); ++j )
-            {
-                output.setelem( output.getelem( i, j ) * scalar, i, j );
-            }
-        }
-        return output;
+        return make_matr_expr< layout_of_t< X > >( as_vexpr( t_matrix ) * scalar, t_matrix.nrow( ), t_matrix.ncol( ) );
     }
 
     /**
-     * @brief matrix scale support
+     * @brief matrix scale support. lazy: scaling is computed when assigned to a matrix
      * @param t_matrix matrix to scale
-     * @param scalar long double
-     * @return scaled matrix
+     * @param scalar .numeric
+     * @return scaled matrix expression
      */
-    template < SKAS::FlAd T > 
-    auto operator*( T scalar, const matrix< T >& t_matrix ) -> matrix< T >
+    template < matrix_operand X, typename S >
+        requires std::is_arithmetic_v< S >
+    auto operator*( S scalar, const X& t_matrix )
     {
-        if ( t_matrix.is_parallel( ) ) return accel_matr::PM_scale( t_matrix, scalar );
-        matrix< T > output = t_matrix;
-        for ( int i = 0; i < t_matrix.nrow( ); ++i )
-        {
-            for ( int j = 0; j < t_matrix.ncol( ); ++j )
-            {
-                output.setelem( output.getelem( i, j ) * scalar, i, j );
-            }
-        }
-        return output;
+        return t_matrix * scalar;
+    }
+
+    // as for vect, a temporary matrix operand is computed into in place and returned instead of kept as a lazy leaf
+
+    template < SKAS::FlAd T, typename L, typename S >
+        requires std::is_arithmetic_v< S >
+    auto operator*( matrix< T, L >&& t_matrix, S scalar ) -> matrix< T, L >
+    {
+        t_matrix = t_matrix * scalar;
+        return std::move( t_matrix );
+    }
+
+    template < SKAS::FlAd T, typename L, typename S >
+        requires std::is_arithmetic_v< S >
+    auto operator*( S scalar, matrix< T, L >&& t_matrix ) -> matrix< T, L >
+    {
+        t_matrix = t_matrix * scalar;
+        return std::move( t_matrix );
     }
 
     /**
-     * @brief matrix addition support
+     * @brief matrix addition support. lazy: the sum is computed when assigned to a matrix
      * @param a_matrix left matrix to add
      * @param b_matrix right matrix to add
-     * @return matrix result
+     * @return matrix expression
      * @exception dimSizeError thrown when mismatched dimensions
      */
-    template < SKAS::FlAd T > 
-    auto operator+( const matrix< T >& a_matrix, const matrix< T >& b_matrix ) -> matrix< T >
+    template < matrix_operand X, matrix_operand Y >
+        requires elementwise_compatible< X, Y >
+    auto operator+( const X& a_matrix, const Y& b_matrix )
     {
         if ( a_matrix.ncol( ) != b_matrix.ncol( ) || a_matrix.nrow( ) != b_matrix.nrow( ) )
         {
             throw matrixDimError{"CANNOT ADD MATRICIES OF INCOMPATIBLE DIMENSIONS"};
         }
-        if ( a_matrix.is_parallel() && b_matrix.is_parallel() ) return accel_matr::PM_add( a_matrix, b_matrix );
-        matrix< T > output = a_matrix;
-        for ( int i = 0; i < a_matrix.nrow( ); ++i )
-        {
-            for ( int j = 0; j < a_matrix.ncol( ); ++j )
-            {
-                output.setelem( a_matrix.getelem(i,j) + b_matrix.getelem(i,j), i, j );
-            }
-        }
-        return output;
+        return make_matr_expr< layout_of_t< X > >( as_vexpr( a_matrix ) + as_vexpr( b_matrix ), a_matrix.nrow( ), a_matrix.ncol( ) );
+    }
+
+    template < SKAS::FlAd T, typename L, matrix_operand Y >
+        requires elementwise_compatible< matrix< T, L >, Y >
+    auto operator+( matrix< T, L >&& a_matrix, const Y& b_matrix ) -> matrix< T, L >
+    {
+        a_matrix = a_matrix + b_matrix;
+        return std::move( a_matrix );
+    }
+
+    template < matrix_operand X, SKAS::FlAd T, typename L >
+        requires elementwise_compatible< X, matrix< T, L > >
+    auto operator+( const X& a_matrix, matrix< T, L >&& b_matrix ) -> matrix< T, L >
+    {
+        b_matrix = a_matrix + b_matrix;
+        return std::move( b_matrix );
+    }
+
+    template < SKAS::FlAd T, typename L >
+    auto operator+( matrix< T, L >&& a_matrix, matrix< T, L >&& b_matrix ) -> matrix< T, L >
+    {
+        a_matrix = a_matrix + b_matrix;
+        return std::move( a_matrix );
     }
 
     /**
-     * @brief matrix subtraction support
+     * @brief matrix subtraction support. lazy: the difference is computed when assigned to a matrix
      * @param a_matrix left matrix to subtract
      * @param b_matrix right matrix to subtract
-     * @return matrix result
+     * @return matrix expression
      * @exception dimSizeError thrown when mismatched dimensions
      */
-    template < SKAS::FlAd T > 
-    auto operator-( const matrix< T >& a_matrix, const matrix< T >& b_matrix ) -> matrix< T >
+    template < matrix_operand X, matrix_operand Y >
+        requires elementwise_compatible< X, Y >
+    auto operator-( const X& a_matrix, const Y& b_matrix )
     {
         if ( a_matrix.ncol( ) != b_matrix.ncol( ) || a_matrix.nrow( ) != b_matrix.nrow( ) )
         {
             throw matrixDimError{"CANNOT ADD MATRICIES OF INCOMPATIBLE DIMENSIONS"};
         }
-        if ( a_matrix.is_parallel() && b_matrix.is_parallel() ) return accel_matr::PM_sub(a_matrix,b_matrix);
-        matrix< T > output = a_matrix;
-        for ( int i = 0; i < a_matrix.nrow( ); ++i )
-        {
-            for ( int j = 0; j < a_matrix.ncol( ); ++j )
-            {
-                output.setelem( a_matrix.getelem(i,j) - b_matrix.getelem(i,j), i, j );
-            }
-        }
-        return output;
+        return make_matr_expr< layout_of_t< X > >( as_vexpr( a_matrix ) - as_vexpr( b_matrix ), a_matrix.nrow( ), a_matrix.ncol( ) );
+    }
+
+    template < SKAS::FlAd T, typename L, matrix_operand Y >
+        requires elementwise_compatible< matrix< T, L >, Y >
+    auto operator-( matrix< T, L >&& a_matrix, const Y& b_matrix ) -> matrix< T, L >
+    {
+        a_matrix = a_matrix - b_matrix;
+        return std::move( a_matrix );
+    }
+
+    template < matrix_operand X, SKAS::FlAd T, typename L >
+        requires elementwise_compatible< X, matrix< T, L > >
+    auto operator-( const X& a_matrix, matrix< T, L >&& b_matrix ) -> matrix< T, L >
+    {
+        b_matrix = a_matrix - b_matrix;
+        return std::move( b_matrix );
+    }
+
+    template < SKAS::FlAd T, typename L >
+    auto operator-( matrix< T, L >&& a_matrix, matrix< T, L >&& b_matrix ) -> matrix< T, L >
+    {
+        a_matrix = a_matrix - b_matrix;
+        return std::move( a_matrix );
     }
 
     /**
@@ -604,10 +1222,10 @@ namespace SKAS::matrix
      * @return matrix result
      * @exception realError thrown when sqrt applied on negative number
      */
-    template < SKAS::FlAd T > 
-    auto sqrt( const matrix< T >& a_matrix ) -> matrix< T >
+    template < SKAS::FlAd T, typename L > 
+    auto sqrt( const matrix< T, L >& a_matrix ) -> matrix< T, L >
     {
-        matrix< T > out = a_matrix;
+        matrix< T, L > out = a_matrix;
         T val;
         for ( int i = 0; i < out.nrow( ); ++i )
         {
@@ -659,270 +1277,1283 @@ namespace SKAS::matrix
     }
 
     /**
-     * @brief matrix multiplication
-     * @param a_matrix left side matrix to multiply. 
-     * @param b_matrix right side matrix to multiply.
-     * @return matrix post-multiplication
-     * @exception dimSizeError for matricies of incompatible dimensions 
+     * @brief identity matching a factored matrix's dimension and policy, the right-hand side of an inverse
      */
     template < SKAS::FlAd T >
-    auto operator%( const matrix< T >& a_matrix, const matrix< T >& b_matrix ) -> matrix< T >
+    auto identity_like( const size_t dim, const exec::policy t_policy ) -> matrix< T >
     {
-        if ( a_matrix.ncol( ) != b_matrix.nrow( ) ) throw matrixDimError{"CANNOT MULTIPLY MATRICIES OF INCOMPATIBLE DIMENSIONS"};
-        if ( a_matrix.is_parallel() && b_matrix.is_parallel() ) return accel_matr::PM_mul(a_matrix,b_matrix);
-        matrix< T > product( 0, b_matrix.ncol( ), a_matrix.nrow( ) );
-        const auto ait = a_matrix.it_at(0,0);
-        const auto bit = b_matrix.it_at(0,0);
-        T sum = 0;
-        for ( int i = 0; i < product.nrow( ); ++i )
-        {
-            for ( int j = 0; j < product.ncol( ); ++j )
-            {
-                sum = 0;
-                for ( int k = 0; k < b_matrix.nrow( ); ++k )
-                {
-                    sum += *( ait + a_matrix.ncol( )*i + k ) * *( bit + j + k*b_matrix.ncol( ) );
-                }
-                product.setelem( sum, i, j );
-            }
-        }
-        return product;
+        matrix< T > output = identity< T >( dim );
+        output.set_policy( t_policy );
+        return output;
     }
 
-
-    // spd inversion
+    /**
+     * @brief assembles a matrix row by row in one growing buffer, for design matrices built from streamed records.
+     * each row appends in amortized O( ncol ) and build( ) hands the buffer to the matrix without copying it
+     */
     template < SKAS::FlAd T >
-    auto spd( const matrix< T >& a_matrix ) -> matrix< T >
+    class matrix_builder
     {
-        //checking for user issues or edge cases
-        if ( a_matrix.ncol( ) != a_matrix.nrow( ) )
+        private:
+        size_t cols;
+        size_t rows;
+        exec::policy pol;
+        std::vector< T > buffer;
+
+        public:
+        explicit matrix_builder( const size_t colcount, const exec::policy t_policy = exec::policy::seq ) : cols( colcount ), rows( 0 ), pol( t_policy ) { }
+
+        /**
+         * @brief makes room for rowcount rows, so appending up to them does not reallocate
+         */
+        auto reserve( const size_t rowcount ) -> void
         {
-            throw matrixDimError{"CANNOT INVERT NON-SQUARE MATRICIES UNDER SPD PARAMETER"};
+            buffer.reserve( rowcount * cols );
         }
-        if ( !a_matrix.ncol( ) )
+
+        /**
+         * @exception matrixDimError thrown when count is not the builder's column count
+         */
+        auto append( const T* row, const size_t count ) -> void
         {
-            return a_matrix;
+            if ( count != cols ) throw matrixDimError{"CANNOT APPEND ROW OF SIZE NOT EQUAL TO BUILDER COL DIMENSION"};
+            buffer.insert( buffer.end( ), row, row + count );
+            ++rows;
         }
-        if ( a_matrix.nrow( ) == 1 && a_matrix.ncol( ) == 1 )
+
+        auto append( const std::vector< T >& row ) -> void
         {
-            if ( !a_matrix.getelem( 1, 1 ) )
-            {
-                throw solutionError{"NON-INVERTIBLE MATRIX CANNOT BE SOLVED"};
-            }
-            else
-            {
-                matrix< T > output( 1.0 / a_matrix.getelem( 1, 1 ), 1, 1 );
-                return output;
-            }
+            append( row.data( ), row.size( ) );
         }
-        auto dim = a_matrix.ncol( );
-        long double sum = 0;
-        matrix< T > L( 0, dim, dim );
 
-        //cholesky decomposition
-        for ( int i = 0; i < dim; i++ )
+        auto append( const vect::vect< T >& row ) -> void
         {
-            for ( int j = 0; j <= i; j++ )
-            {
-                sum = 0;
-                if ( i == j )
-                {
-                    for ( int k = 0; k <= j - 1; ++k )
-                    {
-                        sum += pow( L.getelem( j, k ), 2 );
-                    }
-                    L.setelem( ( std::sqrt( a_matrix.getelem( i, j ) - sum ) ), i, j );
-                }
-                else
-                {
-                    for ( int k = 0; k <= j - 1; k++ )
-                    {
-                        sum += L.getelem( i, k ) * L.getelem( j, k );
-                    }
-                    L.setelem( ( 1.0 / L.getelem( j, j ) * ( a_matrix.getelem( i, j ) - sum ) ), i, j );
-                }
-            } 
+            append( row.data( ), row.size( ) );
+        }
+
+        auto append( std::initializer_list< T > row ) -> void
+        {
+            append( row.begin( ), row.size( ) );
+        }
+
+        auto nrow( ) const -> size_t
+        {
+            return rows;
+        }
+
+        auto ncol( ) const -> size_t
+        {
+            return cols;
         }
-        //forward substituion
-        matrix< T > Linv = triangularinvert( L, true );
-        return ( Linv.t( ) % Linv );
-    }
 
+        /**
+         * @brief the assembled nrow( ) x ncol( ) matrix. the builder is left empty
+         */
+        auto build( ) -> matrix< T >
+        {
+            matrix< T > output( vect::vect< T >( std::move( buffer ), pol ), rows, cols, pol );
+            buffer.clear( );
+            rows = 0;
+            return output;
+        }
+    };
 
     /**
-     * @brief matrix inversion. as of 11-25-2025 only type symmetric positive definite supported. this function is expensive; save copy if needed in repetition.
-     * @param a_matrix matrix to invert
-     * @param type std::string. type of matrix. only "spd" supported currently
-     * @exception dimSizeError if non-square using "spd" type
-     * @exception solutionError if singularity detected
-     * @return matrix
+     * @brief stacks matricies of equal column count top to bottom into one allocation, under their common policy
+     * @exception matrixDimError thrown for unequal column counts
      */
     template < SKAS::FlAd T >
-    auto invert( const matrix< T >& a_matrix, std::string type = "qr" ) -> matrix< T >
+    auto vstack( const std::vector< matrix< T > >& pieces ) -> matrix< T >
     {
-        if ( type == "spd" )
-        {
-            return spd( a_matrix );
-        }
-        if ( type == "qr" )
+        if ( pieces.empty( ) ) return matrix< T >( );
+        size_t rows = 0;
+        exec::policy pol = pieces[ 0 ].get_policy( );
+        for ( const auto& piece : pieces )
         {
-            auto QR = qr_decomp( a_matrix );
-            return triangularinvert( QR[ 1 ], false ) % QR[ 0 ].t( );
+            if ( piece.ncol( ) != pieces[ 0 ].ncol( ) ) throw matrixDimError{"CANNOT VSTACK MATRICIES OF UNEQUAL COL DIMENSION"};
+            rows += piece.nrow( );
+            pol = exec::common( pol, piece.get_policy( ) );
         }
-        else
+        matrix< T > output( T{0}, rows, pieces[ 0 ].ncol( ), pol );
+        T* out = output.storage( ).data( );
+        for ( const auto& piece : pieces )
         {
-            throw solutionError{"INCORRECT TYPE PARAMETER"};
+            out = std::copy( piece.storage( ).data( ), piece.storage( ).enddata( ), out );
         }
+        return output;
     }
 
     /**
-     * @brief solves Ax = b for lower triangular matrix
-     * @param lower_matrix triangular matrix to solve. singularity is checked.
-     * @param b vector to solve
-     * @return the solution x for Ax = b
-     * @exception solutionError thrown for singularity
+     * @brief places matricies of equal row count side by side into one allocation, under their common policy
+     * @exception matrixDimError thrown for unequal row counts
      */
     template < SKAS::FlAd T >
-    auto forwardsolve( const matrix< T >& lower_matrix, const vect::vect< T >& b ) -> vect::vect< T >
+    auto hstack( const std::vector< matrix< T > >& pieces ) -> matrix< T >
     {
-        vect::vect< T > x;
-        T sum = 0;
-        for ( int m = 0; m < b.size( ); ++m )
+        if ( pieces.empty( ) ) return matrix< T >( );
+        const size_t rows = pieces[ 0 ].nrow( );
+        size_t cols = 0;
+        exec::policy pol = pieces[ 0 ].get_policy( );
+        for ( const auto& piece : pieces )
         {
-            sum = 0;
-            for ( int i = 0; i < m; ++i )
+            if ( piece.nrow( ) != rows ) throw matrixDimError{"CANNOT HSTACK MATRICIES OF UNEQUAL ROW DIMENSION"};
+            cols += piece.ncol( );
+            pol = exec::common( pol, piece.get_policy( ) );
+        }
+        matrix< T > output( T{0}, rows, cols, pol );
+        T* out = output.storage( ).data( );
+        size_t col0 = 0;
+        for ( const auto& piece : pieces )
+        {
+            const T* in = piece.storage( ).data( );
+            const size_t width = piece.ncol( );
+            for ( size_t r = 0; r < rows; ++r ) std::copy( in + r * width, in + ( r + 1 ) * width, out + r * cols + col0 );
+            col0 += width;
+        }
+        return output;
+    }
+
+    /**
+     * @brief matrix multiplication under exec::common of both operands' policies. host policies run
+     * the packed host_matr::gemm, threaded across exec::pool( ) under policy::threaded
+     * @param a_matrix left side matrix to multiply. 
+     * @param b_matrix right side matrix to multiply.
+     * @return matrix post-multiplication
+     * @exception dimSizeError for matricies of incompatible dimensions 
+     */
+    template < SKAS::FlAd T >
+    auto operator%( const matrix< T >& a_matrix, const matrix< T >& b_matrix ) -> matrix< T >
+    {
+        if ( a_matrix.ncol( ) != b_matrix.nrow( ) ) throw matrixDimError{"CANNOT MULTIPLY MATRICIES OF INCOMPATIBLE DIMENSIONS"};
+        const size_t n = a_matrix.nrow( );
+        const size_t inner = a_matrix.ncol( );
+        const size_t m = b_matrix.ncol( );
+        const exec::policy result = exec::common( a_matrix.get_policy( ), b_matrix.get_policy( ) );
+        const exec::policy p = gpu::resolve( result, gpu::op_kind::matmul, n * inner * m );
+        if ( p == exec::policy::device )
+        {
+            matrix< T > product = accel_matr::PM_mul( a_matrix, b_matrix );
+            product.set_policy( result );
+            return product;
+        }
+        matrix< T > product( T{0}, n, m, result );
+        host_matr::gemm( p, false, false, n, m, inner, T{1}, a_matrix.storage( ).data( ), inner, b_matrix.storage( ).data( ), m, T{0}, product.storage( ).data( ), m );
+        return product;
+    }
+
+    /**
+     * @brief general matrix multiply C = alpha * op( A ) * op( B ) + beta * C written into C, where op( X ) is X^T
+     * when its trans flag is set. transposes are never materialized. runs on the device or the host gemm
+     * under exec::common of the three policies (matmul kind for automatic)
+     * @param trans_a use A^T
+     * @param trans_b use B^T
+     * @param alpha .numeric scale of the product
+     * @param a_matrix left operand
+     * @param b_matrix right operand
+     * @param beta .numeric scale of the existing C. with beta == 0, C is not read and is reshaped to fit if needed
+     * @param c_matrix output, must not be a_matrix or b_matrix
+     * @exception matrixDimError thrown for incompatible dimensions or an aliased output
+     */
+    template < SKAS::FlAd T >
+    auto gemm( const bool trans_a, const bool trans_b, const T alpha, const matrix< T >& a_matrix, const matrix< T >& b_matrix, const T beta, matrix< T >& c_matrix ) -> void
+    {
+        const size_t m = trans_a ? a_matrix.ncol( ) : a_matrix.nrow( );
+        const size_t k = trans_a ? a_matrix.nrow( ) : a_matrix.ncol( );
+        const size_t n = trans_b ? b_matrix.nrow( ) : b_matrix.ncol( );
+        if ( k != ( trans_b ? b_matrix.ncol( ) : b_matrix.nrow( ) ) ) throw matrixDimError{"CANNOT GEMM MATRICIES OF INCOMPATIBLE DIMENSIONS"};
+        if ( &c_matrix == &a_matrix || &c_matrix == &b_matrix ) throw matrixDimError{"GEMM OUTPUT CANNOT ALIAS AN INPUT"};
+        if ( c_matrix.nrow( ) != m || c_matrix.ncol( ) != n )
+        {
+            if ( beta != T{0} ) throw matrixDimError{"GEMM OUTPUT DIMENSIONS DO NOT MATCH op( A ) % op( B )"};
+            c_matrix = matrix< T >( T{0}, m, n, exec::common( a_matrix.get_policy( ), b_matrix.get_policy( ) ) );
+        }
+        const exec::policy all = exec::common( exec::common( a_matrix.get_policy( ), b_matrix.get_policy( ) ), c_matrix.get_policy( ) );
+        const exec::policy p = gpu::resolve( all, gpu::op_kind::matmul, m * n * k );
+        if ( p == exec::policy::device )
+        {
+            accel_matr::PM_gemm_into( trans_a, trans_b, alpha, a_matrix, b_matrix, beta, c_matrix ).wait( );
+            return;
+        }
+        host_matr::gemm( p, trans_a, trans_b, m, n, k, alpha, a_matrix.storage( ).data( ), a_matrix.ncol( ),
+                         b_matrix.storage( ).data( ), b_matrix.ncol( ), beta, c_matrix.storage( ).data( ), c_matrix.ncol( ) );
+    }
+
+    /**
+     * @brief matrix-vector product y = alpha * op( A ) * x + beta * y written into y, where op( A ) is A^T when trans
+     * is set. memory-bound, so automatic resolves it as a reduction over the elements of A
+     * @param trans use A^T
+     * @param alpha .numeric scale of the product
+     * @param a_matrix matrix operand
+     * @param x_vect vector operand, of op( A )'s column count
+     * @param beta .numeric scale of the existing y. with beta == 0, y is not read and is resized to fit if needed
+     * @param y_vect output, must not be x_vect
+     * @exception matrixDimError thrown for incompatible dimensions or an aliased output
+     */
+    template < SKAS::FlAd T >
+    auto gemv( const bool trans, const T alpha, const matrix< T >& a_matrix, const vect::vect< T >& x_vect, const T beta, vect::vect< T >& y_vect ) -> void
+    {
+        const size_t m = trans ? a_matrix.ncol( ) : a_matrix.nrow( );
+        const size_t k = trans ? a_matrix.nrow( ) : a_matrix.ncol( );
+        if ( x_vect.size( ) != k ) throw matrixDimError{"CANNOT MULTIPLY MATRIX AND VECTOR OF INCOMPATIBLE DIMENSIONS"};
+        if ( &y_vect == &x_vect || &y_vect == &a_matrix.storage( ) ) throw matrixDimError{"GEMV OUTPUT CANNOT ALIAS AN INPUT"};
+        if ( y_vect.size( ) != m )
+        {
+            if ( beta != T{0} ) throw matrixDimError{"GEMV OUTPUT SIZE DOES NOT MATCH op( A ) % x"};
+            y_vect = vect::vect< T >( m, T{0}, exec::common( a_matrix.get_policy( ), x_vect.get_policy( ) ) );
+        }
+        const exec::policy all = exec::common( exec::common( a_matrix.get_policy( ), x_vect.get_policy( ) ), y_vect.get_policy( ) );
+        const exec::policy p = gpu::resolve( all, gpu::op_kind::reduction, m * k );
+        if ( p == exec::policy::device )
+        {
+            accel_matr::PM_gemv_into( trans, alpha, a_matrix, x_vect, beta, y_vect ).wait( );
+            return;
+        }
+        host_matr::gemv( p, trans, a_matrix.nrow( ), a_matrix.ncol( ), alpha, a_matrix.storage( ).data( ), a_matrix.ncol( ), x_vect.data( ), beta, y_vect.data( ) );
+    }
+
+    /**
+     * @brief gemm over sub-blocks of row-major storage, for the blocked factorizations. each operand is a vect with
+     * an element offset to its block and a row stride; blocks of one vect may be passed as an operand and as c as long
+     * as they do not overlap. runs gemm_tiled on the device mirrors under policy::device, the host gemm otherwise
+     */
+    template < SKAS::FlAd T >
+    auto gemm_block( const exec::policy p, const bool trans_a, const bool trans_b, const size_t m, const size_t n, const size_t k, const T alpha,
+                     const vect::vect< T >& a, const size_t a_off, const size_t lda, const vect::vect< T >& b, const size_t b_off, const size_t ldb,
+                     const T beta, vect::vect< T >& c, const size_t c_off, const size_t ldc ) -> void
+    {
+        if ( p == exec::policy::device )
+        {
+            T* dev_c = c.dev_data( ) + c_off;
+            accel_matr::gemm_tiled< T >( trans_a, trans_b, m, n, k, alpha, a.dev_data( ) + a_off, lda, b.dev_data( ) + b_off, ldb, beta, dev_c, ldc, { } ).wait( );
+            return;
+        }
+        T* host_c = c.data( ) + c_off;
+        host_matr::gemm( p, trans_a, trans_b, m, n, k, alpha, a.data( ) + a_off, lda, b.data( ) + b_off, ldb, beta, host_c, ldc );
+    }
+
+    /**
+     * @brief gemm on blocks of matrices, C = alpha * op( A ) * op( B ) + beta * C written into the c block in place.
+     * blocks of one matrix may be used together as long as c overlaps neither input
+     * @exception matrixDimError thrown for incompatible dimensions or an overlapping output
+     */
+    template < typename VA, typename VB, SKAS::FlAd T >
+    auto gemm( const bool trans_a, const bool trans_b, const T alpha, const block_view< VA >& a_block, const block_view< VB >& b_block, const T beta, const block_view< vect::vect< T > >& c_block ) -> void
+    {
+        const size_t m = trans_a ? a_block.ncol( ) : a_block.nrow( );
+        const size_t k = trans_a ? a_block.nrow( ) : a_block.ncol( );
+        const size_t n = trans_b ? b_block.nrow( ) : b_block.ncol( );
+        if ( k != ( trans_b ? b_block.ncol( ) : b_block.nrow( ) ) || c_block.nrow( ) != m || c_block.ncol( ) != n )
+        {
+            throw matrixDimError{"CANNOT GEMM MATRICIES OF INCOMPATIBLE DIMENSIONS"};
+        }
+        if ( blocks_overlap( c_block, a_block ) || blocks_overlap( c_block, b_block ) ) throw matrixDimError{"GEMM OUTPUT CANNOT ALIAS AN INPUT"};
+        const exec::policy all = exec::common( exec::common( a_block.get_policy( ), b_block.get_policy( ) ), c_block.get_policy( ) );
+        gemm_block( gpu::resolve( all, gpu::op_kind::matmul, m * n * k ), trans_a, trans_b, m, n, k, alpha, *a_block.store, a_block.offset, a_block.ld,
+                    *b_block.store, b_block.offset, b_block.ld, beta, *c_block.store, c_block.offset, c_block.ld );
+    }
+
+    /**
+     * @brief gemv on a block of a matrix, y = alpha * op( A ) * x + beta * y. on the device it runs as a one-column gemm
+     * @exception matrixDimError thrown for incompatible dimensions or an aliased output
+     */
+    template < typename VA, SKAS::FlAd T >
+    auto gemv( const bool trans, const T alpha, const block_view< VA >& a_block, const vect::vect< T >& x_vect, const T beta, vect::vect< T >& y_vect ) -> void
+    {
+        const size_t m = trans ? a_block.ncol( ) : a_block.nrow( );
+        const size_t k = trans ? a_block.nrow( ) : a_block.ncol( );
+        if ( x_vect.size( ) != k ) throw matrixDimError{"CANNOT MULTIPLY MATRIX AND VECTOR OF INCOMPATIBLE DIMENSIONS"};
+        if ( &y_vect == &x_vect || static_cast< const void* >( &y_vect ) == static_cast< const void* >( a_block.store ) ) throw matrixDimError{"GEMV OUTPUT CANNOT ALIAS AN INPUT"};
+        if ( y_vect.size( ) != m )
+        {
+            if ( beta != T{0} ) throw matrixDimError{"GEMV OUTPUT SIZE DOES NOT MATCH op( A ) % x"};
+            y_vect = vect::vect< T >( m, T{0}, exec::common( a_block.get_policy( ), x_vect.get_policy( ) ) );
+        }
+        const exec::policy all = exec::common( exec::common( a_block.get_policy( ), x_vect.get_policy( ) ), y_vect.get_policy( ) );
+        const exec::policy p = gpu::resolve( all, gpu::op_kind::reduction, m * k );
+        if ( p == exec::policy::device )
+        {
+            gemm_block( p, trans, false, m, 1, k, alpha, *a_block.store, a_block.offset, a_block.ld, x_vect, 0, 1, beta, y_vect, 0, 1 );
+            return;
+        }
+        host_matr::gemv( p, trans, a_block.nrow( ), a_block.ncol( ), alpha, std::as_const( *a_block.store ).data( ) + a_block.offset, a_block.ld, x_vect.data( ), beta, y_vect.data( ) );
+    }
+
+    /**
+     * @brief gemm for any mix of layouts. a column-major matrix's storage is the row-major storage of its transpose, so
+     * it enters the row-major kernels with its op flipped, and a column-major C is computed as C^T = op( B )^T op( A )^T.
+     * tiled operands are converted to row-major around the call
+     */
+    template < SKAS::FlAd T, typename LA, typename LB, typename LC >
+        requires ( !( std::same_as< LA, row_major > && std::same_as< LB, row_major > && std::same_as< LC, row_major > ) )
+    auto gemm( const bool trans_a, const bool trans_b, const T alpha, const matrix< T, LA >& a_matrix, const matrix< T, LB >& b_matrix, const T beta, matrix< T, LC >& c_matrix ) -> void
+    {
+        if constexpr ( !strided_layout< LA > ) gemm( trans_a, trans_b, alpha, a_matrix.template relayout< row_major >( ), b_matrix, beta, c_matrix );
+        else if constexpr ( !strided_layout< LB > ) gemm( trans_a, trans_b, alpha, a_matrix, b_matrix.template relayout< row_major >( ), beta, c_matrix );
+        else if constexpr ( !strided_layout< LC > )
+        {
+            matrix< T > c_rows = c_matrix.template relayout< row_major >( );
+            gemm( trans_a, trans_b, alpha, a_matrix, b_matrix, beta, c_rows );
+            c_matrix = c_rows.template relayout< LC >( );
+        }
+        else
+        {
+            const size_t m = trans_a ? a_matrix.ncol( ) : a_matrix.nrow( );
+            const size_t k = trans_a ? a_matrix.nrow( ) : a_matrix.ncol( );
+            const size_t n = trans_b ? b_matrix.nrow( ) : b_matrix.ncol( );
+            if ( k != ( trans_b ? b_matrix.ncol( ) : b_matrix.nrow( ) ) ) throw matrixDimError{"CANNOT GEMM MATRICIES OF INCOMPATIBLE DIMENSIONS"};
+            const void* c_addr = &c_matrix;
+            if ( c_addr == &a_matrix || c_addr == &b_matrix ) throw matrixDimError{"GEMM OUTPUT CANNOT ALIAS AN INPUT"};
+            if ( c_matrix.nrow( ) != m || c_matrix.ncol( ) != n )
+            {
+                if ( beta != T{0} ) throw matrixDimError{"GEMM OUTPUT DIMENSIONS DO NOT MATCH op( A ) % op( B )"};
+                c_matrix = matrix< T, LC >( T{0}, m, n, exec::common( a_matrix.get_policy( ), b_matrix.get_policy( ) ) );
+            }
+            const exec::policy all = exec::common( exec::common( a_matrix.get_policy( ), b_matrix.get_policy( ) ), c_matrix.get_policy( ) );
+            const exec::policy p = gpu::resolve( all, gpu::op_kind::matmul, m * n * k );
+            const bool a_col = std::same_as< LA, col_major >;
+            const bool b_col = std::same_as< LB, col_major >;
+            const bool op_a = trans_a != a_col;
+            const bool op_b = trans_b != b_col;
+            const size_t lda = a_col ? a_matrix.nrow( ) : a_matrix.ncol( );
+            const size_t ldb = b_col ? b_matrix.nrow( ) : b_matrix.ncol( );
+            if constexpr ( std::same_as< LC, col_major > )
+            {
+                gemm_block( p, !op_b, !op_a, n, m, k, alpha, b_matrix.storage( ), 0, ldb, a_matrix.storage( ), 0, lda, beta, c_matrix.storage( ), 0, m );
+            }
+            else
+            {
+                gemm_block( p, op_a, op_b, m, n, k, alpha, a_matrix.storage( ), 0, lda, b_matrix.storage( ), 0, ldb, beta, c_matrix.storage( ), 0, n );
+            }
+        }
+    }
+
+    /**
+     * @brief gemv for column-major and tiled A. column-major storage is the row-major storage of A^T, so the row-major
+     * kernels run on it with trans flipped; tiled A is converted to row-major first
+     */
+    template < SKAS::FlAd T, typename L >
+        requires ( !std::same_as< L, row_major > )
+    auto gemv( const bool trans, const T alpha, const matrix< T, L >& a_matrix, const vect::vect< T >& x_vect, const T beta, vect::vect< T >& y_vect ) -> void
+    {
+        if constexpr ( !strided_layout< L > ) gemv( trans, alpha, a_matrix.template relayout< row_major >( ), x_vect, beta, y_vect );
+        else
+        {
+            const size_t m = trans ? a_matrix.ncol( ) : a_matrix.nrow( );
+            const size_t k = trans ? a_matrix.nrow( ) : a_matrix.ncol( );
+            if ( x_vect.size( ) != k ) throw matrixDimError{"CANNOT MULTIPLY MATRIX AND VECTOR OF INCOMPATIBLE DIMENSIONS"};
+            if ( &y_vect == &x_vect || &y_vect == &a_matrix.storage( ) ) throw matrixDimError{"GEMV OUTPUT CANNOT ALIAS AN INPUT"};
+            if ( y_vect.size( ) != m )
+            {
+                if ( beta != T{0} ) throw matrixDimError{"GEMV OUTPUT SIZE DOES NOT MATCH op( A ) % x"};
+                y_vect = vect::vect< T >( m, T{0}, exec::common( a_matrix.get_policy( ), x_vect.get_policy( ) ) );
+            }
+            const exec::policy all = exec::common( exec::common( a_matrix.get_policy( ), x_vect.get_policy( ) ), y_vect.get_policy( ) );
+            const exec::policy p = gpu::resolve( all, gpu::op_kind::reduction, m * k );
+            if ( p == exec::policy::device )
+            {
+                gemm_block( p, !trans, false, m, 1, k, alpha, a_matrix.storage( ), 0, a_matrix.nrow( ), x_vect, 0, 1, beta, y_vect, 0, 1 );
+                return;
+            }
+            host_matr::gemv( p, !trans, a_matrix.ncol( ), a_matrix.nrow( ), alpha, a_matrix.storage( ).data( ), a_matrix.nrow( ), x_vect.data( ), beta, y_vect.data( ) );
+        }
+    }
+
+    /**
+     * @brief matrix multiplication for operands in other layouts, through gemm. the product takes the left operand's layout
+     */
+    template < SKAS::FlAd T, typename LA, typename LB >
+        requires ( !( std::same_as< LA, row_major > && std::same_as< LB, row_major > ) )
+    auto operator%( const matrix< T, LA >& a_matrix, const matrix< T, LB >& b_matrix ) -> matrix< T, LA >
+    {
+        if ( a_matrix.ncol( ) != b_matrix.nrow( ) ) throw matrixDimError{"CANNOT MULTIPLY MATRICIES OF INCOMPATIBLE DIMENSIONS"};
+        matrix< T, LA > product;
+        gemm( false, false, T{1}, a_matrix, b_matrix, T{0}, product );
+        return product;
+    }
+
+    /**
+     * @brief matrix-vector product A x
+     */
+    template < SKAS::FlAd T, typename L >
+    auto operator%( const matrix< T, L >& a_matrix, const vect::vect< T >& x_vect ) -> vect::vect< T >
+    {
+        vect::vect< T > product;
+        gemv( false, T{1}, a_matrix, x_vect, T{0}, product );
+        return product;
+    }
+
+    /**
+     * @brief vector-matrix product x^T A, returned as a vect
+     */
+    template < SKAS::FlAd T, typename L >
+    auto operator%( const vect::vect< T >& x_vect, const matrix< T, L >& a_matrix ) -> vect::vect< T >
+    {
+        vect::vect< T > product;
+        gemv( true, T{1}, a_matrix, x_vect, T{0}, product );
+        return product;
+    }
+
+    // column strips of the trailing SYRK update, each computed from its diagonal down
+    inline constexpr size_t syrk_strips = 4;
+
+    /**
+     * @brief copies the rows x cols block at offset of store ( row stride ld ) into the dense row-major stage, or back
+     * from it with to_store, on the device. moves one panel of a device-resident factorization to the host through
+     * stage without touching the rest of store
+     */
+    template < SKAS::FlAd T >
+    auto stage_block( vect::vect< T >& store, const size_t offset, const size_t ld, const size_t rows, const size_t cols, vect::vect< T >& stage, const bool to_store ) -> void
+    {
+        if ( !rows || !cols ) return;
+        if ( to_store )
+        {
+            const T* src = std::as_const( stage ).dev_data( );
+            T* dst = store.dev_data( ) + offset;
+            gpu::ctx( ).q.parallel_for( sycl::range< 2 >( rows, cols ), [=]( sycl::id< 2 > idx ) { dst[ idx[ 0 ] * ld + idx[ 1 ] ] = src[ idx[ 0 ] * cols + idx[ 1 ] ]; } ).wait( );
+            return;
+        }
+        const T* src = std::as_const( store ).dev_data( ) + offset;
+        T* dst = stage.dev_discard( );
+        gpu::ctx( ).q.parallel_for( sycl::range< 2 >( rows, cols ), [=]( sycl::id< 2 > idx ) { dst[ idx[ 0 ] * cols + idx[ 1 ] ] = src[ idx[ 0 ] * ld + idx[ 1 ] ]; } ).wait( );
+    }
+
+    /**
+     * @brief unblocked Cholesky of the nb x nb diagonal block at ( k0, k0 ) of a row-major array with n columns,
+     * lower triangle in place. earlier panels must already have been applied. runs on the host and in kernels
+     * @return 0 on success, otherwise 1 + the first column whose pivot is not positive
+     */
+    template < SKAS::FlAd T >
+    inline auto chol_diag( T* a, const size_t n, const size_t k0, const size_t nb ) -> size_t
+    {
+        for ( size_t j = k0; j < k0 + nb; ++j )
+        {
+            T d = a[ j * n + j ];
+            for ( size_t c = k0; c < j; ++c ) d -= a[ j * n + c ] * a[ j * n + c ];
+            if ( !( d > T{0} ) ) return j + 1;
+            d = std::sqrt( d );
+            a[ j * n + j ] = d;
+            for ( size_t i = j + 1; i < k0 + nb; ++i )
+            {
+                T s = a[ i * n + j ];
+                for ( size_t c = k0; c < j; ++c ) s -= a[ i * n + c ] * a[ j * n + c ];
+                a[ i * n + j ] = s / d;
+            }
+        }
+        return 0;
+    }
+
+    /**
+     * @brief panel solve of row i below a factored diagonal block: row[ k0:k0+nb ] = row[ k0:k0+nb ] L11^-T, in place.
+     * rows are independent, so they are spread over threads or work-items
+     */
+    template < SKAS::FlAd T >
+    inline auto chol_row( T* a, const size_t n, const size_t k0, const size_t nb, const size_t i ) -> void
+    {
+        T* row = a + i * n;
+        for ( size_t j = k0; j < k0 + nb; ++j )
+        {
+            T s = row[ j ];
+            for ( size_t c = k0; c < j; ++c ) s -= row[ c ] * a[ j * n + c ];
+            row[ j ] = s / a[ j * n + j ];
+        }
+    }
+
+    /**
+     * @brief blocked right-looking Cholesky factorization t_matrix = L L^T. each step factors a factor_block wide
+     * diagonal block, solves the panel below it row-parallel, and applies the SYRK update A22 -= L21 L21^T to the
+     * lower trailing matrix as gemms. the whole factorization stays on the device under policy::device; otherwise
+     * the panel runs on host threads and the updates through the host gemm (matmul kind for automatic)
+     * @param t_matrix symmetric positive definite matrix, only its lower triangle is read
+     * @exception matrixDimError thrown for a non-square matrix
+     * @exception solutionError thrown when t_matrix is not positive definite
+     * @return lower triangular L
+     */
+    template < SKAS::FlAd T >
+    auto cholesky( const matrix< T >& t_matrix ) -> matrix< T >
+    {
+        if ( t_matrix.nrow( ) != t_matrix.ncol( ) ) throw matrixDimError{"CANNOT FACTOR NON-SQUARE MATRIX"};
+        const size_t n = t_matrix.nrow( );
+        matrix< T > L( t_matrix );
+        const exec::policy p = gpu::resolve( t_matrix.get_policy( ), gpu::op_kind::matmul, n * n * n / 3 );
+        vect::vect< T >& a = L.storage( );
+
+        size_t info = 0;
+        for ( size_t k0 = 0; k0 < n && !info; k0 += factor_block )
+        {
+            const size_t nb = std::min( factor_block, n - k0 );
+            const size_t below = n - k0 - nb;
+            if ( p == exec::policy::device )
+            {
+                info = accel_matr::PM_cholesky_panel( a, n, k0, nb );
+            }
+            else
+            {
+                T* host = a.data( );
+                info = chol_diag( host, n, k0, nb );
+                if ( !info )
+                {
+                    exec::for_chunks( p, below, 16, [=]( size_t lo, size_t hi ) {
+                        for ( size_t r = lo; r < hi; ++r ) chol_row( host, n, k0, nb, k0 + nb + r );
+                    } );
+                }
+            }
+            if ( info || !below ) continue;
+
+            const size_t strip = std::max( factor_block, ( below + syrk_strips - 1 ) / syrk_strips );
+            for ( size_t c0 = k0 + nb; c0 < n; c0 += strip )
+            {
+                const size_t w = std::min( strip, n - c0 );
+                gemm_block( p, false, true, n - c0, w, nb, T{-1}, a, c0 * n + k0, n, a, c0 * n + k0, n, T{1}, a, c0 * n + c0, n );
+            }
+        }
+        if ( info ) throw solutionError{"MATRIX IS NOT POSITIVE DEFINITE"};
+
+        T* l = a.data( );
+        for ( size_t i = 0; i < n; ++i )
+        {
+            for ( size_t j = i + 1; j < n; ++j ) l[ i * n + j ] = T{0};
+        }
+        return L;
+    }
+
+    /**
+     * @brief substitution for op( A ) X = B over columns [ lo, hi ) of an n-row B with row stride ldb, in place.
+     * A is an n x n triangle with row stride lda, taken to have ones on its diagonal with unit. runs on the host and in kernels
+     */
+    template < SKAS::FlAd T >
+    inline auto trsm_columns( const bool lower, const bool trans, const bool unit, const size_t n, const T* a, const size_t lda, T* b, const size_t ldb, const size_t lo, const size_t hi ) -> void
+    {
+        const bool forward = lower != trans;
+        for ( size_t step = 0; step < n; ++step )
+        {
+            const size_t i = forward ? step : n - 1 - step;
+            T* b_i = b + i * ldb;
+            for ( size_t kk = forward ? 0 : i + 1; kk < ( forward ? i : n ); ++kk )
+            {
+                const T a_ik = trans ? a[ kk * lda + i ] : a[ i * lda + kk ];
+                const T* b_k = b + kk * ldb;
+                SKAS_SIMD
+                for ( size_t c = lo; c < hi; ++c ) b_i[ c ] -= a_ik * b_k[ c ];
+            }
+            if ( unit ) continue;
+            const T diag = a[ i * lda + i ];
+            SKAS_SIMD
+            for ( size_t c = lo; c < hi; ++c ) b_i[ c ] /= diag;
+        }
+    }
+
+    /**
+     * @brief solves op( A ) X = B for triangular A in place of B, where op( A ) is A^T with trans, for all right-hand
+     * sides at once. blocked by factor_block rows of A: each diagonal block is substituted column-parallel (host
+     * threads over column slices, or one work-item per column on the device), then the rows still to be solved are
+     * updated by one gemm against the block just solved (matmul kind for automatic)
+     * @param lower true for lower triangular A, false for upper. the other triangle is not read
+     * @param trans use A^T
+     * @param t_matrix square triangular A. singularity is checked
+     * @param b_matrix right-hand sides, overwritten with the solutions
+     * @param unit take A's diagonal as ones without reading it, as for the L of an LU factorization
+     * @exception matrixDimError thrown for incompatible dimensions
+     * @exception solutionError thrown for a zero on the diagonal
+     */
+    template < SKAS::FlAd T >
+    auto trsm( const bool lower, const bool trans, const matrix< T >& t_matrix, matrix< T >& b_matrix, const bool unit = false ) -> void
+    {
+        const size_t n = t_matrix.nrow( );
+        const size_t k = b_matrix.ncol( );
+        if ( t_matrix.ncol( ) != n || b_matrix.nrow( ) != n ) throw matrixDimError{"CANNOT SOLVE TRIANGULAR SYSTEM OF INCOMPATIBLE DIMENSIONS"};
+        const exec::policy p = gpu::resolve( exec::common( t_matrix.get_policy( ), b_matrix.get_policy( ) ), gpu::op_kind::matmul, n * n * k / 2 );
+        const vect::vect< T >& a_store = t_matrix.storage( );
+        if ( !unit )
+        {
+            // on the device path only the diagonal test comes back to the host, not A
+            if ( p == exec::policy::device )
+            {
+                if ( accel_matr::PM_zero_diagonal( a_store.dev_data( ), n ) ) throw solutionError{"CANNOT SOLVE SINGULAR TRIANGULAR MATRIX"};
+            }
+            else
+            {
+                const T* a = a_store.data( );
+                for ( size_t i = 0; i < n; ++i )
+                {
+                    if ( a[ i * n + i ] == T{0} ) throw solutionError{"CANNOT SOLVE SINGULAR TRIANGULAR MATRIX"};
+                }
+            }
+        }
+        vect::vect< T >& b_store = b_matrix.storage( );
+
+        const bool forward = lower != trans;
+        const size_t blocks = ( n + factor_block - 1 ) / factor_block;
+        for ( size_t blk = 0; blk < blocks; ++blk )
+        {
+            const size_t i0 = ( forward ? blk : blocks - 1 - blk ) * factor_block;
+            const size_t nb = std::min( factor_block, n - i0 );
+            if ( p == exec::policy::device )
+            {
+                accel_matr::PM_trsm_block( lower, trans, unit, nb, a_store.dev_data( ) + i0 * n + i0, n, b_store.dev_data( ) + i0 * k, k, k );
+            }
+            else
+            {
+                const T* a_diag = a_store.data( ) + i0 * n + i0;
+                T* b_rows = b_store.data( ) + i0 * k;
+                exec::for_chunks( p, k, 16, [=]( size_t lo, size_t hi ) {
+                    trsm_columns( lower, trans, unit, nb, a_diag, n, b_rows, k, lo, hi );
+                } );
+            }
+
+            // rows below the block going forward, above it going backward: B_rest -= op( A )[ rest, block ] B_block
+            const size_t rest0 = forward ? i0 + nb : 0;
+            const size_t rest = forward ? n - i0 - nb : i0;
+            if ( !rest || !k ) continue;
+            const size_t a_off = trans ? i0 * n + rest0 : rest0 * n + i0;
+            gemm_block( p, trans, false, rest, k, nb, T{-1}, a_store, a_off, n, b_store, i0 * k, k, T{1}, b_store, rest0 * k, k );
+        }
+    }
+
+    /**
+     * @brief solves Ax = b for lower triangular matrix
+     * @param lower_matrix triangular matrix to solve. singularity is checked.
+     * @param b vector to solve
+     * @return the solution x for Ax = b
+     * @exception solutionError thrown for singularity
+     */
+    template < SKAS::FlAd T >
+    auto forwardsolve( const matrix< T >& lower_matrix, const vect::vect< T >& b ) -> vect::vect< T >
+    {
+        matrix< T > x( b, b.size( ), 1, b.get_policy( ) );
+        trsm( true, false, lower_matrix, x );
+        return x.storage( );
+    }
+
+    /**
+     * @brief solves Ax = b for upper triangular matrix
+     * @param upper_matrix triangular matrix to solve. singularity is checked.
+     * @param b vector to solve
+     * @return the solution x for Ax = b
+     * @exception solutionError thrown for singularity
+     */
+    template < SKAS::FlAd T >
+    auto backsolve( const matrix< T >& upper_matrix, const vect::vect< T >& b ) -> vect::vect< T >
+    {
+        matrix< T > x( b, b.size( ), 1, b.get_policy( ) );
+        trsm( false, false, upper_matrix, x );
+        return x.storage( );
+    }
+
+    /**
+     * @brief inverts triangular matrix
+     * @param t_matrix triangular matrix to invert. singularity is checked.
+     * @param lower true for lower triangular matrix, false for upper
+     * @return the inverse of t_matrix
+     * @exception solutionError thrown for singularity
+     */
+    template < SKAS::FlAd T >
+    auto triangularinvert( const matrix< T >& t_matrix, bool lower ) -> matrix< T >
+    {
+        matrix< T > output = identity_like< T >( t_matrix.nrow( ), t_matrix.get_policy( ) );
+        trsm( lower, false, t_matrix, output );
+        return output;
+    }
+
+    /**
+     * @brief compact Householder QR of an m x n matrix. packed holds R on and above its diagonal and the Householder
+     * vectors below it, each with an implied unit leading entry, so that H_j = I - tau[ j ] v_j v_j^T and
+     * Q = H_0 H_1 ... H_( min( m, n ) - 1 )
+     */
+    template < SKAS::FlAd T >
+    struct qr_factors
+    {
+        matrix< T > packed;
+        vect::vect< T > tau;
+    };
+
+    /**
+     * @brief unblocked Householder QR of an m x nb panel a with row stride n, whose top left entry is the panel's
+     * diagonal, writing its nb reflector scales to tau. reflectors are applied only within the panel
+     */
+    template < SKAS::FlAd T >
+    auto qr_panel( T* a, const size_t n, const size_t m, const size_t nb, T* tau ) -> void
+    {
+        std::array< T, factor_block > w;
+        for ( size_t j = 0; j < nb; ++j )
+        {
+            T sigma = 0;
+            for ( size_t i = j + 1; i < m; ++i ) sigma += a[ i * n + j ] * a[ i * n + j ];
+            if ( sigma == T{0} )
+            {
+                tau[ j ] = T{0};
+                continue;
+            }
+            // H_j maps column j onto beta e_1, with beta's sign opposite the pivot to avoid cancellation
+            const T alpha = a[ j * n + j ];
+            const T norm = std::sqrt( alpha * alpha + sigma );
+            const T beta = std::signbit( alpha ) ? norm : -norm;
+            tau[ j ] = ( beta - alpha ) / beta;
+            const T scale = T{1} / ( alpha - beta );
+            for ( size_t i = j + 1; i < m; ++i ) a[ i * n + j ] *= scale;
+            a[ j * n + j ] = beta;
+
+            // rest of the panel: w = tau * ( v^T A ), A -= v w, swept in row order
+            const size_t c0 = j + 1;
+            const size_t cols = nb - c0;
+            if ( !cols ) continue;
+            for ( size_t c = 0; c < cols; ++c ) w[ c ] = a[ j * n + c0 + c ];
+            for ( size_t i = j + 1; i < m; ++i )
+            {
+                const T v_i = a[ i * n + j ];
+                const T* a_row = a + i * n + c0;
+                SKAS_SIMD
+                for ( size_t c = 0; c < cols; ++c ) w[ c ] += v_i * a_row[ c ];
+            }
+            for ( size_t c = 0; c < cols; ++c )
+            {
+                w[ c ] *= tau[ j ];
+                a[ j * n + c0 + c ] -= w[ c ];
+            }
+            for ( size_t i = j + 1; i < m; ++i )
+            {
+                const T v_i = a[ i * n + j ];
+                T* a_row = a + i * n + c0;
+                SKAS_SIMD
+                for ( size_t c = 0; c < cols; ++c ) a_row[ c ] -= v_i * w[ c ];
+            }
+        }
+    }
+
+    /**
+     * @brief compact WY form H_0 ... H_( nb - 1 ) = I - V T V^T of a factored rows x nb panel a with row stride n and
+     * reflector scales tau. V is copied out dense as a rows x nb row-major block with its unit diagonal and upper zeros
+     * explicit, T is the nb x nb upper triangle. a may be v_block's own values with n = nb
+     */
+    template < SKAS::FlAd T >
+    auto qr_block_reflector( const T* a, const size_t n, const size_t rows, const size_t nb, const T* tau, vect::vect< T >& v_block, vect::vect< T >& t_block ) -> void
+    {
+        T* v = v_block.data( );
+        T* t = t_block.data( );
+        for ( size_t i = 0; i < rows; ++i )
+        {
+            for ( size_t j = 0; j < nb; ++j ) v[ i * nb + j ] = i == j ? T{1} : ( i > j ? a[ i * n + j ] : T{0} );
+        }
+
+        // column j of T: -tau_j T[ 0:j, 0:j ] ( V[ :, 0:j ]^T v_j ), then tau_j on the diagonal
+        std::array< T, factor_block > w;
+        for ( size_t j = 0; j < nb; ++j )
+        {
+            for ( size_t r = 0; r < j; ++r ) w[ r ] = T{0};
+            for ( size_t i = j; i < rows; ++i )
+            {
+                const T v_ij = v[ i * nb + j ];
+                for ( size_t r = 0; r < j; ++r ) w[ r ] += v[ i * nb + r ] * v_ij;
+            }
+            for ( size_t r = 0; r < j; ++r )
+            {
+                T sum = 0;
+                for ( size_t c = r; c < j; ++c ) sum += t[ r * nb + c ] * w[ c ];
+                t[ r * nb + j ] = -tau[ j ] * sum;
+            }
+            t[ j * nb + j ] = tau[ j ];
+            for ( size_t r = j + 1; r < nb; ++r ) t[ r * nb + j ] = T{0};
+        }
+    }
+
+    /**
+     * @brief applies a block reflector H = I - V T V^T, or H^T with trans, to a rows x nc block of c at c_off with
+     * row stride ldc, as the three gemms W = V^T C, W = op( T ) W, C -= V W. w holds 2 * nb * nc scratch values
+     */
+    template < SKAS::FlAd T >
+    auto qr_apply_block( const exec::policy p, const bool trans, const size_t rows, const size_t nb, const vect::vect< T >& v_block, const vect::vect< T >& t_block,
+                         vect::vect< T >& c, const size_t c_off, const size_t ldc, const size_t nc, vect::vect< T >& w ) -> void
+    {
+        if ( !nc ) return;
+        gemm_block( p, true, false, nb, nc, rows, T{1}, v_block, 0, nb, c, c_off, ldc, T{0}, w, 0, nc );
+        gemm_block( p, trans, false, nb, nc, nb, T{1}, t_block, 0, nb, w, 0, nc, T{0}, w, nb * nc, nc );
+        gemm_block( p, false, false, rows, nc, nb, T{-1}, v_block, 0, nb, w, nb * nc, nc, T{1}, c, c_off, ldc );
+    }
+
+    /**
+     * @brief blocked Householder QR in compact form. each panel of factor_block columns is factored on the host, then
+     * applied to the trailing columns as one block reflector through level-3 gemm updates on the host or the device
+     * (matmul kind for automatic). on the device the matrix stays resident and only each panel moves, staged through
+     * v_block
+     * @param t_matrix matrix to decompose
+     * @return qr_factors; Q and R are formed from it only on demand, see qr_apply and qr_r
+     */
+    template < SKAS::FlAd T >
+    auto qr_factor( const matrix< T >& t_matrix ) -> qr_factors< T >
+    {
+        const size_t m = t_matrix.nrow( );
+        const size_t n = t_matrix.ncol( );
+        const size_t r = std::min( m, n );
+        qr_factors< T > f{ t_matrix, vect::vect< T >( r, T{0}, t_matrix.get_policy( ) ) };
+        const exec::policy p = gpu::resolve( t_matrix.get_policy( ), gpu::op_kind::matmul, m * n * r );
+
+        vect::vect< T > v_block( m * factor_block, T{0}, p );
+        vect::vect< T > t_block( factor_block * factor_block, T{0}, p );
+        vect::vect< T > w( 2 * factor_block * n, T{0}, p );
+        const bool device = p == exec::policy::device;
+        vect::vect< T >& a_store = f.packed.storage( );
+        T* tau = f.tau.data( );
+        for ( size_t j0 = 0; j0 < r; j0 += factor_block )
+        {
+            const size_t nb = std::min( factor_block, r - j0 );
+            const size_t rows = m - j0;
+            if ( device ) stage_block( a_store, j0 * n + j0, n, rows, nb, v_block, false );
+            T* panel = device ? v_block.data( ) : a_store.data( ) + j0 * n + j0;
+            const size_t ld = device ? nb : n;
+            qr_panel( panel, ld, rows, nb, tau + j0 );
+            if ( device ) stage_block( a_store, j0 * n + j0, n, rows, nb, v_block, true );
+            const size_t trailing = n - j0 - nb;
+            if ( !trailing ) continue;
+            qr_block_reflector( panel, ld, rows, nb, tau + j0, v_block, t_block );
+            qr_apply_block( p, true, rows, nb, v_block, t_block, a_store, j0 * n + j0 + nb, n, trailing, w );
+        }
+        return f;
+    }
+
+    /**
+     * @brief c_matrix = Q c_matrix, or Q^T c_matrix with trans, for the Q of a compact QR. applied one block reflector
+     * at a time without forming Q
+     * @exception matrixDimError thrown when c_matrix does not have Q's row count
+     */
+    template < SKAS::FlAd T >
+    auto qr_apply( const qr_factors< T >& f, const bool trans, matrix< T >& c_matrix ) -> void
+    {
+        const size_t m = f.packed.nrow( );
+        const size_t r = f.tau.size( );
+        const size_t nc = c_matrix.ncol( );
+        if ( c_matrix.nrow( ) != m ) throw matrixDimError{"CANNOT APPLY Q TO MATRIX OF INCOMPATIBLE DIMENSIONS"};
+        const exec::policy p = gpu::resolve( exec::common( f.packed.get_policy( ), c_matrix.get_policy( ) ), gpu::op_kind::matmul, m * nc * r );
+
+        vect::vect< T > v_block( m * factor_block, T{0}, p );
+        vect::vect< T > t_block( factor_block * factor_block, T{0}, p );
+        vect::vect< T > w( 2 * factor_block * nc, T{0}, p );
+        const size_t n = f.packed.ncol( );
+        const T* a = f.packed.storage( ).data( );
+        const T* tau = f.tau.data( );
+        const size_t blocks = ( r + factor_block - 1 ) / factor_block;
+        for ( size_t b = 0; b < blocks; ++b )
+        {
+            // Q^T = ... H_1^T H_0^T takes the panels first to last, Q the reverse
+            const size_t j0 = ( trans ? b : blocks - 1 - b ) * factor_block;
+            const size_t nb = std::min( factor_block, r - j0 );
+            qr_block_reflector( a + j0 * n + j0, n, m - j0, nb, tau + j0, v_block, t_block );
+            qr_apply_block( p, trans, m - j0, nb, v_block, t_block, c_matrix.storage( ), j0 * nc, nc, nc, w );
+        }
+    }
+
+    /**
+     * @brief the m x n upper triangular R of a compact QR
+     */
+    template < SKAS::FlAd T >
+    auto qr_r( const qr_factors< T >& f ) -> matrix< T >
+    {
+        matrix< T > R( f.packed );
+        const size_t n = R.ncol( );
+        T* r = R.storage( ).data( );
+        for ( size_t i = 1; i < R.nrow( ); ++i )
+        {
+            for ( size_t j = 0; j < std::min( i, n ); ++j ) r[ i * n + j ] = T{0};
+        }
+        return R;
+    }
+
+    /**
+     * @brief QR decomposition of matrix
+     * @param t_matrix matrix to decompose
+     * @return vector of two matricies: Q, R; where t_matrix = QR
+     */
+    template < SKAS::FlAd T >
+    auto qr_decomp( const matrix< T >& t_matrix ) -> std::vector< matrix< T > >
+    {
+        const auto f = qr_factor( t_matrix );
+        std::vector< matrix< T > > QR( 2 );
+        QR[ 0 ] = identity< T >( t_matrix.nrow( ) );
+        QR[ 0 ].set_policy( t_matrix.get_policy( ) );
+        qr_apply( f, false, QR[ 0 ] );
+        QR[ 1 ] = qr_r( f );
+        return QR;
+    }
+
+    /**
+     * @brief LU factorization P A = L U of a square matrix with partial pivoting. packed holds U on and above its
+     * diagonal and the multipliers of the unit lower triangular L below it; row j was swapped with pivots[ j ] at step j.
+     * singular is set when a column had no nonzero pivot, in which case U has a zero on its diagonal
+     */
+    template < SKAS::FlAd T >
+    struct lu_factors
+    {
+        matrix< T > packed;
+        std::vector< size_t > pivots;
+        bool singular = false;
+    };
+
+    /**
+     * @brief unblocked LU with partial pivoting of a rows x nb panel a with row stride n, whose top left entry is the
+     * panel's diagonal. pivots[ j ] receives the panel row swapped with row j. a swap exchanges width columns of both
+     * rows starting swap_lo columns left of the panel, so a host-resident matrix swaps its rows whole and a staged panel
+     * only its own columns; eliminations stay within the panel
+     * @return true when a column had no nonzero pivot
+     */
+    template < SKAS::FlAd T >
+    auto lu_panel( const exec::policy p, T* a, const size_t n, const size_t rows, const size_t nb, const size_t swap_lo, const size_t width, size_t* pivots ) -> bool
+    {
+        bool singular = false;
+        for ( size_t j = 0; j < nb; ++j )
+        {
+            size_t pivot = j;
+            for ( size_t i = j + 1; i < rows; ++i )
             {
-                sum += lower_matrix.getelem( m, i ) * x[ i ];
-            } 
-            if ( !lower_matrix.getelem( m, m ) )
+                if ( std::abs( a[ i * n + j ] ) > std::abs( a[ pivot * n + j ] ) ) pivot = i;
+            }
+            pivots[ j ] = pivot;
+            if ( pivot != j ) std::swap_ranges( a + j * n - swap_lo, a + j * n - swap_lo + width, a + pivot * n - swap_lo );
+            const T diag = a[ j * n + j ];
+            if ( diag == T{0} )
             {
-                throw solutionError{"CANNOT SOLVE LOWER TRIANGULAR MATRIX"};
+                singular = true;
+                continue;
             }
-            x.push_back( ( b[ m ] - sum ) / lower_matrix.getelem( m, m ) );
+
+            const size_t c0 = j + 1;
+            const size_t cols = nb - c0;
+            const T* u_row = a + j * n + c0;
+            exec::for_chunks( p, rows - j - 1, 64, [=]( size_t lo, size_t hi ) {
+                for ( size_t i = j + 1 + lo; i < j + 1 + hi; ++i )
+                {
+                    T* a_row = a + i * n;
+                    const T l = a_row[ j ] /= diag;
+                    SKAS_SIMD
+                    for ( size_t c = 0; c < cols; ++c ) a_row[ c0 + c ] -= l * u_row[ c ];
+                }
+            } );
         }
-        return x;
+        return singular;
     }
 
     /**
-     * @brief solves Ax = b for upper triangular matrix
-     * @param upper_matrix triangular matrix to solve. singularity is checked.
-     * @param b vector to solve
-     * @return the solution x for Ax = b
-     * @exception solutionError thrown for singularity
+     * @brief blocked right-looking LU with partial pivoting ( getrf ). each factor_block wide panel is factored on the
+     * host, the block row of U right of it is solved against the panel's unit lower triangle, and the trailing matrix
+     * takes the rank-nb update A22 -= L21 U12 as one gemm on the host or the device (matmul kind for automatic). on the
+     * device the matrix stays resident: only the panel is staged to the host, and the row swaps outside it and U12 are
+     * applied by kernels
+     * @param t_matrix square matrix to factor
+     * @exception matrixDimError thrown for a non-square matrix
+     * @return lu_factors; check singular before solving with it
      */
     template < SKAS::FlAd T >
-    auto backsolve( const matrix< T >& upper_matrix, const vect::vect< T >& b ) -> vect::vect< T >
+    auto lu_factor( const matrix< T >& t_matrix ) -> lu_factors< T >
     {
-        vect::vect< T > x(b.size());
-        T sum = 0;
-        for ( int m = b.size( ) - 1; m >= 0; --m )
+        if ( t_matrix.nrow( ) != t_matrix.ncol( ) ) throw matrixDimError{"CANNOT FACTOR NON-SQUARE MATRIX"};
+        const size_t n = t_matrix.nrow( );
+        lu_factors< T > f{ t_matrix, std::vector< size_t >( n ) };
+        const exec::policy p = gpu::resolve( t_matrix.get_policy( ), gpu::op_kind::matmul, 2 * n * n * n / 3 );
+        const bool device = p == exec::policy::device;
+        const exec::policy host = device ? exec::policy::simd : p;
+        vect::vect< T >& a_store = f.packed.storage( );
+        vect::vect< T > stage( device ? n * factor_block : 0, T{0}, p );
+        std::array< size_t, factor_block > pivots;
+
+        for ( size_t k0 = 0; k0 < n; k0 += factor_block )
         {
-            sum = 0;
-            for ( int i = b.size( ) - 1; i > m; --i )
+            const size_t nb = std::min( factor_block, n - k0 );
+            const size_t rows = n - k0;
+            const size_t trailing = n - k0 - nb;
+            if ( device ) stage_block( a_store, k0 * n + k0, n, rows, nb, stage, false );
+            T* panel = device ? stage.data( ) : a_store.data( ) + k0 * n + k0;
+            const bool singular = device ? lu_panel( host, panel, nb, rows, nb, 0, nb, pivots.data( ) )
+                                         : lu_panel( host, panel, n, rows, nb, k0, n, pivots.data( ) );
+            f.singular = f.singular || singular;
+            for ( size_t j = 0; j < nb; ++j ) f.pivots[ k0 + j ] = k0 + pivots[ j ];
+            if ( device )
             {
-                sum += upper_matrix.getelem( m, i ) * x[ i ];
+                stage_block( a_store, k0 * n + k0, n, rows, nb, stage, true );
+                accel_matr::PM_lu_swap_rows( a_store.dev_data( ), n, k0, nb, pivots );
             }
-            if ( !upper_matrix.getelem( m, m ) ) throw solutionError{"CANNOT SOLVE LOWER TRIANGULAR MATRIX"};
-            x[m]=( ( b[ m ] - sum ) / upper_matrix.getelem( m, m ) );
+            if ( !trailing ) continue;
+
+            // U12 = L11^-1 A12, swept row by row over column slices
+            if ( device )
+            {
+                T* dev_a = a_store.dev_data( );
+                accel_matr::PM_trsm_block( true, false, true, nb, dev_a + k0 * n + k0, n, dev_a + k0 * n + k0 + nb, n, trailing );
+                gemm_block( p, false, false, trailing, trailing, nb, T{-1}, a_store, ( k0 + nb ) * n + k0, n, a_store, k0 * n + k0 + nb, n,
+                            T{1}, a_store, ( k0 + nb ) * n + k0 + nb, n );
+                continue;
+            }
+            T* a = a_store.data( );
+            exec::for_chunks( host, trailing, 256, [=]( size_t lo, size_t hi ) {
+                for ( size_t j = k0; j < k0 + nb; ++j )
+                {
+                    const T* u_row = a + j * n + k0 + nb;
+                    for ( size_t i = j + 1; i < k0 + nb; ++i )
+                    {
+                        const T l = a[ i * n + j ];
+                        T* a_row = a + i * n + k0 + nb;
+                        SKAS_SIMD
+                        for ( size_t c = lo; c < hi; ++c ) a_row[ c ] -= l * u_row[ c ];
+                    }
+                }
+            } );
+            gemm_block( p, false, false, trailing, trailing, nb, T{-1}, a_store, ( k0 + nb ) * n + k0, n, a_store, k0 * n + k0 + nb, n,
+                        T{1}, a_store, ( k0 + nb ) * n + k0 + nb, n );
         }
-        return x;
+        return f;
     }
 
     /**
-     * @brief inverts triangular matrix
-     * @param t_matrix triangular matrix to invert. singularity is checked.
-     * @param lower true for lower triangular matrix, false for upper
-     * @return the inverse of t_matrix
-     * @exception solutionError thrown for singularity
+     * @brief Cholesky factorization A = L L^T of a symmetric positive definite matrix. factor once, then solve for
+     * any number of right-hand sides with two triangular solves each
      */
+    template < SKAS::FlAd T >
+    class cholesky_factorization
+    {
+        private:
+        matrix< T > L;
+
+        public:
+        explicit cholesky_factorization( const matrix< T >& a_matrix ) : L( cholesky( a_matrix ) ) { }
+
+        /**
+         * @brief X with A X = B
+         * @exception matrixDimError thrown for a mis-sized right-hand side
+         */
+        auto solve( const matrix< T >& b_matrix ) const -> matrix< T >
+        {
+            matrix< T > x( b_matrix );
+            trsm( true, false, L, x );
+            trsm( true, true, L, x );
+            return x;
+        }
+
+        auto solve( const vect::vect< T >& b ) const -> vect::vect< T >
+        {
+            return solve( matrix< T >( b, b.size( ), 1, b.get_policy( ) ) ).storage( );
+        }
+
+        auto inverse( ) const -> matrix< T >
+        {
+            return solve( identity_like< T >( L.nrow( ), L.get_policy( ) ) );
+        }
 
-    // ====================================================== unchanged
+        /**
+         * @brief the lower triangular factor L
+         */
+        auto factor( ) const -> const matrix< T >&
+        {
+            return L;
+        }
+    };
+
+    /**
+     * @brief Householder QR factorization A = QR of an m x n matrix with m >= n, kept in compact form. factor once,
+     * then solve for any number of right-hand sides: least squares for tall A, exact for square A
+     */
     template < SKAS::FlAd T >
-    auto triangularinvert( const matrix< T >& t_matrix, bool lower ) -> matrix< T >
+    class qr_factorization
     {
-        matrix< T > output;
-        vect::vect< T > e( size_t{t_matrix.nrow( )}, T{0} );
-        if ( lower )
+        private:
+        qr_factors< T > f;
+        matrix< T > R; // leading n x n block of R
+
+        static auto checked( const matrix< T >& a_matrix ) -> const matrix< T >&
+        {
+            if ( a_matrix.nrow( ) < a_matrix.ncol( ) ) throw matrixDimError{"CANNOT SOLVE UNDERDETERMINED SYSTEM WITH QR"};
+            return a_matrix;
+        }
+
+        public:
+        explicit qr_factorization( const matrix< T >& a_matrix ) : f( qr_factor( checked( a_matrix ) ) ), R( T{0}, a_matrix.ncol( ), a_matrix.ncol( ), a_matrix.get_policy( ) )
         {
-            for ( int j = 0; j < t_matrix.ncol( ); ++j )
+            const size_t n = R.ncol( );
+            const T* packed = f.packed.storage( ).data( );
+            T* r = R.storage( ).data( );
+            for ( size_t i = 0; i < n; ++i )
             {
-                e[ j ] = 1;
-                output.appendcol( forwardsolve( t_matrix, e ) );
-                e[ j ] = 0;
+                for ( size_t j = i; j < n; ++j ) r[ i * n + j ] = packed[ i * n + j ];
             }
         }
-        if ( !lower )
+
+        /**
+         * @brief X minimizing || A X - B ||, from R X = ( Q^T B )[ 0:n ]
+         * @exception matrixDimError thrown for a mis-sized right-hand side
+         * @exception solutionError thrown when A is rank deficient
+         */
+        auto solve( const matrix< T >& b_matrix ) const -> matrix< T >
         {
-            for ( int j = t_matrix.ncol( ) - 1; j >= 0; --j )
+            const size_t n = R.ncol( );
+            const size_t k = b_matrix.ncol( );
+            matrix< T > qtb( b_matrix );
+            qr_apply( f, true, qtb );
+            if ( qtb.nrow( ) == n )
             {
-                e[ j ] = 1;
-                auto next = backsolve( t_matrix, e );
-                output.insertcol( next, 0 );
-                e[ j ] = 0;
+                trsm( false, false, R, qtb );
+                return qtb;
             }
+            const T* top = qtb.storage( ).data( );
+            matrix< T > x( vect::vect< T >( std::vector< T >( top, top + n * k ), b_matrix.get_policy( ) ), n, k, b_matrix.get_policy( ) );
+            trsm( false, false, R, x );
+            return x;
         }
-        return output;
+
+        auto solve( const vect::vect< T >& b ) const -> vect::vect< T >
+        {
+            return solve( matrix< T >( b, b.size( ), 1, b.get_policy( ) ) ).storage( );
+        }
+
+        /**
+         * @exception matrixDimError thrown for a non-square A
+         */
+        auto inverse( ) const -> matrix< T >
+        {
+            if ( f.packed.nrow( ) != f.packed.ncol( ) ) throw matrixDimError{"CANNOT INVERT NON-SQUARE MATRIX"};
+            return solve( identity_like< T >( R.nrow( ), R.get_policy( ) ) );
+        }
+
+        /**
+         * @brief the compact factors, see qr_apply and qr_r
+         */
+        auto factors( ) const -> const qr_factors< T >&
+        {
+            return f;
+        }
+    };
+
+    /**
+     * @brief LU factorization P A = L U of a square matrix with partial pivoting. factor once, then solve for any
+     * number of right-hand sides by a row permutation and two triangular solves each
+     */
+    template < SKAS::FlAd T >
+    class lu_factorization
+    {
+        private:
+        lu_factors< T > f;
+
+        public:
+        explicit lu_factorization( const matrix< T >& a_matrix ) : f( lu_factor( a_matrix ) ) { }
+
+        /**
+         * @brief X with A X = B
+         * @exception matrixDimError thrown for a mis-sized right-hand side
+         * @exception solutionError thrown when A is singular
+         */
+        auto solve( const matrix< T >& b_matrix ) const -> matrix< T >
+        {
+            const size_t n = f.packed.nrow( );
+            if ( f.singular ) throw solutionError{"NON-INVERTIBLE MATRIX CANNOT BE SOLVED"};
+            if ( b_matrix.nrow( ) != n ) throw matrixDimError{"CANNOT SOLVE SYSTEM OF INCOMPATIBLE DIMENSIONS"};
+            matrix< T > x( b_matrix );
+            const size_t k = x.ncol( );
+            T* b = x.storage( ).data( );
+            for ( size_t j = 0; j < n; ++j )
+            {
+                if ( f.pivots[ j ] != j ) std::swap_ranges( b + j * k, b + j * k + k, b + f.pivots[ j ] * k );
+            }
+            trsm( true, false, f.packed, x, true );
+            trsm( false, false, f.packed, x );
+            return x;
+        }
+
+        auto solve( const vect::vect< T >& b ) const -> vect::vect< T >
+        {
+            return solve( matrix< T >( b, b.size( ), 1, b.get_policy( ) ) ).storage( );
+        }
+
+        auto inverse( ) const -> matrix< T >
+        {
+            return solve( identity_like< T >( f.packed.nrow( ), f.packed.get_policy( ) ) );
+        }
+
+        /**
+         * @brief determinant, the product of U's diagonal signed by the parity of the row interchanges
+         */
+        auto det( ) const -> T
+        {
+            const size_t n = f.packed.nrow( );
+            const T* u = f.packed.storage( ).data( );
+            T out = T{1};
+            for ( size_t j = 0; j < n; ++j ) out *= f.pivots[ j ] != j ? -u[ j * n + j ] : u[ j * n + j ];
+            return out;
+        }
+
+        /**
+         * @brief the packed factors and pivots
+         */
+        auto factors( ) const -> const lu_factors< T >&
+        {
+            return f;
+        }
+    };
+
+    /**
+     * @brief determinant of a square matrix through its LU factorization
+     * @exception matrixDimError thrown for a non-square matrix
+     */
+    template < SKAS::FlAd T >
+    auto det( const matrix< T >& a_matrix ) -> T
+    {
+        return lu_factorization< T >( a_matrix ).det( );
     }
 
     /**
-     * @brief QR decomposition of matrix
-     * @param t_matrix matrix to decompose
-     * @exception solutionError thrown for singularity
-     * @return vector of two matricies: Q, R; where t_matrix = QR
+     * @brief solves A X = B without forming an inverse. keep a factorization object instead when A is reused
+     * @param a_matrix system matrix
+     * @param b right-hand side, a matrix or a vect
+     * @param type std::string. "lu" (square A), "qr" (least squares for tall A) or "spd"
+     * @exception matrixDimError thrown for incompatible dimensions
+     * @exception solutionError thrown for singularity or an incorrect type
      */
+    template < SKAS::FlAd T, typename B >
+    requires std::same_as< B, matrix< T > > || std::same_as< B, vect::vect< T > >
+    auto solve( const matrix< T >& a_matrix, const B& b, std::string type = "lu" ) -> B
+    {
+        if ( type == "lu" ) return lu_factorization< T >( a_matrix ).solve( b );
+        if ( type == "spd" ) return cholesky_factorization< T >( a_matrix ).solve( b );
+        if ( type == "qr" ) return qr_factorization< T >( a_matrix ).solve( b );
+        throw solutionError{"INCORRECT TYPE PARAMETER"};
+    }
+
+    // spd inversion
     template < SKAS::FlAd T >
-    auto qr_decomp( const matrix< T >& t_matrix ) -> std::vector< matrix< T > >
+    auto spd( const matrix< T >& a_matrix ) -> matrix< T >
     {
-        std::vector< matrix< T > > container;
-        qr_dive( t_matrix, 0, container );
-        std::vector< matrix< T > > QR( 2 );
-        matrix R = container[ container.size( ) - 1 ];
-        for ( int prod_i = container.size( ) - 2; prod_i >= 0; --prod_i )
+        //checking for user issues or edge cases
+        if ( a_matrix.ncol( ) != a_matrix.nrow( ) )
         {
-            R = R % container[ prod_i ];
+            throw matrixDimError{"CANNOT INVERT NON-SQUARE MATRICIES UNDER SPD PARAMETER"};
         }
-        matrix Qt = R;
-        R = R % t_matrix;
-        QR[ 0 ] = Qt.t( );
-        QR[ 1 ] = R;
-        return QR;
+        if ( !a_matrix.ncol( ) )
+        {
+            return a_matrix;
+        }
+        return cholesky_factorization< T >( a_matrix ).inverse( );
     }
 
     /**
-     * @brief Recursive utility for qr_decomp
+     * @brief matrix inversion. this function is expensive; save copy if needed in repetition, or keep an
+     * lu_factorization / cholesky_factorization / qr_factorization and solve( ) with it when only products with the inverse are needed.
+     * @param a_matrix matrix to invert
+     * @param type std::string. type of matrix: "lu" (general square, default), "qr" or "spd" (symmetric positive definite)
+     * @exception matrixDimError if non-square
+     * @exception solutionError if singularity detected
+     * @return matrix
      */
     template < SKAS::FlAd T >
-    auto qr_dive( const matrix< T >& t_matrix, unsigned int pivot, std::vector< matrix< T > >& container ) -> void
+    auto invert( const matrix< T >& a_matrix, std::string type = "lu" ) -> matrix< T >
     {
-        vect::vect< T > ae( t_matrix.nrow( ), T{0}, false );
-        int sign = !std::signbit( t_matrix.getelem( 0, 0 ) );
-        ae[ 0 ] = ( -2*sign + 1 ) * mag( t_matrix.getcol( 0 ) );
-        matrix< T > v;
-        v.appendcol( makeunit( t_matrix.getcol( 0 ) - ae ) );
-        matrix< T > Q = identity< T >( v.nrow( ) ) - ( T{2.0} * ( v % v.t( ) ) );    
-        matrix< T > Q_p( 0, pivot + Q.nrow( ), pivot + Q.ncol( ) );
-        for ( int i_index = 0; i_index < pivot; ++i_index )
+        if ( type == "lu" )
         {
-            Q_p.setelem( 1, i_index, i_index );
+            return lu_factorization< T >( a_matrix ).inverse( );
         }
-        for ( int q_nindex = 0; q_nindex < Q.nrow( ); ++q_nindex )
+        if ( type == "spd" )
         {
-            for ( int q_mindex = 0; q_mindex < Q.ncol( ); ++q_mindex )
-            {
-                Q_p.setelem( Q.getelem( q_nindex, q_mindex ), q_nindex + pivot, q_mindex + pivot );
-            }
+            return spd( a_matrix );
         }
-        Q = Q % t_matrix;
-        Q.dropcol( 0 );
-        if ( !Q.ncol( ) )
+        if ( type == "qr" )
         {
-            container.push_back( Q_p );
+            return qr_factorization< T >( a_matrix ).inverse( );
         }
         else
         {
-            Q.droprow( 0 );
-            container.push_back( Q_p );
-            qr_dive( Q, ++pivot, container );
+            throw solutionError{"INCORRECT TYPE PARAMETER"};
         }
     }
 
@@ -944,83 +2575,355 @@ namespace SKAS::matrix::accel_matr
     auto PM_mul( const SKAS::matrix::matrix< T1 >& a_matrix, const SKAS::matrix::matrix< T1 >& b_matrix ) -> SKAS::matrix::matrix< T1 >;
     */
 
+    template < SKAS::FlAd T1 >
+    auto PM_scale_async( const SKAS::matrix::matrix< T1 >& t_matrix, T1 scalar, const std::vector< sycl::event >& deps ) -> gpu::pending< SKAS::matrix::matrix< T1 > >
+    {
+        auto out = std::make_shared< matrix< T1 > >( T1{0}, t_matrix.nrow( ), t_matrix.ncol( ), t_matrix.get_policy( ) );
+        sycl::event ev = SKAS::vect::accel_vect::PV_scale_into( t_matrix.storage( ), scalar, out->storage( ), deps );
+        return gpu::pending< matrix< T1 > >( ev, out );
+    }
+
     template < SKAS::FlAd T1 >
     auto PM_scale( const SKAS::matrix::matrix< T1 >& t_matrix, T1 scalar ) -> SKAS::matrix::matrix< T1 >
     {
-        matrix< T1 > out(SKAS::vect::accel_vect::PV_scale( t_matrix.getinterior(), scalar ), t_matrix.nrow( ), t_matrix.ncol( ), true ); 
+        matrix< T1 > out( T1{0}, t_matrix.nrow( ), t_matrix.ncol( ), t_matrix.get_policy( ) );
+        SKAS::vect::accel_vect::PV_scale_into( t_matrix.storage( ), scalar, out.storage( ), { } ).wait( );
         return out;
     }
 
+    template < SKAS::FlAd T1 >
+    auto PM_add_async( const SKAS::matrix::matrix< T1 >& a_matrix, const SKAS::matrix::matrix< T1 >& b_matrix, const std::vector< sycl::event >& deps ) -> gpu::pending< SKAS::matrix::matrix< T1 > >
+    {
+        auto out = std::make_shared< matrix< T1 > >( T1{0}, a_matrix.nrow( ), a_matrix.ncol( ), exec::common( a_matrix.get_policy( ), b_matrix.get_policy( ) ) );
+        sycl::event ev = SKAS::vect::accel_vect::PV_add_into( a_matrix.storage( ), b_matrix.storage( ), out->storage( ), deps );
+        return gpu::pending< matrix< T1 > >( ev, out );
+    }
+
     template < SKAS::FlAd T1 >
     auto PM_add( const SKAS::matrix::matrix< T1 >& a_matrix, const SKAS::matrix::matrix< T1 >& b_matrix ) -> SKAS::matrix::matrix< T1 >
     {
-        matrix< T1 > out(
-            SKAS::vect::accel_vect::PV_add( a_matrix.getinterior(), b_matrix.getinterior() ),
-            a_matrix.nrow(),
-            b_matrix.ncol(),
-            true
-        );
+        matrix< T1 > out( T1{0}, a_matrix.nrow( ), a_matrix.ncol( ), exec::common( a_matrix.get_policy( ), b_matrix.get_policy( ) ) );
+        SKAS::vect::accel_vect::PV_add_into( a_matrix.storage( ), b_matrix.storage( ), out.storage( ), { } ).wait( );
         return out;
     }
 
+    template < SKAS::FlAd T1 >
+    auto PM_sub_async( const SKAS::matrix::matrix< T1 >& a_matrix, const SKAS::matrix::matrix< T1 >& b_matrix, const std::vector< sycl::event >& deps ) -> gpu::pending< SKAS::matrix::matrix< T1 > >
+    {
+        auto out = std::make_shared< matrix< T1 > >( T1{0}, a_matrix.nrow( ), a_matrix.ncol( ), exec::common( a_matrix.get_policy( ), b_matrix.get_policy( ) ) );
+        sycl::event ev = SKAS::vect::accel_vect::PV_sub_into( a_matrix.storage( ), b_matrix.storage( ), out->storage( ), deps );
+        return gpu::pending< matrix< T1 > >( ev, out );
+    }
+
     template < SKAS::FlAd T1 >
     auto PM_sub( const SKAS::matrix::matrix< T1 >& a_matrix, const SKAS::matrix::matrix< T1 >& b_matrix ) -> SKAS::matrix::matrix< T1 >
     {
-        matrix< T1 > out(
-            SKAS::vect::accel_vect::PV_sub( a_matrix.getinterior(), b_matrix.getinterior() ),
-            a_matrix.nrow(),
-            b_matrix.ncol(),
-            true
-        );
+        matrix< T1 > out( T1{0}, a_matrix.nrow( ), a_matrix.ncol( ), exec::common( a_matrix.get_policy( ), b_matrix.get_policy( ) ) );
+        SKAS::vect::accel_vect::PV_sub_into( a_matrix.storage( ), b_matrix.storage( ), out.storage( ), { } ).wait( );
         return out;
     }
 
-    template < SKAS::FlAd T1 >
-    auto PM_mul( const SKAS::matrix::matrix< T1 >& a_matrix, const SKAS::matrix::matrix< T1 >& b_matrix ) -> SKAS::matrix::matrix< T1 >
+    /**
+     * @brief work-group tiling of the device GEMM. a WG_M x WG_N work-group computes a BM x BN block of C,
+     * each work-item holding an RM x RN register sub-tile, while BK-deep slices of A and B are staged in
+     * local memory. specialize to retune for a device
+     */
+    template < SKAS::FlAd T >
+    struct gemm_tiling;
+
+    template < >
+    struct gemm_tiling< float >
+    {
+        static constexpr size_t WG_M = 16;
+        static constexpr size_t WG_N = 16;
+        static constexpr size_t RM = 4;
+        static constexpr size_t RN = 4;
+        static constexpr size_t BK = 16;
+    };
+
+    template < >
+    struct gemm_tiling< double >
+    {
+        static constexpr size_t WG_M = 16;
+        static constexpr size_t WG_N = 16;
+        static constexpr size_t RM = 2;
+        static constexpr size_t RN = 4;
+        static constexpr size_t BK = 16;
+    };
+
+    /**
+     * @brief C = alpha * op( A ) * op( B ) + beta * C on gpu::ctx( ).q over row-major device arrays, where op( X )
+     * is X or its transpose. C is m x n, op( A ) m x k and op( B ) k x n. operands are read in their stored
+     * layout; beta == 0 overwrites C without reading it
+     */
+    template < SKAS::FlAd T >
+    auto gemm_tiled( const bool trans_a, const bool trans_b, const size_t m, const size_t n, const size_t k,
+                     const T alpha, const T* dev_a, const size_t lda, const T* dev_b, const size_t ldb,
+                     const T beta, T* dev_c, const size_t ldc, const std::vector< sycl::event >& deps ) -> sycl::event
     {
-        auto bt = b_matrix.t();
+        using tiling = gemm_tiling< T >;
+        constexpr size_t WG_M = tiling::WG_M;
+        constexpr size_t WG_N = tiling::WG_N;
+        constexpr size_t RM = tiling::RM;
+        constexpr size_t RN = tiling::RN;
+        constexpr size_t BK = tiling::BK;
+        constexpr size_t BM = WG_M * RM;
+        constexpr size_t BN = WG_N * RN;
+        constexpr size_t threads = WG_M * WG_N;
 
         sycl::queue& q = gpu::ctx( ).q;
+        if ( !m || !n ) return q.submit( [&]( sycl::handler& h ) { h.depends_on( deps ); h.single_task( [=]( ) { } ); } );
+
+        const size_t groups_m = ( m + BM - 1 ) / BM;
+        const size_t groups_n = ( n + BN - 1 ) / BN;
+
+        return q.submit( [&]( sycl::handler& h ) {
+            h.depends_on( deps );
+            sycl::local_accessor< T, 1 > a_tile( sycl::range< 1 >( BM * BK ), h );
+            sycl::local_accessor< T, 1 > b_tile( sycl::range< 1 >( BK * BN ), h );
+            h.parallel_for( sycl::nd_range< 2 >( sycl::range< 2 >( groups_m * WG_M, groups_n * WG_N ), sycl::range< 2 >( WG_M, WG_N ) ),
+                [=]( sycl::nd_item< 2 > it ) {
+                const size_t ly = it.get_local_id( 0 );
+                const size_t lx = it.get_local_id( 1 );
+                const size_t lid = ly * WG_N + lx;
+                const size_t row0 = it.get_group( 0 ) * BM;
+                const size_t col0 = it.get_group( 1 ) * BN;
+
+                T acc[ RM ][ RN ];
+                for ( size_t i = 0; i < RM; ++i )
+                    for ( size_t j = 0; j < RN; ++j ) acc[ i ][ j ] = 0;
+
+                for ( size_t k0 = 0; k0 < k; k0 += BK )
+                {
+                    // cooperative, bounds-checked staging of op( A )[ row0:+BM, k0:+BK ] and op( B )[ k0:+BK, col0:+BN ]
+                    for ( size_t e = lid; e < BM * BK; e += threads )
+                    {
+                        const size_t r = row0 + e / BK;
+                        const size_t d = k0 + e % BK;
+                        a_tile[ e ] = ( r < m && d < k ) ? ( trans_a ? dev_a[ d * lda + r ] : dev_a[ r * lda + d ] ) : T{0};
+                    }
+                    for ( size_t e = lid; e < BK * BN; e += threads )
+                    {
+                        const size_t d = k0 + e / BN;
+                        const size_t c = col0 + e % BN;
+                        b_tile[ e ] = ( d < k && c < n ) ? ( trans_b ? dev_b[ c * ldb + d ] : dev_b[ d * ldb + c ] ) : T{0};
+                    }
+                    sycl::group_barrier( it.get_group( ) );
+
+                    for ( size_t kk = 0; kk < BK; ++kk )
+                    {
+                        T a_reg[ RM ];
+                        T b_reg[ RN ];
+                        for ( size_t i = 0; i < RM; ++i ) a_reg[ i ] = a_tile[ ( ly + i * WG_M ) * BK + kk ];
+                        for ( size_t j = 0; j < RN; ++j ) b_reg[ j ] = b_tile[ kk * BN + lx + j * WG_N ];
+                        for ( size_t i = 0; i < RM; ++i )
+                            for ( size_t j = 0; j < RN; ++j ) acc[ i ][ j ] += a_reg[ i ] * b_reg[ j ];
+                    }
+                    sycl::group_barrier( it.get_group( ) );
+                }
 
-        int adimn = a_matrix.nrow();
-        int adimm = a_matrix.ncol();
-        int bdimn = b_matrix.nrow();
-        int bdimm = b_matrix.ncol();
+                for ( size_t i = 0; i < RM; ++i )
+                {
+                    const size_t r = row0 + ly + i * WG_M;
+                    if ( r >= m ) continue;
+                    for ( size_t j = 0; j < RN; ++j )
+                    {
+                        const size_t c = col0 + lx + j * WG_N;
+                        if ( c >= n ) continue;
+                        T* out = dev_c + r * ldc + c;
+                        *out = beta == T{0} ? alpha * acc[ i ][ j ] : alpha * acc[ i ][ j ] + beta * *out;
+                    }
+                }
+            } );
+        } );
+    }
 
-        T1* dev_a = sycl::malloc_device< T1 >( adimm*adimn, q );
-        T1* dev_b = sycl::malloc_device< T1 >( bdimm*bdimn, q );
-        T1* dev_c = sycl::malloc_device< T1 >( adimn*bdimm, q );
+    /**
+     * @brief c = a % b on the device. c must already be a.nrow( ) by b.ncol( )
+     */
+    template < SKAS::FlAd T1 >
+    auto PM_mul_into( const SKAS::matrix::matrix< T1 >& a_matrix, const SKAS::matrix::matrix< T1 >& b_matrix, SKAS::matrix::matrix< T1 >& c_matrix, const std::vector< sycl::event >& deps ) -> sycl::event
+    {
+        if ( a_matrix.ncol( ) != b_matrix.nrow( ) || c_matrix.nrow( ) != a_matrix.nrow( ) || c_matrix.ncol( ) != b_matrix.ncol( ) )
+        {
+            throw matrixDimError{"CANNOT MULTIPLY MATRICIES OF INCOMPATIBLE DIMENSIONS"};
+        }
+        const T1* dev_a = a_matrix.storage( ).dev_data( );
+        const T1* dev_b = b_matrix.storage( ).dev_data( );
+        T1* dev_c = c_matrix.storage( ).dev_discard( );
 
+        return gemm_tiled< T1 >( false, false, a_matrix.nrow( ), b_matrix.ncol( ), a_matrix.ncol( ),
+                                 T1{1}, dev_a, a_matrix.ncol( ), dev_b, b_matrix.ncol( ), T1{0}, dev_c, c_matrix.ncol( ), deps );
+    }
 
-        q.memcpy( dev_a, a_matrix.getinterior().data( ), sizeof( T1 ) * adimm*adimn );
-        q.memcpy( dev_b, bt.getinterior().data( ), sizeof( T1 ) * bdimm*bdimn );
+    /**
+     * @brief y = alpha * op( a ) % x + beta * y on the device, see SKAS::matrix::gemv. y must already have op( a )'s row count.
+     * the plain form gives each row a work-group that tree-reduces it in local memory; the transposed form gives each
+     * column a work-item walking down it, so neighbouring work-items read neighbouring elements of every row
+     */
+    template < SKAS::FlAd T1 >
+    auto PM_gemv_into( const bool trans, const T1 alpha, const SKAS::matrix::matrix< T1 >& a_matrix, const SKAS::vect::vect< T1 >& x_vect, const T1 beta, SKAS::vect::vect< T1 >& y_vect, const std::vector< sycl::event >& deps ) -> sycl::event
+    {
+        constexpr size_t wg = 128;
+        const size_t rows = a_matrix.nrow( );
+        const size_t cols = a_matrix.ncol( );
+        if ( x_vect.size( ) != ( trans ? rows : cols ) || y_vect.size( ) != ( trans ? cols : rows ) )
+        {
+            throw matrixDimError{"CANNOT MULTIPLY MATRIX AND VECTOR OF INCOMPATIBLE DIMENSIONS"};
+        }
+        const T1* dev_a = a_matrix.storage( ).dev_data( );
+        const T1* dev_x = x_vect.dev_data( );
+        T1* dev_y = beta == T1{0} ? y_vect.dev_discard( ) : y_vect.dev_data( );
 
-        q.parallel_for(
-            sycl::range<2>(adimn, bdimm),
-            [=](sycl::id<2> idx){
+        sycl::queue& q = gpu::ctx( ).q;
+        if ( !rows || !cols ) return q.submit( [&]( sycl::handler& h ) { h.depends_on( deps ); h.single_task( [=]( ) { } ); } );
+        if ( trans )
+        {
+            return q.submit( [&]( sycl::handler& h ) {
+                h.depends_on( deps );
+                h.parallel_for( sycl::range< 1 >( cols ), [=]( sycl::id< 1 > j ) {
+                    T1 acc = 0;
+                    for ( size_t i = 0; i < rows; ++i ) acc += dev_a[ i * cols + j ] * dev_x[ i ];
+                    dev_y[ j ] = beta == T1{0} ? alpha * acc : alpha * acc + beta * dev_y[ j ];
+                } );
+            } );
+        }
+        return q.submit( [&]( sycl::handler& h ) {
+            h.depends_on( deps );
+            sycl::local_accessor< T1, 1 > scratch( sycl::range< 1 >( wg ), h );
+            h.parallel_for( sycl::nd_range< 1 >( rows * wg, wg ), [=]( sycl::nd_item< 1 > it ) {
+                const size_t lid = it.get_local_id( 0 );
+                const size_t row = it.get_group( 0 );
+                const T1* a_row = dev_a + row * cols;
+                T1 acc = 0;
+                for ( size_t j = lid; j < cols; j += wg ) acc += a_row[ j ] * dev_x[ j ];
+                scratch[ lid ] = acc;
+                for ( size_t stride = wg / 2; stride > 0; stride /= 2 )
+                {
+                    sycl::group_barrier( it.get_group( ) );
+                    if ( lid < stride ) scratch[ lid ] += scratch[ lid + stride ];
+                }
+                if ( lid == 0 ) dev_y[ row ] = beta == T1{0} ? alpha * scratch[ 0 ] : alpha * scratch[ 0 ] + beta * dev_y[ row ];
+            } );
+        } );
+    }
 
-            int i = idx[0];
-            int j = idx[1];
+    /**
+     * @brief substitutes the k columns of an nb-row block of b against an nb x nb diagonal block of a on the device,
+     * one work-item per column, see SKAS::matrix::trsm. a and b are device pointers to the blocks
+     */
+    template < SKAS::FlAd T1 >
+    auto PM_trsm_block( const bool lower, const bool trans, const bool unit, const size_t nb, const T1* dev_a, const size_t lda, T1* dev_b, const size_t ldb, const size_t k, const std::vector< sycl::event >& deps ) -> sycl::event
+    {
+        return gpu::ctx( ).q.submit( [&]( sycl::handler& h ) {
+            h.depends_on( deps );
+            h.parallel_for( sycl::range< 1 >( k ), [=]( sycl::id< 1 > c ) {
+                SKAS::matrix::trsm_columns( lower, trans, unit, nb, dev_a, lda, dev_b, ldb, size_t( c ), size_t( c ) + 1 );
+            } );
+        } );
+    }
 
-            T1 sum = 0;
+    /**
+     * @brief counts the zeros on the diagonal of the n x n device matrix a, reducing on the device so that
+     * only the count is copied back
+     */
+    template < SKAS::FlAd T1 >
+    auto PM_zero_diagonal( const T1* dev_a, const size_t n ) -> size_t
+    {
+        if ( n == 0 ) return 0;
+        return SKAS::vect::accel_vect::PV_scalar_async< size_t >( [&]( size_t* dev_c ) {
+            gpu::transform_reduce_n( n, [=]( size_t i ) { return dev_a[ i * n + i ] == T1{0} ? size_t{1} : size_t{0}; }, std::plus< size_t >( ), size_t{0}, dev_c );
+        } ).wait( );
+    }
 
-            for(int k=0; k<adimm; ++k)
-                sum += *( i*adimm + dev_a + k ) * *( j*bdimn + dev_b + k );
+    /**
+     * @brief applies the row interchanges of the nb-column panel at k0, pivots[ j ] being the panel row swapped with
+     * row j, to the columns outside the panel on the device. one work-item per column, swaps in order
+     */
+    template < SKAS::FlAd T1 >
+    auto PM_lu_swap_rows( T1* dev_a, const size_t n, const size_t k0, const size_t nb, const std::array< size_t, SKAS::matrix::factor_block >& pivots, const std::vector< sycl::event >& deps ) -> sycl::event
+    {
+        const std::array< size_t, SKAS::matrix::factor_block > swaps = pivots;
+        return gpu::ctx( ).q.submit( [&]( sycl::handler& h ) {
+            h.depends_on( deps );
+            h.parallel_for( sycl::range< 1 >( n - nb ), [=]( sycl::id< 1 > id ) {
+                const size_t c = size_t( id ) < k0 ? size_t( id ) : size_t( id ) + nb;
+                for ( size_t j = 0; j < nb; ++j )
+                {
+                    if ( swaps[ j ] == j ) continue;
+                    T1* a = dev_a + ( k0 + j ) * n + c;
+                    T1* b = dev_a + ( k0 + swaps[ j ] ) * n + c;
+                    const T1 held = *a;
+                    *a = *b;
+                    *b = held;
+                }
+            } );
+        } );
+    }
 
-            *(i*bdimm + dev_c + j) = sum;
-            
-        });
+    /**
+     * @brief factors the diagonal block at ( k0, k0 ) and solves the panel below it on the device, see SKAS::matrix::cholesky.
+     * one work-item factors the small diagonal block, then one work-item per row solves the panel
+     * @return 0 on success, otherwise 1 + the first column whose pivot is not positive
+     */
+    template < SKAS::FlAd T1 >
+    auto PM_cholesky_panel( SKAS::vect::vect< T1 >& a, const size_t n, const size_t k0, const size_t nb ) -> size_t
+    {
+        sycl::queue& q = gpu::ctx( ).q;
+        T1* dev_a = a.dev_data( );
+        size_t* dev_info = gpu::ctx( ).pool.allocate< size_t >( 1 );
+        const size_t below = n - k0 - nb;
+
+        q.submit( [&]( sycl::handler& h ) {
+            h.single_task( [=]( ) { *dev_info = SKAS::matrix::chol_diag( dev_a, n, k0, nb ); } );
+        } );
+        if ( below )
+        {
+            q.submit( [&]( sycl::handler& h ) {
+                h.parallel_for( sycl::range< 1 >( below ), [=]( sycl::id< 1 > r ) {
+                    if ( *dev_info == 0 ) SKAS::matrix::chol_row( dev_a, n, k0, nb, k0 + nb + r );
+                } );
+            } );
+        }
+        size_t info = 0;
+        q.memcpy( &info, dev_info, sizeof( size_t ) ).wait( );
+        gpu::ctx( ).pool.deallocate( dev_info );
+        return info;
+    }
 
-        std::vector< T1 > out( adimn*bdimm );
+    /**
+     * @brief c = alpha * op( a ) % op( b ) + beta * c on the device, see SKAS::matrix::gemm. c must already have the result's dimensions
+     */
+    template < SKAS::FlAd T1 >
+    auto PM_gemm_into( const bool trans_a, const bool trans_b, const T1 alpha, const SKAS::matrix::matrix< T1 >& a_matrix, const SKAS::matrix::matrix< T1 >& b_matrix, const T1 beta, SKAS::matrix::matrix< T1 >& c_matrix, const std::vector< sycl::event >& deps ) -> sycl::event
+    {
+        const size_t m = trans_a ? a_matrix.ncol( ) : a_matrix.nrow( );
+        const size_t k = trans_a ? a_matrix.nrow( ) : a_matrix.ncol( );
+        const size_t n = trans_b ? b_matrix.nrow( ) : b_matrix.ncol( );
+        if ( k != ( trans_b ? b_matrix.ncol( ) : b_matrix.nrow( ) ) || c_matrix.nrow( ) != m || c_matrix.ncol( ) != n )
+        {
+            throw matrixDimError{"CANNOT GEMM MATRICIES OF INCOMPATIBLE DIMENSIONS"};
+        }
+        const T1* dev_a = a_matrix.storage( ).dev_data( );
+        const T1* dev_b = b_matrix.storage( ).dev_data( );
+        T1* dev_c = beta == T1{0} ? c_matrix.storage( ).dev_discard( ) : c_matrix.storage( ).dev_data( );
 
-        q.memcpy( out.data(), dev_c, sizeof( T1 ) * adimn*bdimm );
-        q.wait( );
+        return gemm_tiled< T1 >( trans_a, trans_b, m, n, k, alpha, dev_a, a_matrix.ncol( ), dev_b, b_matrix.ncol( ), beta, dev_c, c_matrix.ncol( ), deps );
+    }
 
-        sycl::free( dev_a, q );
-        sycl::free( dev_b, q );
-        sycl::free( dev_c, q );
+    template < SKAS::FlAd T1 >
+    auto PM_mul_async( const SKAS::matrix::matrix< T1 >& a_matrix, const SKAS::matrix::matrix< T1 >& b_matrix, const std::vector< sycl::event >& deps ) -> gpu::pending< SKAS::matrix::matrix< T1 > >
+    {
+        auto out = std::make_shared< matrix< T1 > >( T1{0}, a_matrix.nrow( ), b_matrix.ncol( ), exec::common( a_matrix.get_policy( ), b_matrix.get_policy( ) ) );
+        sycl::event ev = PM_mul_into( a_matrix, b_matrix, *out, deps );
+        return gpu::pending< matrix< T1 > >( ev, out );
+    }
 
-        SKAS::matrix::matrix< T1 > final( out, adimm, bdimn, true );
+    template < SKAS::FlAd T1 >
+    auto PM_mul( const SKAS::matrix::matrix< T1 >& a_matrix, const SKAS::matrix::matrix< T1 >& b_matrix ) -> SKAS::matrix::matrix< T1 >
+    {
+        SKAS::matrix::matrix< T1 > final( T1{0}, a_matrix.nrow( ), b_matrix.ncol( ), exec::common( a_matrix.get_policy( ), b_matrix.get_policy( ) ) );
+        PM_mul_into( a_matrix, b_matrix, final, { } ).wait( );
         return final;
     }
 };
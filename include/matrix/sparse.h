@@ -0,0 +1,622 @@
+/**
+ * @brief Compressed sparse row matrix, its COO builder and the sparse products
+ * @author Will Sharpsteen - wisharpsteen@gmail.com
+ */
+#include <iostream>
+#include <vector>
+#include <memory>
+#include <numeric>
+#include <algorithm>
+#include <utility>
+#include <sycl/sycl.hpp>
+#include "templates.h"
+#include "customexceptions.h"
+#include "exec.h"
+#include "gpu.h"
+#include "vect.h"
+#include "matrix.h"
+
+#ifndef SPARSE_H
+#define SPARSE_H
+
+namespace SKAS::matrix
+{
+    /**
+     * @brief rows x cols matrix in compressed sparse row form: the stored entries of row i are values[ row_offsets[ i ] ..
+     * row_offsets[ i + 1 ] ) at columns[ ... ], ascending and unique within the row. values is a vect, so the matrix
+     * carries its policy and device residency; the index arrays are immutable, shared between copies, and mirrored to
+     * the device the first time a kernel needs them
+     */
+    template < SKAS::FlAd T >
+    class sparse_matrix
+    {
+        private:
+        struct index
+        {
+            std::vector< size_t > row_offsets;
+            std::vector< size_t > columns;
+            mutable size_t* dev_row_offsets = nullptr;
+            mutable size_t* dev_columns = nullptr;
+
+            index( std::vector< size_t > t_offsets, std::vector< size_t > t_columns ) : row_offsets( std::move( t_offsets ) ), columns( std::move( t_columns ) ) { }
+
+            index( const index& ) = delete;
+            index& operator=( const index& ) = delete;
+
+            ~index( )
+            {
+                if ( dev_row_offsets )
+                {
+                    gpu::ctx( ).pool.deallocate( dev_row_offsets );
+                    gpu::ctx( ).pool.deallocate( dev_columns );
+                }
+            }
+
+            auto upload( ) const -> void
+            {
+                if ( dev_row_offsets ) return;
+                sycl::queue& q = gpu::ctx( ).q;
+                dev_row_offsets = gpu::ctx( ).pool.allocate< size_t >( row_offsets.size( ) );
+                dev_columns = gpu::ctx( ).pool.allocate< size_t >( std::max< size_t >( columns.size( ), 1 ) );
+                q.memcpy( dev_row_offsets, row_offsets.data( ), row_offsets.size( ) * sizeof( size_t ) );
+                if ( !columns.empty( ) ) q.memcpy( dev_columns, columns.data( ), columns.size( ) * sizeof( size_t ) );
+                q.wait( );
+            }
+        };
+
+        size_t dim_n = 0;
+        size_t dim_m = 0;
+        std::shared_ptr< const index > idx;
+        vect::vect< T > vals;
+
+        public:
+        sparse_matrix( ) : idx( std::make_shared< const index >( std::vector< size_t >( 1, 0 ), std::vector< size_t >( ) ) ) { }
+
+        /**
+         * @brief takes CSR arrays as they are
+         * @exception matrixDimError thrown when the arrays are inconsistent with each other or with rows x cols, or a
+         * row's columns are not strictly ascending
+         */
+        sparse_matrix( const size_t rows, const size_t cols, std::vector< size_t > t_offsets, std::vector< size_t > t_columns, std::vector< T > t_values, const exec::policy t_policy = exec::policy::seq )
+            : dim_n( rows ), dim_m( cols )
+        {
+            if ( t_offsets.size( ) != rows + 1 || t_offsets.front( ) != 0 || t_offsets.back( ) != t_columns.size( ) || t_columns.size( ) != t_values.size( ) )
+            {
+                throw matrixDimError{"CSR ARRAYS DO NOT DESCRIBE A MATRIX OF THESE DIMENSIONS"};
+            }
+            for ( size_t i = 0; i < rows; ++i )
+            {
+                if ( t_offsets[ i ] > t_offsets[ i + 1 ] ) throw matrixDimError{"CSR ROW OFFSETS MUST BE NONDECREASING"};
+                for ( size_t e = t_offsets[ i ]; e < t_offsets[ i + 1 ]; ++e )
+                {
+                    if ( t_columns[ e ] >= cols || ( e > t_offsets[ i ] && t_columns[ e ] <= t_columns[ e - 1 ] ) ) throw matrixDimError{"CSR COLUMNS MUST BE IN RANGE AND ASCENDING WITHIN A ROW"};
+                }
+            }
+            idx = std::make_shared< const index >( std::move( t_offsets ), std::move( t_columns ) );
+            vals = vect::vect< T >( std::move( t_values ), t_policy );
+        }
+
+        /**
+         * @brief the nonzeros of a dense matrix, under its policy. rows are counted and then filled in parallel on the host
+         */
+        explicit sparse_matrix( const matrix< T >& dense ) : dim_n( dense.nrow( ) ), dim_m( dense.ncol( ) )
+        {
+            const size_t rows = dim_n;
+            const size_t cols = dim_m;
+            const T* a = dense.storage( ).data( );
+            const exec::policy p = gpu::resolve( dense.get_policy( ), gpu::op_kind::elementwise, rows * cols );
+            const exec::policy host = p == exec::policy::device ? exec::policy::threaded : p;
+            const size_t min_rows = std::max< size_t >( 1, exec::grain / std::max< size_t >( cols, 1 ) );
+
+            std::vector< size_t > offsets( rows + 1, 0 );
+            size_t* counts = offsets.data( ) + 1;
+            exec::for_chunks( host, rows, min_rows, [=]( size_t lo, size_t hi ) {
+                for ( size_t i = lo; i < hi; ++i ) counts[ i ] = cols - std::count( a + i * cols, a + i * cols + cols, T{0} );
+            } );
+            std::inclusive_scan( offsets.begin( ), offsets.end( ), offsets.begin( ) );
+
+            std::vector< size_t > columns( offsets.back( ) );
+            std::vector< T > values( offsets.back( ) );
+            const size_t* starts = offsets.data( );
+            size_t* c_out = columns.data( );
+            T* v_out = values.data( );
+            exec::for_chunks( host, rows, min_rows, [=]( size_t lo, size_t hi ) {
+                for ( size_t i = lo; i < hi; ++i )
+                {
+                    size_t e = starts[ i ];
+                    for ( size_t j = 0; j < cols; ++j )
+                    {
+                        if ( a[ i * cols + j ] == T{0} ) continue;
+                        c_out[ e ] = j;
+                        v_out[ e++ ] = a[ i * cols + j ];
+                    }
+                }
+            } );
+            idx = std::make_shared< const index >( std::move( offsets ), std::move( columns ) );
+            vals = vect::vect< T >( std::move( values ), dense.get_policy( ) );
+        }
+
+        auto nrow( ) const -> size_t
+        {
+            return dim_n;
+        }
+
+        auto ncol( ) const -> size_t
+        {
+            return dim_m;
+        }
+
+        /**
+         * @brief stored entries
+         */
+        auto nnz( ) const -> size_t
+        {
+            return idx->columns.size( );
+        }
+
+        auto row_offsets( ) const -> const std::vector< size_t >&
+        {
+            return idx->row_offsets;
+        }
+
+        auto columns( ) const -> const std::vector< size_t >&
+        {
+            return idx->columns;
+        }
+
+        auto values( ) const -> const vect::vect< T >&
+        {
+            return vals;
+        }
+
+        /**
+         * @brief stored values, writable in place. the sparsity pattern is fixed
+         */
+        auto values( ) -> vect::vect< T >&
+        {
+            return vals;
+        }
+
+        /**
+         * @brief device mirrors of the index arrays, uploaded on first use
+         */
+        auto dev_row_offsets( ) const -> const size_t*
+        {
+            idx->upload( );
+            return idx->dev_row_offsets;
+        }
+
+        auto dev_columns( ) const -> const size_t*
+        {
+            idx->upload( );
+            return idx->dev_columns;
+        }
+
+        /**
+         * @brief element ( row, col ), zero when it is not stored. binary search within the row
+         * @exception matrixDimError thrown for an index outside the matrix
+         */
+        auto at( const size_t row, const size_t col ) const -> T
+        {
+            if ( row >= dim_n || col >= dim_m ) throw matrixDimError{"CANNOT ACCESS ELEMENT OUTSIDE MATRIX"};
+            const auto first = idx->columns.begin( ) + idx->row_offsets[ row ];
+            const auto last = idx->columns.begin( ) + idx->row_offsets[ row + 1 ];
+            const auto found = std::lower_bound( first, last, col );
+            return found != last && *found == col ? vals[ found - idx->columns.begin( ) ] : T{0};
+        }
+
+        auto get_policy( ) const -> exec::policy
+        {
+            return vals.get_policy( );
+        }
+
+        auto set_policy( const exec::policy t_policy ) -> void
+        {
+            vals.set_policy( t_policy );
+        }
+
+        /**
+         * @brief dense copy under the same policy
+         */
+        auto todense( ) const -> matrix< T >
+        {
+            matrix< T > dense( T{0}, dim_n, dim_m, get_policy( ) );
+            T* out = dense.storage( ).data( );
+            const size_t* offsets = idx->row_offsets.data( );
+            const size_t* cols = idx->columns.data( );
+            const T* v = vals.data( );
+            const size_t ld = dim_m;
+            exec::for_chunks( get_policy( ) == exec::policy::device ? exec::policy::threaded : get_policy( ), dim_n, 64, [=]( size_t lo, size_t hi ) {
+                for ( size_t i = lo; i < hi; ++i )
+                {
+                    for ( size_t e = offsets[ i ]; e < offsets[ i + 1 ]; ++e ) out[ i * ld + cols[ e ] ] = v[ e ];
+                }
+            } );
+            return dense;
+        }
+
+        /**
+         * @brief transpose, by a counting sort of the entries on their column. rows are visited in order, so the columns of
+         * every transposed row come out ascending
+         */
+        auto t( ) const -> sparse_matrix
+        {
+            const std::vector< size_t >& offsets = idx->row_offsets;
+            const std::vector< size_t >& cols = idx->columns;
+            const T* v = vals.data( );
+            std::vector< size_t > t_offsets( dim_m + 1, 0 );
+            for ( const size_t c : cols ) ++t_offsets[ c + 1 ];
+            std::inclusive_scan( t_offsets.begin( ), t_offsets.end( ), t_offsets.begin( ) );
+
+            std::vector< size_t > next( t_offsets.begin( ), t_offsets.end( ) - 1 );
+            std::vector< size_t > t_columns( nnz( ) );
+            std::vector< T > t_values( nnz( ) );
+            for ( size_t i = 0; i < dim_n; ++i )
+            {
+                for ( size_t e = offsets[ i ]; e < offsets[ i + 1 ]; ++e )
+                {
+                    const size_t slot = next[ cols[ e ] ]++;
+                    t_columns[ slot ] = i;
+                    t_values[ slot ] = v[ e ];
+                }
+            }
+            sparse_matrix output;
+            output.dim_n = dim_m;
+            output.dim_m = dim_n;
+            output.idx = std::make_shared< const index >( std::move( t_offsets ), std::move( t_columns ) );
+            output.vals = vect::vect< T >( std::move( t_values ), get_policy( ) );
+            return output;
+        }
+
+        auto operator==( const sparse_matrix& other ) const -> bool
+        {
+            return dim_n == other.dim_n && dim_m == other.dim_m && ( idx == other.idx || ( idx->row_offsets == other.idx->row_offsets && idx->columns == other.idx->columns ) ) && vals == other.vals;
+        }
+    };
+
+    /**
+     * @brief collects ( row, col, value ) triplets in any order and compresses them into a sparse_matrix. duplicates are summed
+     */
+    template < SKAS::FlAd T >
+    class coo_builder
+    {
+        private:
+        size_t rows;
+        size_t cols;
+        std::vector< size_t > row_of;
+        std::vector< size_t > col_of;
+        std::vector< T > value_of;
+
+        public:
+        coo_builder( const size_t rowcount, const size_t colcount ) : rows( rowcount ), cols( colcount ) { }
+
+        /**
+         * @brief makes room for count triplets
+         */
+        auto reserve( const size_t count ) -> void
+        {
+            row_of.reserve( count );
+            col_of.reserve( count );
+            value_of.reserve( count );
+        }
+
+        /**
+         * @exception matrixDimError thrown for an index outside rows x cols
+         */
+        auto add( const size_t row, const size_t col, const T value ) -> void
+        {
+            if ( row >= rows || col >= cols ) throw matrixDimError{"CANNOT ADD ENTRY OUTSIDE MATRIX"};
+            row_of.push_back( row );
+            col_of.push_back( col );
+            value_of.push_back( value );
+        }
+
+        /**
+         * @brief triplets added so far
+         */
+        auto size( ) const -> size_t
+        {
+            return value_of.size( );
+        }
+
+        /**
+         * @brief the compressed matrix: triplets are bucketed by row with a counting sort, each row sorted on column and
+         * duplicates summed. the builder is left empty
+         */
+        auto build( const exec::policy t_policy = exec::policy::seq ) -> sparse_matrix< T >
+        {
+            std::vector< size_t > offsets( rows + 1, 0 );
+            for ( const size_t r : row_of ) ++offsets[ r + 1 ];
+            std::inclusive_scan( offsets.begin( ), offsets.end( ), offsets.begin( ) );
+
+            std::vector< size_t > order( value_of.size( ) );
+            std::vector< size_t > next( offsets.begin( ), offsets.end( ) - 1 );
+            for ( size_t t = 0; t < value_of.size( ); ++t ) order[ next[ row_of[ t ] ]++ ] = t;
+
+            std::vector< size_t > columns;
+            std::vector< T > values;
+            columns.reserve( order.size( ) );
+            values.reserve( order.size( ) );
+            std::vector< size_t > compressed( rows + 1, 0 );
+            for ( size_t i = 0; i < rows; ++i )
+            {
+                const auto first = order.begin( ) + offsets[ i ];
+                const auto last = order.begin( ) + offsets[ i + 1 ];
+                std::sort( first, last, [&]( size_t x, size_t y ) { return col_of[ x ] < col_of[ y ]; } );
+                for ( auto t = first; t != last; ++t )
+                {
+                    if ( columns.size( ) > compressed[ i ] && columns.back( ) == col_of[ *t ] )
+                    {
+                        values.back( ) += value_of[ *t ];
+                        continue;
+                    }
+                    columns.push_back( col_of[ *t ] );
+                    values.push_back( value_of[ *t ] );
+                }
+                compressed[ i + 1 ] = columns.size( );
+            }
+            row_of.clear( );
+            col_of.clear( );
+            value_of.clear( );
+            return sparse_matrix< T >( rows, cols, std::move( compressed ), std::move( columns ), std::move( values ), t_policy );
+        }
+    };
+
+}; // namespace SKAS::matrix -end
+
+namespace SKAS::matrix::host_matr
+{
+    /**
+     * @brief y = alpha * A x + beta * y on the host for a rows-row CSR A given by its arrays. row chunks over exec::pool( )
+     * under policy::threaded, sized by the stored entries. beta == 0 overwrites y without reading it
+     */
+    template < SKAS::FlAd T >
+    auto spmv( const exec::policy p, const size_t rows, const size_t nnz, const size_t* offsets, const size_t* cols, const T* v,
+               const T alpha, const T* x, const T beta, T* y ) -> void
+    {
+        const size_t min_rows = std::max< size_t >( 1, exec::grain * rows / std::max< size_t >( nnz, 1 ) );
+        exec::for_chunks( p, rows, min_rows, [=]( size_t lo, size_t hi ) {
+            for ( size_t i = lo; i < hi; ++i )
+            {
+                T sum{ 0 };
+                for ( size_t e = offsets[ i ]; e < offsets[ i + 1 ]; ++e ) sum += v[ e ] * x[ cols[ e ] ];
+                y[ i ] = beta == T{0} ? alpha * sum : alpha * sum + beta * y[ i ];
+            }
+        } );
+    }
+
+}; // namespace SKAS::matrix::host_matr -end
+
+namespace SKAS::matrix::accel_matr
+{
+    /**
+     * @brief y = alpha * A x + beta * y on the device, one work-item per row, see SKAS::matrix::spmv. y must already have
+     * A's row count. only enqueues the kernel and returns its event
+     */
+    template < SKAS::FlAd T >
+    auto PM_spmv_into( const T alpha, const SKAS::matrix::sparse_matrix< T >& a_matrix, const SKAS::vect::vect< T >& x_vect, const T beta, SKAS::vect::vect< T >& y_vect, const std::vector< sycl::event >& deps = { } ) -> sycl::event
+    {
+        const size_t rows = a_matrix.nrow( );
+        if ( x_vect.size( ) != a_matrix.ncol( ) || y_vect.size( ) != rows ) throw matrixDimError{"CANNOT MULTIPLY MATRIX AND VECTOR OF INCOMPATIBLE DIMENSIONS"};
+        const size_t* offsets = a_matrix.dev_row_offsets( );
+        const size_t* cols = a_matrix.dev_columns( );
+        const T* v = a_matrix.values( ).dev_data( );
+        const T* x = x_vect.dev_data( );
+        T* y = beta == T{0} ? y_vect.dev_discard( ) : y_vect.dev_data( );
+
+        sycl::queue& q = gpu::ctx( ).q;
+        if ( !rows ) return q.submit( [&]( sycl::handler& h ) { h.depends_on( deps ); h.single_task( [=]( ) { } ); } );
+        return q.submit( [&]( sycl::handler& h ) {
+            h.depends_on( deps );
+            h.parallel_for( sycl::range< 1 >( rows ), [=]( sycl::id< 1 > id ) {
+                const size_t i = id;
+                T sum{ 0 };
+                for ( size_t e = offsets[ i ]; e < offsets[ i + 1 ]; ++e ) sum += v[ e ] * x[ cols[ e ] ];
+                y[ i ] = beta == T{0} ? alpha * sum : alpha * sum + beta * y[ i ];
+            } );
+        } );
+    }
+
+}; // namespace SKAS::matrix::accel_matr -end
+
+namespace SKAS::matrix
+{
+    /**
+     * @brief y = alpha * A x + beta * y for sparse A. one work-item per row on the device, row chunks over exec::pool( )
+     * on the host (reduction kind over the stored entries for automatic). beta == 0 overwrites y without reading it
+     * @exception matrixDimError thrown for incompatible dimensions, or y aliasing x. with beta == 0 a mis-sized y is replaced
+     */
+    template < SKAS::FlAd T >
+    auto spmv( const T alpha, const sparse_matrix< T >& a_matrix, const vect::vect< T >& x_vect, const T beta, vect::vect< T >& y_vect ) -> void
+    {
+        const size_t rows = a_matrix.nrow( );
+        if ( x_vect.size( ) != a_matrix.ncol( ) ) throw matrixDimError{"CANNOT MULTIPLY MATRIX AND VECTOR OF INCOMPATIBLE DIMENSIONS"};
+        if ( &y_vect == &x_vect ) throw matrixDimError{"SPMV OUTPUT CANNOT ALIAS AN INPUT"};
+        if ( y_vect.size( ) != rows )
+        {
+            if ( beta != T{0} ) throw matrixDimError{"SPMV OUTPUT SIZE DOES NOT MATCH A % x"};
+            y_vect = vect::vect< T >( rows, T{0}, exec::common( a_matrix.get_policy( ), x_vect.get_policy( ) ) );
+        }
+        if ( !rows ) return;
+
+        const exec::policy all = exec::common( exec::common( a_matrix.get_policy( ), x_vect.get_policy( ) ), y_vect.get_policy( ) );
+        const exec::policy p = gpu::resolve( all, gpu::op_kind::reduction, a_matrix.nnz( ) + rows );
+        if ( p == exec::policy::device )
+        {
+            accel_matr::PM_spmv_into( alpha, a_matrix, x_vect, beta, y_vect ).wait( );
+            return;
+        }
+        host_matr::spmv( p, rows, a_matrix.nnz( ), a_matrix.row_offsets( ).data( ), a_matrix.columns( ).data( ), a_matrix.values( ).data( ),
+                         alpha, x_vect.data( ), beta, y_vect.data( ) );
+    }
+
+    /**
+     * @brief sparse matrix-vector product A x, see spmv
+     */
+    template < SKAS::FlAd T >
+    auto operator%( const sparse_matrix< T >& a_matrix, const vect::vect< T >& x_vect ) -> vect::vect< T >
+    {
+        vect::vect< T > y;
+        spmv( T{1}, a_matrix, x_vect, T{0}, y );
+        return y;
+    }
+
+    /**
+     * @brief sparse-dense product A B into a dense row-major matrix. one work-item per element of the product on the
+     * device; on the host each row of the product accumulates the rows of B its stored entries select, row chunks over
+     * exec::pool( ) (matmul kind over stored entries times columns for automatic)
+     * @exception matrixDimError thrown for incompatible dimensions
+     */
+    template < SKAS::FlAd T >
+    auto operator%( const sparse_matrix< T >& a_matrix, const matrix< T >& b_matrix ) -> matrix< T >
+    {
+        if ( a_matrix.ncol( ) != b_matrix.nrow( ) ) throw matrixDimError{"CANNOT MULTIPLY MATRICIES OF INCOMPATIBLE DIMENSIONS"};
+        const size_t rows = a_matrix.nrow( );
+        const size_t n = b_matrix.ncol( );
+        const exec::policy pol = exec::common( a_matrix.get_policy( ), b_matrix.get_policy( ) );
+        matrix< T > product( vect::vect< T >( rows * n, pol ), rows, n, pol );
+        if ( !rows || !n ) return product;
+
+        const exec::policy p = gpu::resolve( pol, gpu::op_kind::matmul, a_matrix.nnz( ) * n );
+        if ( p == exec::policy::device )
+        {
+            const size_t* offsets = a_matrix.dev_row_offsets( );
+            const size_t* cols = a_matrix.dev_columns( );
+            const T* v = a_matrix.values( ).dev_data( );
+            const T* b = b_matrix.storage( ).dev_data( );
+            T* c = product.storage( ).dev_discard( );
+            gpu::ctx( ).q.parallel_for( sycl::range< 1 >( rows * n ), [=]( sycl::id< 1 > id ) {
+                const size_t i = size_t( id ) / n;
+                const size_t j = size_t( id ) % n;
+                T sum{ 0 };
+                for ( size_t e = offsets[ i ]; e < offsets[ i + 1 ]; ++e ) sum += v[ e ] * b[ cols[ e ] * n + j ];
+                c[ i * n + j ] = sum;
+            } ).wait( );
+            return product;
+        }
+
+        const size_t* offsets = a_matrix.row_offsets( ).data( );
+        const size_t* cols = a_matrix.columns( ).data( );
+        const T* v = a_matrix.values( ).data( );
+        const T* b = b_matrix.storage( ).data( );
+        T* c = product.storage( ).data( );
+        const size_t min_rows = std::max< size_t >( 1, exec::grain * rows / std::max< size_t >( a_matrix.nnz( ) * n, 1 ) );
+        exec::for_chunks( p, rows, min_rows, [=]( size_t lo, size_t hi ) {
+            for ( size_t i = lo; i < hi; ++i )
+            {
+                T* c_row = c + i * n;
+                std::fill( c_row, c_row + n, T{0} );
+                for ( size_t e = offsets[ i ]; e < offsets[ i + 1 ]; ++e )
+                {
+                    const T scale = v[ e ];
+                    const T* b_row = b + cols[ e ] * n;
+                    SKAS_SIMD
+                    for ( size_t j = 0; j < n; ++j ) c_row[ j ] += scale * b_row[ j ];
+                }
+            }
+        } );
+        return product;
+    }
+
+    /**
+     * @brief sparse-sparse product A B ( SpGEMM ), by Gustavson's row-wise algorithm in two passes over row chunks on
+     * exec::pool( ): a symbolic pass counts the distinct columns of every product row, then a numeric pass accumulates
+     * each row in a dense scratch row and writes its columns out sorted. runs on host threads under every policy, since
+     * the dense scratch rows do not fit work-items; the product keeps the common policy of A and B
+     * @exception matrixDimError thrown for incompatible dimensions
+     */
+    template < SKAS::FlAd T >
+    auto operator%( const sparse_matrix< T >& a_matrix, const sparse_matrix< T >& b_matrix ) -> sparse_matrix< T >
+    {
+        if ( a_matrix.ncol( ) != b_matrix.nrow( ) ) throw matrixDimError{"CANNOT MULTIPLY MATRICIES OF INCOMPATIBLE DIMENSIONS"};
+        const size_t rows = a_matrix.nrow( );
+        const size_t n = b_matrix.ncol( );
+        const exec::policy pol = exec::common( a_matrix.get_policy( ), b_matrix.get_policy( ) );
+        const exec::policy p = pol == exec::policy::device || pol == exec::policy::automatic ? exec::policy::threaded : pol;
+        constexpr size_t unseen = ~size_t{0};
+
+        const size_t* a_offsets = a_matrix.row_offsets( ).data( );
+        const size_t* a_cols = a_matrix.columns( ).data( );
+        const T* a_v = a_matrix.values( ).data( );
+        const size_t* b_offsets = b_matrix.row_offsets( ).data( );
+        const size_t* b_cols = b_matrix.columns( ).data( );
+        const T* b_v = b_matrix.values( ).data( );
+
+        std::vector< size_t > offsets( rows + 1, 0 );
+        size_t* counts = offsets.data( ) + 1;
+        exec::for_chunks( p, rows, 64, [=]( size_t lo, size_t hi ) {
+            std::vector< size_t > seen( n, unseen );
+            for ( size_t i = lo; i < hi; ++i )
+            {
+                size_t count = 0;
+                for ( size_t e = a_offsets[ i ]; e < a_offsets[ i + 1 ]; ++e )
+                {
+                    const size_t k = a_cols[ e ];
+                    for ( size_t f = b_offsets[ k ]; f < b_offsets[ k + 1 ]; ++f )
+                    {
+                        if ( seen[ b_cols[ f ] ] == i ) continue;
+                        seen[ b_cols[ f ] ] = i;
+                        ++count;
+                    }
+                }
+                counts[ i ] = count;
+            }
+        } );
+        std::inclusive_scan( offsets.begin( ), offsets.end( ), offsets.begin( ) );
+
+        std::vector< size_t > columns( offsets.back( ) );
+        std::vector< T > values( offsets.back( ) );
+        const size_t* starts = offsets.data( );
+        size_t* c_cols = columns.data( );
+        T* c_v = values.data( );
+        exec::for_chunks( p, rows, 64, [=]( size_t lo, size_t hi ) {
+            std::vector< size_t > seen( n, unseen );
+            std::vector< T > acc( n, T{0} );
+            for ( size_t i = lo; i < hi; ++i )
+            {
+                size_t* row_cols = c_cols + starts[ i ];
+                size_t count = 0;
+                for ( size_t e = a_offsets[ i ]; e < a_offsets[ i + 1 ]; ++e )
+                {
+                    const size_t k = a_cols[ e ];
+                    const T scale = a_v[ e ];
+                    for ( size_t f = b_offsets[ k ]; f < b_offsets[ k + 1 ]; ++f )
+                    {
+                        const size_t j = b_cols[ f ];
+                        if ( seen[ j ] != i )
+                        {
+                            seen[ j ] = i;
+                            acc[ j ] = T{0};
+                            row_cols[ count++ ] = j;
+                        }
+                        acc[ j ] += scale * b_v[ f ];
+                    }
+                }
+                std::sort( row_cols, row_cols + count );
+                for ( size_t e = 0; e < count; ++e ) c_v[ starts[ i ] + e ] = acc[ row_cols[ e ] ];
+            }
+        } );
+
+        return sparse_matrix< T >( rows, n, std::move( offsets ), std::move( columns ), std::move( values ), pol );
+    }
+
+    /**
+     * @brief sparse matrix stream insert, one stored entry per line
+     */
+    template < SKAS::FlAd T >
+    auto operator<<( std::ostream& os, const sparse_matrix< T >& t_matrix ) -> std::ostream&
+    {
+        os << t_matrix.nrow( ) << " x " << t_matrix.ncol( ) << ", " << t_matrix.nnz( ) << " stored\n";
+        for ( size_t i = 0; i < t_matrix.nrow( ); ++i )
+        {
+            for ( size_t e = t_matrix.row_offsets( )[ i ]; e < t_matrix.row_offsets( )[ i + 1 ]; ++e )
+            {
+                os << "( " << i << ", " << t_matrix.columns( )[ e ] << " ) " << t_matrix.values( )[ e ] << "\n";
+            }
+        }
+        return os;
+    }
+
+}; // namespace SKAS::matrix -end
+
+#endif
@@ -0,0 +1,282 @@
+/**
+ * @brief Execution policies and the host backends behind them
+ * @author Will Sharpsteen - wisharpsteen@gmail.com
+ */
+#include <cstddef>
+#include <algorithm>
+#include <array>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <exception>
+
+#ifndef EXEC_H
+#define EXEC_H
+
+// vectorization hint for host loops. honoured when built with -fopenmp-simd (or -fopenmp), ignored otherwise
+#define SKAS_SIMD _Pragma( "omp simd" )
+
+namespace SKAS::exec
+{
+    /**
+     * @brief where and how an operation runs
+     */
+    enum class policy
+    {
+        seq,        // plain host loop
+        simd,       // vectorized host loop
+        threaded,   // host loop split over exec::pool( ), vectorized within each chunk
+        device,     // SYCL kernels on gpu::ctx( ).q
+        automatic   // picked per call from op kind and size, see gpu::resolve( )
+    };
+
+    /**
+     * @brief policy of the old bool parallel flag: true is the device, false the plain host loop
+     */
+    constexpr auto of( const bool parallel ) -> policy
+    {
+        return parallel ? policy::device : policy::seq;
+    }
+
+    /**
+     * @brief policy of a result computed from operands running under a and b. an op only runs on the device
+     * when both operands are there; otherwise it runs on the host under the stronger of the host policies.
+     * automatic defers to the other operand unless that one is on the device
+     */
+    constexpr auto common( const policy a, const policy b ) -> policy
+    {
+        if ( a == b ) return a;
+        if ( a == policy::device ) return b;
+        if ( b == policy::device ) return a;
+        if ( a == policy::automatic ) return b;
+        if ( b == policy::automatic ) return a;
+        return std::max( a, b );
+    }
+
+    /**
+     * @brief fixed set of worker threads shared by every threaded op. the calling thread works too,
+     * and a run( ) issued from inside a task executes inline instead of waiting on itself
+     */
+    class thread_pool
+    {
+        public:
+        explicit thread_pool( const size_t workers = std::max( std::thread::hardware_concurrency( ), 1u ) - 1 )
+        {
+            threads.reserve( workers );
+            for ( size_t i = 0; i < workers; ++i ) threads.emplace_back( [this]( ) { work( ); } );
+        }
+
+        thread_pool( const thread_pool& ) = delete;
+        thread_pool& operator=( const thread_pool& ) = delete;
+
+        ~thread_pool( )
+        {
+            {
+                std::lock_guard< std::mutex > lock( guard );
+                stopping = true;
+            }
+            wake.notify_all( );
+            for ( auto& thread : threads ) thread.join( );
+        }
+
+        /**
+         * @brief threads available to a run( ), counting the caller
+         */
+        auto size( ) const -> size_t
+        {
+            return threads.size( ) + 1;
+        }
+
+        /**
+         * @brief calls task( t ) for every t in [ 0, tasks ) across the pool and blocks until all are done.
+         * the first exception thrown by a task is rethrown here
+         */
+        auto run( const size_t tasks, const std::function< void( size_t ) >& task ) -> void
+        {
+            if ( tasks == 0 ) return;
+            if ( tasks == 1 || threads.empty( ) || inside )
+            {
+                for ( size_t t = 0; t < tasks; ++t ) task( t );
+                return;
+            }
+
+            std::lock_guard< std::mutex > one_job( submit );
+            {
+                std::lock_guard< std::mutex > lock( guard );
+                job = &task;
+                job_tasks = tasks;
+                remaining = tasks;
+                next.store( 0 );
+                error = nullptr;
+                ++generation;
+            }
+            wake.notify_all( );
+
+            inside = true;
+            drain( );
+            inside = false;
+
+            std::unique_lock< std::mutex > lock( guard );
+            finished.wait( lock, [this]( ) { return remaining == 0 && active == 0; } );
+            job = nullptr;
+            if ( error ) std::rethrow_exception( error );
+        }
+
+        private:
+        std::vector< std::thread > threads;
+        std::mutex submit;
+        std::mutex guard;
+        std::condition_variable wake;
+        std::condition_variable finished;
+        const std::function< void( size_t ) >* job = nullptr;
+        size_t job_tasks = 0;
+        size_t remaining = 0;
+        size_t active = 0;
+        size_t generation = 0;
+        bool stopping = false;
+        std::atomic< size_t > next{ 0 };
+        std::exception_ptr error;
+
+        static inline thread_local bool inside = false;
+
+        auto drain( ) -> void
+        {
+            for ( size_t t = next.fetch_add( 1 ); t < job_tasks; t = next.fetch_add( 1 ) )
+            {
+                std::exception_ptr failure;
+                try
+                {
+                    ( *job )( t );
+                }
+                catch ( ... )
+                {
+                    failure = std::current_exception( );
+                }
+                std::lock_guard< std::mutex > lock( guard );
+                if ( failure && !error ) error = failure;
+                if ( --remaining == 0 ) finished.notify_all( );
+            }
+        }
+
+        auto work( ) -> void
+        {
+            inside = true;
+            size_t seen = 0;
+            for ( ;; )
+            {
+                std::unique_lock< std::mutex > lock( guard );
+                wake.wait( lock, [&]( ) { return stopping || generation != seen; } );
+                if ( stopping ) return;
+                seen = generation;
+                if ( !job ) continue;
+                ++active;
+                lock.unlock( );
+                drain( );
+                lock.lock( );
+                if ( --active == 0 ) finished.notify_all( );
+            }
+        }
+    };
+
+    inline thread_pool& pool( )
+    {
+        static thread_pool instance{ };
+        return instance;
+    }
+
+    // smallest slice of an element-wise loop worth handing to another thread
+    inline constexpr size_t grain = size_t{1} << 14;
+
+    // independent accumulators per simd reduction, enough to fill a vector register of floats
+    inline constexpr size_t lanes = 8;
+
+    /**
+     * @brief calls f( lo, hi ) over consecutive slices covering [ 0, n ). slices go to exec::pool( )
+     * under policy::threaded when n spans more than one min_chunk, otherwise f( 0, n ) runs on the caller
+     */
+    template < typename F >
+    auto for_chunks( const policy p, const size_t n, const size_t min_chunk, F f ) -> void
+    {
+        const size_t chunk_floor = std::max< size_t >( min_chunk, 1 );
+        if ( p != policy::threaded || n <= chunk_floor )
+        {
+            if ( n ) f( size_t{0}, n );
+            return;
+        }
+        const size_t chunks = std::min( pool( ).size( ) * 4, ( n + chunk_floor - 1 ) / chunk_floor );
+        const size_t step = ( n + chunks - 1 ) / chunks;
+        pool( ).run( chunks, [&]( size_t c ) {
+            const size_t lo = c * step;
+            const size_t hi = std::min( n, lo + step );
+            if ( lo < hi ) f( lo, hi );
+        } );
+    }
+
+    /**
+     * @brief host element-wise loop f( i ) for i in [ 0, n ) under a host policy
+     */
+    template < typename F >
+    auto for_n( const policy p, const size_t n, F f ) -> void
+    {
+        if ( p == policy::seq )
+        {
+            for ( size_t i = 0; i < n; ++i ) f( i );
+            return;
+        }
+        for_chunks( p, n, grain, [&]( size_t lo, size_t hi ) {
+            SKAS_SIMD
+            for ( size_t i = lo; i < hi; ++i ) f( i );
+        } );
+    }
+
+    /**
+     * @brief host reduction over [ 0, n ) under a host policy. fold( acc, i ) folds element i into an accumulator
+     * and merge( x, y ) combines two accumulators; init must be the identity of both. simd folds into
+     * exec::lanes interleaved accumulators, threaded does so per chunk, and partials are merged in order
+     */
+    template < typename T, typename Fold, typename Merge >
+    auto reduce_n( const policy p, const size_t n, const T init, Fold fold, Merge merge ) -> T
+    {
+        if ( p == policy::seq )
+        {
+            T acc = init;
+            for ( size_t i = 0; i < n; ++i ) fold( acc, i );
+            return acc;
+        }
+
+        auto slice = [&]( const size_t lo, const size_t hi ) -> T {
+            std::array< T, lanes > acc;
+            acc.fill( init );
+            size_t i = lo;
+            for ( ; i + lanes <= hi; i += lanes )
+            {
+                SKAS_SIMD
+                for ( size_t l = 0; l < lanes; ++l ) fold( acc[ l ], i + l );
+            }
+            for ( ; i < hi; ++i ) fold( acc[ 0 ], i );
+            T out = acc[ 0 ];
+            for ( size_t l = 1; l < lanes; ++l ) out = merge( out, acc[ l ] );
+            return out;
+        };
+
+        if ( p != policy::threaded || n <= grain ) return slice( 0, n );
+
+        const size_t chunks = std::min( pool( ).size( ) * 4, ( n + grain - 1 ) / grain );
+        const size_t step = ( n + chunks - 1 ) / chunks;
+        std::vector< T > partial( chunks, init );
+        pool( ).run( chunks, [&]( size_t c ) {
+            const size_t lo = c * step;
+            const size_t hi = std::min( n, lo + step );
+            if ( lo < hi ) partial[ c ] = slice( lo, hi );
+        } );
+        T out = init;
+        for ( const T& part : partial ) out = merge( out, part );
+        return out;
+    }
+
+};
+
+#endif
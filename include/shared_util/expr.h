@@ -0,0 +1,234 @@
+/**
+ * @brief Lazy element-wise expression nodes shared by vect and matrix arithmetic
+ * @author Will Sharpsteen - wisharpsteen@gmail.com
+ */
+#include <cstddef>
+#include <concepts>
+#include <functional>
+#include "exec.h"
+
+#ifndef EXPR_H
+#define EXPR_H
+
+namespace SKAS::expr
+{
+    // an expression knows its length and the execution policy it runs under, and hands out a trivially
+    // copyable evaluator for the host or the device. the fused loop / device kernel calls the evaluator per index,
+    // so a + b * s - c touches each operand once and never materializes the intermediate results.
+    // nodes hold references to their leaf containers: evaluate them (assign to a vect, reduce) before
+    // the operands go out of scope.
+
+    template < typename E >
+    concept expression = requires( const E& e )
+    {
+        typename E::value_type;
+        { e.size( ) } -> std::convertible_to< size_t >;
+        { e.get_policy( ) } -> std::convertible_to< SKAS::exec::policy >;
+        e.host( );
+        e.device( );
+    };
+
+    // -----------------EVALUATORS-----------------
+
+    template < typename T >
+    struct ptr_eval
+    {
+        const T* p;
+
+        auto operator()( const size_t i ) const -> T
+        {
+            return p[ i ];
+        }
+    };
+
+    template < typename T >
+    struct strided_eval
+    {
+        const T* p;
+        size_t stride;
+
+        auto operator()( const size_t i ) const -> T
+        {
+            return p[ i * stride ];
+        }
+    };
+
+    // element i of a rows x cols window, walked row by row, over storage with row stride ld
+    template < typename T >
+    struct window_eval
+    {
+        const T* p;
+        size_t cols;
+        size_t ld;
+
+        auto operator()( const size_t i ) const -> T
+        {
+            return p[ ( i / cols ) * ld + i % cols ];
+        }
+    };
+
+    template < typename Op, typename A, typename B >
+    struct binary_eval
+    {
+        A a;
+        B b;
+
+        auto operator()( const size_t i ) const
+        {
+            return Op{ }( a( i ), b( i ) );
+        }
+    };
+
+    template < typename A, typename T >
+    struct scale_eval
+    {
+        A a;
+        T s;
+
+        auto operator()( const size_t i ) const -> T
+        {
+            return a( i ) * s;
+        }
+    };
+
+    // -----------------NODES-----------------
+
+    /**
+     * @brief leaf referencing a container with size( ), data( ), dev_data( ) and get_policy( )
+     */
+    template < typename C >
+    struct leaf
+    {
+        using value_type = typename C::value_type;
+
+        const C& ref;
+
+        auto size( ) const -> size_t
+        {
+            return ref.size( );
+        }
+
+        auto get_policy( ) const -> SKAS::exec::policy
+        {
+            return ref.get_policy( );
+        }
+
+        auto host( ) const
+        {
+            return ptr_eval< value_type >{ ref.data( ) };
+        }
+
+        auto device( ) const
+        {
+            return ptr_eval< value_type >{ ref.dev_data( ) };
+        }
+    };
+
+    /**
+     * @brief leaf over a rows x cols window of a row-major container, from offset with row stride ld, read row by row
+     */
+    template < typename C >
+    struct window
+    {
+        using value_type = typename C::value_type;
+
+        const C* ref;
+        size_t offset;
+        size_t rows;
+        size_t cols;
+        size_t ld;
+
+        auto size( ) const -> size_t
+        {
+            return rows * cols;
+        }
+
+        auto get_policy( ) const -> SKAS::exec::policy
+        {
+            return ref->get_policy( );
+        }
+
+        auto host( ) const
+        {
+            return window_eval< value_type >{ ref->data( ) + offset, cols, ld };
+        }
+
+        auto device( ) const
+        {
+            return window_eval< value_type >{ ref->dev_data( ) + offset, cols, ld };
+        }
+    };
+
+    /**
+     * @brief element-wise Op( l[ i ], r[ i ] ) under exec::common of both sides' policies
+     */
+    template < typename Op, expression L, expression R >
+    struct binary
+    {
+        using value_type = typename L::value_type;
+
+        L l;
+        R r;
+
+        auto size( ) const -> size_t
+        {
+            return l.size( );
+        }
+
+        auto get_policy( ) const -> SKAS::exec::policy
+        {
+            return SKAS::exec::common( l.get_policy( ), r.get_policy( ) );
+        }
+
+        auto host( ) const
+        {
+            return binary_eval< Op, decltype( l.host( ) ), decltype( r.host( ) ) >{ l.host( ), r.host( ) };
+        }
+
+        auto device( ) const
+        {
+            return binary_eval< Op, decltype( l.device( ) ), decltype( r.device( ) ) >{ l.device( ), r.device( ) };
+        }
+    };
+
+    /**
+     * @brief element-wise e[ i ] * s
+     */
+    template < expression E >
+    struct scaled
+    {
+        using value_type = typename E::value_type;
+
+        E e;
+        value_type s;
+
+        auto size( ) const -> size_t
+        {
+            return e.size( );
+        }
+
+        auto get_policy( ) const -> SKAS::exec::policy
+        {
+            return e.get_policy( );
+        }
+
+        auto host( ) const
+        {
+            return scale_eval< decltype( e.host( ) ), value_type >{ e.host( ), s };
+        }
+
+        auto device( ) const
+        {
+            return scale_eval< decltype( e.device( ) ), value_type >{ e.device( ), s };
+        }
+    };
+
+    template < expression L, expression R >
+    using sum = binary< std::plus< typename L::value_type >, L, R >;
+
+    template < expression L, expression R >
+    using difference = binary< std::minus< typename L::value_type >, L, R >;
+
+};
+
+#endif
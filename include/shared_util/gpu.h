@@ -5,26 +5,554 @@
 #include <sycl/sycl.hpp>
 #include <hipSYCL/algorithms/numeric.hpp>
 #include <hipSYCL/algorithms/algorithm.hpp>
+#include <algorithm>
+#include <array>
+#include <vector>
+#include <unordered_map>
+#include <mutex>
+#include <memory>
+#include <functional>
+#include <bit>
+#include <chrono>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <cstdlib>
+#include <limits>
+#include "exec.h"
 
 #ifndef GPU_H
 #define GPU_H
 
 namespace SKAS::gpu
 {
+    /**
+     * @brief Size-class caching pool for device USM. Blocks are rounded up to a power of two and
+     * kept on a per-class free list when returned, so repeated workloads stop hitting sycl::malloc_device.
+     * Reusing a block right after it is returned is safe because every user submits to the same in-order queue.
+     */
+    class usm_pool
+    {
+        public:
+        struct statistics
+        {
+            size_t device_allocs = 0;   // calls that reached sycl::malloc_device
+            size_t device_frees = 0;    // calls that reached sycl::free
+            size_t hits = 0;            // requests served from a free list
+            size_t misses = 0;          // requests that needed a new block
+            size_t bytes_in_use = 0;
+            size_t bytes_cached = 0;
+            size_t high_water = 0;      // peak bytes_in_use since the last trim( )
+        };
+
+        static constexpr size_t min_block = 256;
+
+        explicit usm_pool( sycl::queue& t_q ) : q( t_q ) { }
+
+        usm_pool( const usm_pool& ) = delete;
+        usm_pool& operator=( const usm_pool& ) = delete;
+
+        ~usm_pool( )
+        {
+            release( );
+        }
+
+        /**
+         * @brief device block able to hold count elements of T
+         */
+        template < typename T >
+        auto allocate( const size_t count ) -> T*
+        {
+            return static_cast< T* >( allocate_bytes( count * sizeof( T ) ) );
+        }
+
+        auto allocate_bytes( const size_t bytes ) -> void*
+        {
+            const size_t size_class = class_of( bytes );
+            const size_t block = size_t{1} << size_class;
+            std::lock_guard< std::mutex > lock( guard );
+            void* ptr;
+            if ( !free_lists[ size_class ].empty( ) )
+            {
+                ptr = free_lists[ size_class ].back( );
+                free_lists[ size_class ].pop_back( );
+                stats_.bytes_cached -= block;
+                ++stats_.hits;
+            }
+            else
+            {
+                ptr = sycl::malloc_device( block, q );
+                ++stats_.device_allocs;
+                ++stats_.misses;
+            }
+            live[ ptr ] = size_class;
+            stats_.bytes_in_use += block;
+            stats_.high_water = std::max( stats_.high_water, stats_.bytes_in_use );
+            return ptr;
+        }
+
+        /**
+         * @brief returns a block to its free list. nullptr is ignored
+         */
+        auto deallocate( void* ptr ) -> void
+        {
+            if ( !ptr ) return;
+            std::lock_guard< std::mutex > lock( guard );
+            auto found = live.find( ptr );
+            if ( found == live.end( ) )
+            {
+                sycl::free( ptr, q );
+                return;
+            }
+            const size_t size_class = found->second;
+            live.erase( found );
+            free_lists[ size_class ].push_back( ptr );
+            stats_.bytes_in_use -= size_t{1} << size_class;
+            stats_.bytes_cached += size_t{1} << size_class;
+        }
+
+        /**
+         * @brief frees cached blocks (largest first) until in-use plus cached bytes fit under the
+         * high-water mark seen since the last trim, then starts a new high-water window
+         */
+        auto trim( ) -> void
+        {
+            std::lock_guard< std::mutex > lock( guard );
+            trim_locked( stats_.high_water );
+            stats_.high_water = stats_.bytes_in_use;
+        }
+
+        /**
+         * @brief frees cached blocks (largest first) until in-use plus cached bytes fit under max_bytes
+         */
+        auto trim( const size_t max_bytes ) -> void
+        {
+            std::lock_guard< std::mutex > lock( guard );
+            trim_locked( max_bytes );
+        }
+
+        /**
+         * @brief frees every cached block
+         */
+        auto release( ) -> void
+        {
+            std::lock_guard< std::mutex > lock( guard );
+            trim_locked( 0 );
+        }
+
+        auto stats( ) const -> statistics
+        {
+            std::lock_guard< std::mutex > lock( guard );
+            return stats_;
+        }
+
+        private:
+        sycl::queue& q;
+        mutable std::mutex guard;
+        std::array< std::vector< void* >, 64 > free_lists;
+        std::unordered_map< void*, size_t > live;
+        statistics stats_;
+
+        static auto class_of( const size_t bytes ) -> size_t
+        {
+            return std::bit_width( std::bit_ceil( std::max( bytes, min_block ) ) ) - 1;
+        }
+
+        auto trim_locked( const size_t max_bytes ) -> void
+        {
+            if ( stats_.bytes_cached ) q.wait( );
+            for ( size_t size_class = free_lists.size( ); size_class-- > 0; )
+            {
+                auto& list = free_lists[ size_class ];
+                while ( !list.empty( ) && stats_.bytes_in_use + stats_.bytes_cached > max_bytes )
+                {
+                    sycl::free( list.back( ), q );
+                    list.pop_back( );
+                    stats_.bytes_cached -= size_t{1} << size_class;
+                    ++stats_.device_frees;
+                }
+            }
+        }
+    };
+
+    /**
+     * @brief device reduction of f( 0 ) ... f( n - 1 ) under op into dev_out. f and op must be trivially copyable
+     * and device-callable, and init must be the identity of op. each work-group folds a strided slice and
+     * tree-reduces it in local memory; a second single-group pass folds the per-group partials
+     */
+    template < typename T, typename F, typename Op >
+    auto transform_reduce_n( sycl::queue& q, usm_pool& pool, const size_t n, F f, Op op, const T init, T* dev_out, const std::vector< sycl::event >& deps = { } ) -> sycl::event
+    {
+        constexpr size_t wg = 256;
+
+        const size_t groups = std::clamp< size_t >( ( n + wg - 1 ) / wg, 1, wg );
+        T* partial = groups == 1 ? dev_out : pool.allocate< T >( groups );
+
+        sycl::event ev = q.submit( [&]( sycl::handler& h ) {
+            h.depends_on( deps );
+            sycl::local_accessor< T, 1 > scratch( sycl::range< 1 >( wg ), h );
+            h.parallel_for( sycl::nd_range< 1 >( groups * wg, wg ), [=]( sycl::nd_item< 1 > it ) {
+                const size_t lid = it.get_local_id( 0 );
+                T acc = init;
+                for ( size_t i = it.get_global_id( 0 ); i < n; i += groups * wg ) acc = op( acc, f( i ) );
+                scratch[ lid ] = acc;
+                for ( size_t stride = wg / 2; stride > 0; stride /= 2 )
+                {
+                    sycl::group_barrier( it.get_group( ) );
+                    if ( lid < stride ) scratch[ lid ] = op( scratch[ lid ], scratch[ lid + stride ] );
+                }
+                if ( lid == 0 ) partial[ it.get_group( 0 ) ] = scratch[ 0 ];
+            } );
+        } );
+        if ( groups == 1 ) return ev;
+
+        ev = q.submit( [&]( sycl::handler& h ) {
+            sycl::local_accessor< T, 1 > scratch( sycl::range< 1 >( wg ), h );
+            h.parallel_for( sycl::nd_range< 1 >( wg, wg ), [=]( sycl::nd_item< 1 > it ) {
+                const size_t lid = it.get_local_id( 0 );
+                scratch[ lid ] = lid < groups ? partial[ lid ] : init;
+                for ( size_t stride = wg / 2; stride > 0; stride /= 2 )
+                {
+                    sycl::group_barrier( it.get_group( ) );
+                    if ( lid < stride ) scratch[ lid ] = op( scratch[ lid ], scratch[ lid + stride ] );
+                }
+                if ( lid == 0 ) *dev_out = scratch[ 0 ];
+            } );
+        } );
+        pool.deallocate( partial );
+        return ev;
+    }
+
+    /**
+     * @brief kinds of work that automatic dispatch keeps separate crossover sizes for
+     */
+    enum class op_kind
+    {
+        elementwise,    // work = element count
+        reduction,      // work = element count
+        matmul,         // work = rows * inner * cols
+        count
+    };
+
+    /**
+     * @brief crossover sizes used to resolve exec::policy::automatic. an op of work w runs on the device
+     * from device_from, host-threaded from threaded_from, and host-simd below both
+     */
+    struct dispatch_table
+    {
+        static constexpr size_t never = std::numeric_limits< size_t >::max( );
+        static constexpr size_t kinds = static_cast< size_t >( op_kind::count );
+
+        std::string device_name;
+        std::array< size_t, kinds > threaded_from{ never, never, never };
+        std::array< size_t, kinds > device_from{ never, never, never };
+
+        auto threaded( const op_kind k ) -> size_t&
+        {
+            return threaded_from[ static_cast< size_t >( k ) ];
+        }
+
+        auto device( const op_kind k ) -> size_t&
+        {
+            return device_from[ static_cast< size_t >( k ) ];
+        }
+
+        auto operator==( const dispatch_table& ) const -> bool = default;
+    };
+
+    /**
+     * @brief writes a dispatch table to path so later runs on the same device can skip calibration
+     */
+    inline auto save_dispatch( const dispatch_table& table, const std::string& path ) -> bool
+    {
+        std::ofstream out( path );
+        if ( !out ) return false;
+        out << "SKAS-dispatch 1\n" << table.device_name << "\n";
+        for ( size_t k = 0; k < dispatch_table::kinds; ++k ) out << table.threaded_from[ k ] << " " << table.device_from[ k ] << "\n";
+        return bool( out );
+    }
+
+    /**
+     * @brief reads a table written by save_dispatch. empty if the file is missing, malformed or was measured on another device
+     */
+    inline auto load_dispatch( const std::string& path, const std::string& device_name ) -> std::optional< dispatch_table >
+    {
+        std::ifstream in( path );
+        std::string header;
+        dispatch_table table;
+        if ( !in || !std::getline( in, header ) || header != "SKAS-dispatch 1" ) return std::nullopt;
+        if ( !std::getline( in, table.device_name ) || table.device_name != device_name ) return std::nullopt;
+        for ( size_t k = 0; k < dispatch_table::kinds; ++k )
+        {
+            if ( !( in >> table.threaded_from[ k ] >> table.device_from[ k ] ) ) return std::nullopt;
+        }
+        return table;
+    }
+
+    /**
+     * @brief short start-up benchmark of each op kind on the host (simd, threaded) and on q. sizes grow
+     * until the device wins twice in a row or any backend's run exceeds the time budget
+     */
+    inline auto calibrate( sycl::queue& q, usm_pool& pool ) -> dispatch_table
+    {
+        using clock = std::chrono::steady_clock;
+        constexpr double budget = 0.02; // seconds per measured run
+        constexpr size_t max_elems = size_t{1} << 22;
+
+        dispatch_table table;
+        table.device_name = q.get_device( ).get_info< sycl::info::device::name >( );
+
+        auto time = []( auto&& run ) -> double {
+            run( ); // warm-up: first touch, kernel JIT, pool fill
+            double best = std::numeric_limits< double >::max( );
+            for ( int rep = 0; rep < 2; ++rep )
+            {
+                const auto start = clock::now( );
+                run( );
+                best = std::min( best, std::chrono::duration< double >( clock::now( ) - start ).count( ) );
+            }
+            return best;
+        };
+
+        // scan( work_of_step, host_run( policy, step ), device_run( step ) ) fills one row of the table
+        auto scan = [&]( const op_kind kind, const size_t steps, auto work_of, auto host_run, auto device_run ) {
+            int device_wins = 0;
+            for ( size_t step = 0; step < steps; ++step )
+            {
+                const size_t work = work_of( step );
+                const double simd = time( [&]( ) { host_run( exec::policy::simd, step ); } );
+                const double threaded = time( [&]( ) { host_run( exec::policy::threaded, step ); } );
+                const double device = time( [&]( ) { device_run( step ); } );
+                // threads have to pay off clearly at every size from the threshold up, not win once by timer noise
+                if ( threaded < 0.8 * simd )
+                {
+                    if ( table.threaded( kind ) == dispatch_table::never ) table.threaded( kind ) = work;
+                }
+                else
+                {
+                    table.threaded( kind ) = dispatch_table::never;
+                }
+                if ( device < std::min( simd, threaded ) )
+                {
+                    if ( ++device_wins == 1 ) table.device( kind ) = work;
+                    if ( device_wins == 2 ) break;
+                }
+                else
+                {
+                    device_wins = 0;
+                    table.device( kind ) = dispatch_table::never;
+                }
+                if ( std::max( { simd, threaded, device } ) > budget ) break;
+            }
+        };
+
+        std::vector< float > a( max_elems, 1.0f ), b( max_elems, 2.0f ), c( max_elems );
+        float* dev_a = pool.allocate< float >( max_elems );
+        float* dev_b = pool.allocate< float >( max_elems );
+        float* dev_c = pool.allocate< float >( max_elems );
+        q.memcpy( dev_a, a.data( ), sizeof( float ) * max_elems );
+        q.memcpy( dev_b, b.data( ), sizeof( float ) * max_elems ).wait( );
+
+        auto elems = []( size_t step ) { return size_t{1} << ( 6 + 2 * step ); };
+        const size_t elem_steps = 9; // 2^6 .. 2^22
+
+        scan( op_kind::elementwise, elem_steps, elems,
+            [&]( exec::policy p, size_t step ) {
+                float* pa = a.data( ); float* pb = b.data( ); float* pc = c.data( );
+                exec::for_n( p, elems( step ), [=]( size_t i ) { pc[ i ] = pa[ i ] + pb[ i ]; } );
+            },
+            [&]( size_t step ) {
+                q.parallel_for( sycl::range< 1 >( elems( step ) ), [=]( sycl::id< 1 > i ) { dev_c[ i ] = dev_a[ i ] + dev_b[ i ]; } ).wait( );
+            } );
+
+        scan( op_kind::reduction, elem_steps, elems,
+            [&]( exec::policy p, size_t step ) {
+                const float* pa = a.data( ); const float* pb = b.data( );
+                volatile float sink = exec::reduce_n( p, elems( step ), 0.0f, [=]( float& acc, size_t i ) { acc += pa[ i ] * pb[ i ]; }, std::plus< float >( ) );
+                ( void )sink;
+            },
+            [&]( size_t step ) {
+                float out;
+                transform_reduce_n( q, pool, elems( step ), [=]( size_t i ) { return dev_a[ i ] * dev_b[ i ]; }, std::plus< float >( ), 0.0f, dev_c ).wait( );
+                q.memcpy( &out, dev_c, sizeof( float ) ).wait( );
+            } );
+
+        auto dim = []( size_t step ) { return size_t{8} << step; };
+        scan( op_kind::matmul, 7, [&]( size_t step ) { return dim( step ) * dim( step ) * dim( step ); }, // 8^3 .. 512^3
+            [&]( exec::policy p, size_t step ) {
+                const size_t d = dim( step );
+                const float* pa = a.data( ); const float* pb = b.data( ); float* pc = c.data( );
+                exec::for_chunks( p, d, 1, [=]( size_t lo, size_t hi ) {
+                    for ( size_t i = lo; i < hi; ++i )
+                    {
+                        for ( size_t j = 0; j < d; ++j ) pc[ i * d + j ] = 0;
+                        for ( size_t k = 0; k < d; ++k )
+                        {
+                            SKAS_SIMD
+                            for ( size_t j = 0; j < d; ++j ) pc[ i * d + j ] += pa[ i * d + k ] * pb[ k * d + j ];
+                        }
+                    }
+                } );
+            },
+            [&]( size_t step ) {
+                const size_t d = dim( step );
+                q.parallel_for( sycl::range< 2 >( d, d ), [=]( sycl::id< 2 > idx ) {
+                    float sum = 0;
+                    for ( size_t k = 0; k < d; ++k ) sum += dev_a[ idx[ 0 ] * d + k ] * dev_b[ k * d + idx[ 1 ] ];
+                    dev_c[ idx[ 0 ] * d + idx[ 1 ] ] = sum;
+                } ).wait( );
+            } );
+
+        pool.deallocate( dev_a );
+        pool.deallocate( dev_b );
+        pool.deallocate( dev_c );
+        pool.trim( 0 );
+        return table;
+    }
+
+    /**
+     * @brief dispatch table for q: read from $SKAS_DISPATCH_CACHE when it matches the device, otherwise
+     * calibrated now (and written there if the variable is set)
+     */
+    inline auto load_or_calibrate( sycl::queue& q, usm_pool& pool ) -> dispatch_table
+    {
+        const char* cache = std::getenv( "SKAS_DISPATCH_CACHE" );
+        const std::string device_name = q.get_device( ).get_info< sycl::info::device::name >( );
+        if ( cache )
+        {
+            if ( auto table = load_dispatch( cache, device_name ) ) return *table;
+        }
+        dispatch_table table = calibrate( q, pool );
+        if ( cache ) save_dispatch( table, cache );
+        return table;
+    }
+
+    /**
+     * @brief process-wide queue, allocation state and dispatch table. the first call runs calibrate( )
+     * (or loads its cached result), so later automatic-policy ops can pick host or device per call
+     */
     struct gpu_context
     {
         sycl::queue q;
         hipsycl::algorithms::util::allocation_group ag;
+        usm_pool pool;
+        dispatch_table dispatch;
 
-        gpu_context() : q{sycl::property::queue::in_order{}}, ag{} {}
+        gpu_context() : q{sycl::property::queue::in_order{}}, ag{}, pool{q}, dispatch{ load_or_calibrate( q, pool ) } {}
     };
 
-    inline gpu_context& ctx( ) 
+    inline gpu_context& ctx( )
     {
         static gpu_context instance{ };
         return instance;
     }
 
+    /**
+     * @brief concrete policy for an op of the given kind and work. anything but exec::policy::automatic passes through
+     */
+    inline auto resolve( const exec::policy p, const op_kind kind, const size_t work ) -> exec::policy
+    {
+        if ( p != exec::policy::automatic ) return p;
+        auto& table = ctx( ).dispatch;
+        if ( work >= table.device( kind ) ) return exec::policy::device;
+        if ( work >= table.threaded( kind ) ) return exec::policy::threaded;
+        return exec::policy::simd;
+    }
+
+    /**
+     * @brief device reduction of f( 0 ) ... f( n - 1 ) under op into dev_out, see the overload below
+     */
+    template < typename T, typename F, typename Op >
+    auto transform_reduce_n( const size_t n, F f, Op op, const T init, T* dev_out, const std::vector< sycl::event >& deps = { } ) -> sycl::event
+    {
+        return transform_reduce_n( ctx( ).q, ctx( ).pool, n, f, op, init, dev_out, deps );
+    }
+
+    /**
+     * @brief future-like handle to the result of an accelerated op that was submitted without blocking.
+     * event( ) can be passed as a dependency to further async ops, and result( ) hands out the (device-resident)
+     * result object for chaining before it is ready. wait( ) blocks once and returns the finished result.
+     */
+    template < typename R >
+    class pending
+    {
+        private:
+        sycl::event ev;
+        std::shared_ptr< R > value;
+        std::function< void( R& ) > finish;
+        bool done;
+
+        /**
+         * @brief waits for the op if this is the last handle on a result it may still be writing
+         */
+        auto settle( ) -> void
+        {
+            if ( !done && value && value.use_count( ) == 1 ) ev.wait( );
+        }
+
+        public:
+        pending( sycl::event t_ev, std::shared_ptr< R > t_value, std::function< void( R& ) > t_finish = { } )
+            : ev( t_ev ), value( std::move( t_value ) ), finish( std::move( t_finish ) ), done( false ) { }
+
+        pending( const pending& ) = default;
+        pending( pending&& ) = default;
+
+        pending& operator=( pending other )
+        {
+            settle( );
+            ev = other.ev;
+            value = std::move( other.value );
+            finish = std::move( other.finish );
+            done = other.done;
+            return *this;
+        }
+
+        // a handle dropped before wait( ) must not free the result while the op is still writing into it
+        ~pending( )
+        {
+            settle( );
+        }
+
+        auto event( ) const -> sycl::event
+        {
+            return ev;
+        }
+
+        /**
+         * @brief result object before completion. only safe to hand to other ops on gpu::ctx( ).q
+         */
+        auto result( ) -> R&
+        {
+            return *value;
+        }
+
+        auto is_done( ) const -> bool
+        {
+            return done;
+        }
+
+        auto wait( ) -> R&
+        {
+            if ( !done )
+            {
+                ev.wait( );
+                if ( finish ) finish( *value );
+                done = true;
+            }
+            return *value;
+        }
+    };
+
+    /**
+     * @brief single queue sync for a whole batch of pending results
+     */
+    template < typename... R >
+    auto wait_all( pending< R >&... handles ) -> void
+    {
+        ctx( ).q.wait( );
+        ( handles.wait( ), ... );
+    }
+
 };
 
 
@@ -30,19 +30,85 @@ namespace SKAS::util
         return [scalar]( T2 x ) { return x * scalar; };
     }
 
-    //used in vect.h for PV_cov()
-    template < SKAS::FlAd T1, SKAS::FlAd T2 >
-    auto tsum( const T1& aavg, const T2& bavg )
+    /**
+     * @brief running first and second moments of a pair of samples. push( ) is Welford's update,
+     * merge combines two partial results (Chan et al.), so the same struct serves the sequential loop
+     * and the device tree reduction in one pass over the data
+     */
+    template < SKAS::FlAd T >
+    struct moments
     {
-        return [aavg,bavg]( T1 ai, T2 bi ) { return (ai-aavg)*(bi-bavg); };
-    }
+        size_t n = 0;
+        T mean_a = 0;
+        T mean_b = 0;
+        T m2_a = 0; // sum of squared deviations of a
+        T m2_b = 0; // sum of squared deviations of b
+        T c_ab = 0; // sum of co-deviations of a and b
+
+        static auto of( const T a, const T b ) -> moments
+        {
+            return moments{ 1, a, b, 0, 0, 0 };
+        }
+
+        auto push( const T a, const T b ) -> void
+        {
+            ++n;
+            const T da = a - mean_a;
+            const T db = b - mean_b;
+            mean_a += da / n;
+            mean_b += db / n;
+            m2_a += da * ( a - mean_a );
+            m2_b += db * ( b - mean_b );
+            c_ab += da * ( b - mean_b );
+        }
+
+        static auto merge( const moments& x, const moments& y ) -> moments
+        {
+            if ( !x.n ) return y;
+            if ( !y.n ) return x;
+            moments out;
+            out.n = x.n + y.n;
+            const T w = T( x.n ) * T( y.n ) / T( out.n );
+            const T da = y.mean_a - x.mean_a;
+            const T db = y.mean_b - x.mean_b;
+            out.mean_a = x.mean_a + da * T( y.n ) / T( out.n );
+            out.mean_b = x.mean_b + db * T( y.n ) / T( out.n );
+            out.m2_a = x.m2_a + y.m2_a + da * da * w;
+            out.m2_b = x.m2_b + y.m2_b + db * db * w;
+            out.c_ab = x.c_ab + y.c_ab + da * db * w;
+            return out;
+        }
+
+        auto s2_a( ) const -> T
+        {
+            return n > 1 ? m2_a / ( n - 1 ) : T{0};
+        }
 
-    //used in vect.h for PV_s2()
-    template < SKAS::FlAd T1 >
-    auto ssum( const T1& aavg )
+        auto s2_b( ) const -> T
+        {
+            return n > 1 ? m2_b / ( n - 1 ) : T{0};
+        }
+
+        auto cov( ) const -> T
+        {
+            return n > 1 ? c_ab / ( n - 1 ) : T{0};
+        }
+
+        auto corr( ) const -> T
+        {
+            return c_ab / std::sqrt( m2_a * m2_b );
+        }
+    };
+
+    //used in vect.h for the device moments reduction
+    template < SKAS::FlAd T >
+    struct moments_merge
     {
-        return [aavg]( T1 ai ) { return (ai-aavg)*(ai-aavg); };
-    }
+        auto operator()( const moments< T >& x, const moments< T >& y ) const -> moments< T >
+        {
+            return moments< T >::merge( x, y );
+        }
+    };
 
 };
 
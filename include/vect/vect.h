@@ -5,6 +5,10 @@
 
 #include <vector>
 #include <iostream>
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <functional>
 #include <concepts>
 #include <type_traits>
 #include <typeinfo>
@@ -15,6 +19,8 @@
 #include "gpu.h"
 #include "templates.h"
 #include "util.h"
+#include "expr.h"
+#include "exec.h"
 
 
 #ifndef VECT_H 
@@ -24,159 +30,444 @@ namespace SKAS::vect
 {
 
     /**
-     * @brief Wrapper of std::vector class with supplemental utility and parallelization support
+     * @brief where the current values of a vect live
+     */
+    enum class residency
+    {
+        host,   // host copy is current, device mirror is stale or absent
+        device, // device mirror is current, host copy is stale
+        synced  // host copy and device mirror hold the same values
+    };
+
+    /**
+     * @brief Wrapper of std::vector class with supplemental utility and parallelization support.
+     * Each vect carries an exec::policy that picks the backend of the operations it takes part in.
+     * A vect may own a persistent device mirror of its values. Accelerated operations read and write
+     * the mirror directly, and values only travel back to the host when host-side access needs them.
      */
     template < SKAS::FlAd T >
     class vect
     {
         private:
-        bool parallel;
+        /**
+         * @brief values of a vect and their device mirror. copies of a vect share one buffer until one of them
+         * is written (see detach( )), so passing, returning and comparing vects is O( 1 ). const access may
+         * still sync a shared buffer, so copies must not be used from different threads without synchronization
+         */
+        struct buffer
+        {
+            std::vector< T > interior;
+            T* dev_interior = nullptr;
+            size_t dev_capacity = 0;
+            residency state = residency::host;
+            sycl::event upload;
 
-        public:
-        std::vector< T > interior;
+            buffer( ) = default;
 
-        vect( ) : parallel( false ) { };
+            explicit buffer( std::vector< T > values ) : interior( std::move( values ) ) { }
 
-        ~vect( ) { }
+            buffer( const buffer& ) = delete;
+            buffer& operator=( const buffer& ) = delete;
+
+            ~buffer( )
+            {
+                upload.wait( );
+                if ( dev_interior ) gpu::ctx( ).pool.deallocate( dev_interior );
+            }
+        };
 
-        vect( const vect& orig ) : parallel( false )
+        exec::policy pol;
+        std::shared_ptr< buffer > buf;
+
+        /**
+         * @brief one empty buffer shared by every empty vect, so constructing, moving from and returning empty
+         * vects does not allocate. the first write detaches from it like from any shared buffer. never freed,
+         * so it cannot outlive gpu::ctx( )
+         */
+        static auto empty_buffer( ) -> const std::shared_ptr< buffer >&
         {
-            interior = orig.interior;
-            parallel = orig.parallel;
+            static const auto* instance = new std::shared_ptr< buffer >( std::make_shared< buffer >( ) );
+            return *instance;
         }
 
-        vect( const size_t dim, bool parallel = false )
+        /**
+         * @brief makes sure the device mirror can hold size( ) elements. contents are not preserved on growth
+         */
+        auto reserve_device( ) const -> void
         {
-            std::vector< T > t_interior( dim );
-            interior = t_interior;
-            parallel = parallel;
+            if ( buf->dev_interior && buf->dev_capacity >= buf->interior.size( ) ) return;
+            auto& pool = gpu::ctx( ).pool;
+            pool.deallocate( buf->dev_interior );
+            buf->dev_capacity = std::max( buf->interior.size( ), size_t{1} );
+            buf->dev_interior = pool.allocate< T >( buf->dev_capacity );
         }
 
-        vect( const size_t dim, const T init_value, bool parallel = false )
+        /**
+         * @brief brings the device mirror up to date with the host copy
+         */
+        auto sync_device( ) const -> void
         {
-            std::vector< T > t_interior( dim, init_value );
-            interior = t_interior;
-            parallel = parallel;
+            if ( buf->state != residency::host || buf->interior.empty( ) ) return;
+            reserve_device( );
+            buf->upload = gpu::ctx( ).q.memcpy( buf->dev_interior, buf->interior.data( ), sizeof( T ) * buf->interior.size( ) );
+            buf->state = residency::synced;
         }
-        
-        vect( const std::vector< T >& orig, const bool& par ) : parallel( false )
+
+        /**
+         * @brief brings the host copy up to date with the device mirror
+         */
+        auto sync_host( ) const -> void
         {
-            interior = orig;
-            parallel = par;
+            if ( buf->state != residency::device ) return;
+            if ( !buf->interior.empty( ) ) gpu::ctx( ).q.memcpy( buf->interior.data( ), buf->dev_interior, sizeof( T ) * buf->interior.size( ) ).wait( );
+            buf->state = residency::synced;
         }
 
-        vect( const std::vector< T >& orig ) : parallel( false )
+        /**
+         * @brief host copy is about to be written, so the device mirror goes stale
+         */
+        auto touch_host( ) -> void
         {
-            interior = orig;
-            parallel = false;
+            detach( );
+            sync_host( );
+            buf->upload.wait( );
+            buf->state = residency::host;
         }
 
-        vect& operator=( const vect& other )
+        /**
+         * @brief gives this vect sole ownership of its buffer before a write. a shared buffer is cloned
+         * where its current values live, so a device-resident copy never round-trips through the host
+         */
+        auto detach( ) -> void
         {
-            if ( this != &other )
+            if ( buf.use_count( ) == 1 ) return;
+            std::shared_ptr< buffer > shared = std::move( buf );
+            buf = std::make_shared< buffer >( );
+            if ( shared->state == residency::device )
             {
-                interior = other.interior;
-                parallel = other.parallel;
+                buf->interior.resize( shared->interior.size( ) );
+                reserve_device( );
+                gpu::ctx( ).q.memcpy( buf->dev_interior, shared->dev_interior, sizeof( T ) * buf->interior.size( ) ).wait( );
+                buf->state = residency::device;
             }
+            else
+            {
+                buf->interior = shared->interior;
+            }
+        }
+
+        /**
+         * @brief detach( ) for writes that overwrite every element: a shared buffer is swapped for a fresh one of the same size without copying
+         */
+        auto orphan( ) -> void
+        {
+            if ( buf.use_count( ) > 1 ) buf = std::make_shared< buffer >( std::vector< T >( buf->interior.size( ) ) );
+        }
+
+        /**
+         * @brief evaluates an element-wise expression into this vect in one fused pass under the
+         * expression's policy, which the result then carries
+         */
+        template < SKAS::expr::expression E >
+        auto assign( const E& expression ) -> void
+        {
+            const size_t n = expression.size( );
+            const exec::policy p = gpu::resolve( expression.get_policy( ), gpu::op_kind::elementwise, n );
+            if ( p == exec::policy::device )
+            {
+                auto ev = expression.device( );
+                if ( buf->interior.size( ) != n )
+                {
+                    orphan( );
+                    touch_host( );
+                    buf->interior.resize( n );
+                }
+                T* out = dev_discard( );
+                if ( n ) gpu::ctx( ).q.parallel_for( sycl::range< 1 >( n ), [=]( sycl::id< 1 > i ) { out[ i ] = ev( i ); } ).wait( );
+            }
+            else
+            {
+                auto ev = expression.host( );
+                orphan( );
+                touch_host( );
+                buf->interior.resize( n );
+                T* out = buf->interior.data( );
+                exec::for_n( p, n, [=]( size_t i ) { out[ i ] = ev( i ); } );
+            }
+            pol = expression.get_policy( );
+        }
+
+        public:
+        using value_type = T;
+
+        vect( ) : pol( exec::policy::seq ), buf( empty_buffer( ) ) { };
+
+        template < SKAS::expr::expression E >
+            requires std::same_as< typename E::value_type, T >
+        vect( const E& expression ) : pol( exec::policy::seq ), buf( empty_buffer( ) )
+        {
+            assign( expression );
+        }
+
+        template < SKAS::expr::expression E >
+            requires std::same_as< typename E::value_type, T >
+        vect& operator=( const E& expression )
+        {
+            assign( expression );
             return *this;
         }
 
-        vect& operator=( const std::vector< T >& other )
+        ~vect( ) = default;
+
+        vect( const vect& orig ) : pol( orig.pol ), buf( orig.buf ) { }
+
+        /**
+         * @brief takes orig's buffer without touching the values. orig is left empty
+         */
+        vect( vect&& orig ) noexcept : pol( orig.pol ), buf( std::exchange( orig.buf, empty_buffer( ) ) ) { }
+
+        vect( const size_t dim, const exec::policy t_policy ) 
+            : pol( t_policy ), buf( std::make_shared< buffer >( std::vector< T >( dim ) ) ) { }
+
+        vect( const size_t dim, bool t_parallel = false ) : vect( dim, exec::of( t_parallel ) ) { }
+
+        vect( const size_t dim, const T init_value, const exec::policy t_policy )
+            : pol( t_policy ), buf( std::make_shared< buffer >( std::vector< T >( dim, init_value ) ) ) { }
+
+        vect( const size_t dim, const T init_value, bool t_parallel = false ) : vect( dim, init_value, exec::of( t_parallel ) ) { }
+
+        vect( const std::vector< T >& orig, const exec::policy t_policy ) 
+            : pol( t_policy ), buf( std::make_shared< buffer >( orig ) ) { }
+
+        vect( const std::vector< T >& orig, const bool& par ) : vect( orig, exec::of( par ) ) { }
+
+        /**
+         * @brief takes orig's allocation instead of copying it
+         */
+        vect( std::vector< T >&& orig, const exec::policy t_policy )
+            : pol( t_policy ), buf( std::make_shared< buffer >( std::move( orig ) ) ) { }
+
+        vect( const std::vector< T >& orig ) 
+            : pol( exec::policy::seq ), buf( std::make_shared< buffer >( orig ) ) { }
+
+        vect( std::vector< T >&& orig ) : vect( std::move( orig ), exec::policy::seq ) { }
+
+        vect& operator=( const vect& other )
         {
-            interior = other;
-            parallel = false;
+            pol = other.pol;
+            buf = other.buf;
             return *this;
         }
 
-        vect( const std::initializer_list< T > init, const bool& t_parallel = false )
+        vect& operator=( vect&& other ) noexcept
         {
-            interior = init;
-            parallel = t_parallel;
+            if ( this != &other )
+            {
+                pol = other.pol;
+                buf = std::exchange( other.buf, empty_buffer( ) );
+            }
+            return *this;
         }
 
-        vect( const bool& t_parallel )
+        vect& operator=( const std::vector< T >& other )
         {
-            parallel = t_parallel;
+            orphan( );
+            touch_host( );
+            buf->interior = other;
+            return *this;
         }
 
+        vect( const std::initializer_list< T > init, const exec::policy t_policy )
+            : pol( t_policy ), buf( std::make_shared< buffer >( std::vector< T >( init ) ) ) { }
+
+        vect( const std::initializer_list< T > init, const bool& t_parallel = false ) : vect( init, exec::of( t_parallel ) ) { }
+
+        vect( const exec::policy t_policy ) : pol( t_policy ), buf( empty_buffer( ) ) { }
+
+        vect( const bool& t_parallel ) : vect( exec::of( t_parallel ) ) { }
+
         auto clear( ) -> void
         {
-            interior.clear( );
+            touch_host( );
+            buf->interior.clear( );
         }
 
         auto push_back( const T& obj ) -> void
         {
-            interior.push_back( obj );
+            touch_host( );
+            buf->interior.push_back( obj );
         }
 
         auto size( ) const -> size_t
         {
-            return interior.size( );
+            return buf->interior.size( );
         }
 
         auto erase( std::vector< T >::iterator first, std::vector< T >::iterator last ) -> void
         {
-            interior.erase( first, last );
+            touch_host( );
+            buf->interior.erase( first, last );
         }
 
         auto begin( ) -> std::vector< T >::iterator
         {
-            return interior.begin( );
+            touch_host( );
+            return buf->interior.begin( );
         }
 
         auto begin( ) const -> std::vector< T >::const_iterator
         {
-            return interior.begin( );
+            sync_host( );
+            return buf->interior.begin( );
         }
 
         auto end( ) -> std::vector< T >::iterator
         {
-            return interior.end( );
+            touch_host( );
+            return buf->interior.end( );
         }
 
         auto end( ) const -> std::vector< T >::const_iterator
         {
-            return interior.end( );
+            sync_host( );
+            return buf->interior.end( );
         }
 
         auto insert( std::vector< T >::const_iterator position, const T& val ) -> void
         {
-            interior.insert( position, val );
+            touch_host( );
+            buf->interior.insert( position, val );
         }
 
         auto insert( std::vector< T >::iterator position, const T& val ) -> void
         {
-            interior.insert( position, val );
+            touch_host( );
+            buf->interior.insert( position, val );
+        }
+
+        /**
+         * @brief inserts [ first, last ) before position. growth is amortized, so appending at end( ) in a loop is linear overall
+         */
+        template < typename It >
+        auto insert( std::vector< T >::const_iterator position, It first, It last ) -> void
+        {
+            touch_host( );
+            buf->interior.insert( position, first, last );
+        }
+
+        auto resize( const size_t count ) -> void
+        {
+            touch_host( );
+            buf->interior.resize( count );
+        }
+
+        /**
+         * @brief makes room for count elements on the host without changing size( ), so later growth up to it does not reallocate
+         */
+        auto reserve( const size_t count ) -> void
+        {
+            touch_host( );
+            buf->interior.reserve( count );
+        }
+
+        auto capacity( ) const -> size_t
+        {
+            return buf->interior.capacity( );
         }
 
         auto operator[]( const size_t& index ) -> T&
         {
-            return interior[ index ];
+            touch_host( );
+            return buf->interior[ index ];
         }
 
         auto operator[]( const size_t& index ) const -> const T&
         {
-            return interior[ index ];
+            sync_host( );
+            return buf->interior[ index ];
         }
 
         auto data( ) -> T*
         {
-            return interior.data( );
+            touch_host( );
+            return buf->interior.data( );
         }
 
         auto data( ) const -> const T*
         {
-            return interior.data( );
+            sync_host( );
+            return buf->interior.data( );
         }
 
         auto enddata( ) -> T*
         {
-            return interior.data( ) + interior.size( );
+            touch_host( );
+            return buf->interior.data( ) + buf->interior.size( );
         }
 
         auto enddata( ) const -> const T*
         {
-            return interior.data( ) + interior.size( );
+            sync_host( );
+            return buf->interior.data( ) + buf->interior.size( );
+        }
+
+        /**
+         * @brief device pointer to the current values, uploading them first if the mirror is stale
+         */
+        auto dev_data( ) const -> const T*
+        {
+            sync_device( );
+            return buf->dev_interior;
+        }
+
+        /**
+         * @brief device pointer for in-place device writes. the host copy goes stale
+         */
+        auto dev_data( ) -> T*
+        {
+            detach( );
+            sync_device( );
+            buf->state = residency::device;
+            return buf->dev_interior;
+        }
+
+        /**
+         * @brief device pointer for results that overwrite every element. skips the upload
+         */
+        auto dev_discard( ) -> T*
+        {
+            orphan( );
+            reserve_device( );
+            buf->state = residency::device;
+            return buf->dev_interior;
+        }
+
+        /**
+         * @brief whether this vect and other are copies sharing one buffer
+         */
+        auto shares( const vect& other ) const -> bool
+        {
+            return buf == other.buf;
+        }
+
+        /**
+         * @brief where the current values live
+         */
+        auto residence( ) const -> residency
+        {
+            return buf->state;
+        }
+
+        /**
+         * @brief pulls values back to the host and frees the device mirror
+         */
+        auto release_device( ) -> void
+        {
+            sync_host( );
+            if ( buf->dev_interior ) gpu::ctx( ).pool.deallocate( buf->dev_interior );
+            buf->dev_interior = nullptr;
+            buf->dev_capacity = 0;
+            buf->state = residency::host;
         }
 
         /**
@@ -184,37 +475,52 @@ namespace SKAS::vect
          */
         auto is_parallel( ) const -> bool
         {
-            return parallel;
+            return pol == exec::policy::device;
+        }
+
+        /**
+         * @brief execution policy of operations on this vect
+         */
+        auto get_policy( ) const -> exec::policy
+        {
+            return pol;
+        }
+
+        auto set_policy( const exec::policy t_policy ) -> void
+        {
+            pol = t_policy;
         }
 
         auto toPar( ) -> void
         {
-            parallel = true;
+            pol = exec::policy::device;
         }
 
         auto toSeq( ) -> void
         {
-            parallel = false;
+            pol = exec::policy::seq;
         }
 
         auto flipParSeqMode( ) -> void
         {
-            parallel = !parallel;
+            pol = is_parallel( ) ? exec::policy::seq : exec::policy::device;
         }
 
         auto toVect( ) -> std::vector< T >
         {
-            return interior;
+            sync_host( );
+            return buf->interior;
         }
 
-        auto toVect( ) const -> const std::vector< T >
+        auto toVect( ) const -> std::vector< T >
         {
-            return interior;
+            sync_host( );
+            return buf->interior;
         }
 
         auto isEmpty( ) const -> bool
         {
-            return interior.empty( );
+            return buf->interior.empty( );
         }
 
     };
@@ -245,104 +551,220 @@ namespace SKAS::vect::accel_vect
 
     template < SKAS::FlAd T1 >
     auto PV_mean( const SKAS::vect::vect< T1 >& a ) -> T1;
+
+    template < SKAS::FlAd T1 >
+    auto PV_moments( const SKAS::vect::vect< T1 >& a, const SKAS::vect::vect< T1 >& b ) -> SKAS::util::moments< T1 >;
+
+    template < typename T, typename Launch >
+    auto PV_scalar_async( Launch launch, std::function< void( T& ) > finish = { } ) -> gpu::pending< T >;
+
+    // non-blocking variants. each returns as soon as its work is queued on gpu::ctx( ).q after deps.
+    // operands must stay alive until the returned handle has completed.
+
+    template < SKAS::FlAd T1 >
+    auto PV_add_async( const SKAS::vect::vect< T1 >& a, const SKAS::vect::vect< T1 >& b, const std::vector< sycl::event >& deps = { } ) -> gpu::pending< SKAS::vect::vect< T1 > >;
+
+    template < SKAS::FlAd T1 >
+    auto PV_sub_async( const SKAS::vect::vect< T1 >& a, const SKAS::vect::vect< T1 >& b, const std::vector< sycl::event >& deps = { } ) -> gpu::pending< SKAS::vect::vect< T1 > >;
+
+    template < SKAS::FlAd T1 >
+    auto PV_scale_async( const SKAS::vect::vect< T1 >& a, const T1 scalar, const std::vector< sycl::event >& deps = { } ) -> gpu::pending< SKAS::vect::vect< T1 > >;
+
+    template < SKAS::FlAd T1 >
+    auto PV_dot_async( const SKAS::vect::vect< T1 >& a, const SKAS::vect::vect< T1 >& b, const std::vector< sycl::event >& deps = { } ) -> gpu::pending< T1 >;
+
+    template < SKAS::FlAd T >
+    auto PV_mag_async( const SKAS::vect::vect< T >& a, const std::vector< sycl::event >& deps = { } ) -> gpu::pending< T >;
+
+    template < SKAS::FlAd T1 >
+    auto PV_cov_async( const SKAS::vect::vect< T1 >& a, const SKAS::vect::vect< T1 >& b, const std::vector< sycl::event >& deps = { } ) -> gpu::pending< T1 >;
+
+    template < SKAS::FlAd T1 >
+    auto PV_s2_async( const SKAS::vect::vect< T1 >& a, const std::vector< sycl::event >& deps = { } ) -> gpu::pending< T1 >;
+
+    template < SKAS::FlAd T1 >
+    auto PV_mean_async( const SKAS::vect::vect< T1 >& a, const std::vector< sycl::event >& deps = { } ) -> gpu::pending< T1 >;
+
+    template < SKAS::FlAd T1 >
+    auto PV_moments_async( const SKAS::vect::vect< T1 >& a, const SKAS::vect::vect< T1 >& b, const std::vector< sycl::event >& deps = { } ) -> gpu::pending< SKAS::util::moments< T1 > >;
+
+    template < SKAS::FlAd T1 >
+    auto PV_corr_async( const SKAS::vect::vect< T1 >& a, const SKAS::vect::vect< T1 >& b, const std::vector< sycl::event >& deps = { } ) -> gpu::pending< T1 >;
 };
 
 namespace SKAS::vect
 {
     // -----------------LINEAR ALGEBRA----------------------
 
+    template < typename X >
+    inline constexpr bool is_vect_v = false;
+
+    template < SKAS::FlAd T >
+    inline constexpr bool is_vect_v< vect< T > > = true;
+
     /**
-     * @brief addition operator support for std::vector
-     * @param first vect
-     * @param last vect
-     * @return vect result from operation
+     * @brief anything the element-wise operators accept: a vect or a pending expression over vects
+     */
+    template < typename X >
+    concept vect_operand = is_vect_v< X > || SKAS::expr::expression< X >;
+
+    template < vect_operand X >
+    auto as_expr( const X& x )
+    {
+        if constexpr ( is_vect_v< X > ) return SKAS::expr::leaf< X >{ x };
+        else return x;
+    }
+
+    /**
+     * @brief addition operator support for vect. lazy: the sum is computed when assigned or reduced
+     * @param first vect or vect expression
+     * @param last vect or vect expression
+     * @return expression node for first + last
      * @exception vectDimError thrown when first.size( ) != last.size( ) 
      */
-    template < SKAS::FlAd T1, SKAS::FlAd T2 >
-    auto operator+( const vect< T1 >& first, const vect< T2 >& last ) -> vect< T1 >
+    template < vect_operand X, vect_operand Y >
+    auto operator+( const X& first, const Y& last )
     {
-        if ( first.is_parallel( ) && last.is_parallel( ) )
-        {
-            return accel_vect::PV_add( first, last );
-        }
         if ( first.size( ) != last.size( ) )
         {
             throw vectDimError{"CANNOT + VECTOR OF DIFFERENT SIZES"};
         }
-        vect< T1 > output;
-        for ( int i = 0; i < first.size( ); ++i )
-        {
-            output.push_back( first[ i ] + last[ i ] );
-        }
-        return output;
+        return SKAS::expr::sum< decltype( as_expr( first ) ), decltype( as_expr( last ) ) >{ as_expr( first ), as_expr( last ) };
     }
         
     /**
-     * @brief subtraction operator support for vect
-     * @param first vect
-     * @param last vect
-     * @return vect result from operation
+     * @brief subtraction operator support for vect. lazy: the difference is computed when assigned or reduced
+     * @param first vect or vect expression
+     * @param last vect or vect expression
+     * @return expression node for first - last
      * @exception vectDimError thrown when first.size( ) != last.size( ) 
      */
-    template < SKAS::FlAd T1, SKAS::FlAd T2 >
-    auto operator-( const vect< T1 >& first, const vect< T2 >& last ) -> vect< T1 >
+    template < vect_operand X, vect_operand Y >
+    auto operator-( const X& first, const Y& last )
     {
-        if ( first.is_parallel( ) && last.is_parallel( ) )
-        {
-            return accel_vect::PV_sub( first, last );
-        }
         if ( first.size( ) != last.size( ) )
         {
             throw vectDimError{"CANNOT - VECTOR OF DIFFERENT SIZES"};
         }
-        vect< T1 > output;
-        for ( int i = 0; i < first.size( ); ++i )
-        {
-            output.push_back( first[ i ] - last[ i ] );
-        }
-        return output;
+        return SKAS::expr::difference< decltype( as_expr( first ) ), decltype( as_expr( last ) ) >{ as_expr( first ), as_expr( last ) };
     }
 
     /**
-     * @brief scalar support for vect
-     * @param t_vec vect to scale
+     * @brief scalar support for vect. lazy: scaling is computed when assigned or reduced
+     * @param t_vec vect or vect expression to scale
      * @param scalar .numeric
-     * @return vect scaled output
+     * @return expression node for t_vec * scalar
      */
-    template < SKAS::FlAd T1, SKAS::FlAd T2 >
-    auto operator*( const vect< T1 >& t_vec, const T2& scalar ) -> vect< T1 >
+    template < vect_operand X, typename S >
+        requires std::is_arithmetic_v< S >
+    auto operator*( const X& t_vec, const S& scalar )
     {
-        if ( t_vec.is_parallel( ) ) return accel_vect::PV_scale< T1 >( t_vec, scalar );
-        vect< T1 > output( t_vec.size( ), false );
-        size_t i = 0;
-        for ( const auto &elem : t_vec.interior )
-        {
-            output[ i++ ] = elem * scalar;
-        }
-        return output;
+        using T = typename X::value_type;
+        return SKAS::expr::scaled< decltype( as_expr( t_vec ) ) >{ as_expr( t_vec ), static_cast< T >( scalar ) };
+    }
+
+    template < vect_operand X, typename S >
+        requires std::is_arithmetic_v< S >
+    auto operator*( const S& scalar, const X& t_vec )
+    {
+        return t_vec * scalar;
+    }
+
+    // operands of different value types promote to the left operand's type, as the eager operators did.
+    // a temporary vect operand is not kept as a lazy leaf: the result is computed eagerly into its storage
+    // (element-wise, so in place is safe) and the temporary is returned, which allocates nothing
+
+    template < SKAS::FlAd T, vect_operand Y >
+    auto operator+( vect< T >&& first, const Y& last ) -> vect< T >
+    {
+        first = first + last;
+        return std::move( first );
+    }
+
+    template < vect_operand X, SKAS::FlAd T >
+        requires std::same_as< typename X::value_type, T >
+    auto operator+( const X& first, vect< T >&& last ) -> vect< T >
+    {
+        last = first + last;
+        return std::move( last );
+    }
+
+    template < SKAS::FlAd T >
+    auto operator+( vect< T >&& first, vect< T >&& last ) -> vect< T >
+    {
+        first = first + last;
+        return std::move( first );
+    }
+
+    template < SKAS::FlAd T, vect_operand Y >
+    auto operator-( vect< T >&& first, const Y& last ) -> vect< T >
+    {
+        first = first - last;
+        return std::move( first );
+    }
+
+    template < vect_operand X, SKAS::FlAd T >
+        requires std::same_as< typename X::value_type, T >
+    auto operator-( const X& first, vect< T >&& last ) -> vect< T >
+    {
+        last = first - last;
+        return std::move( last );
+    }
+
+    template < SKAS::FlAd T >
+    auto operator-( vect< T >&& first, vect< T >&& last ) -> vect< T >
+    {
+        first = first - last;
+        return std::move( first );
+    }
+
+    template < SKAS::FlAd T, typename S >
+        requires std::is_arithmetic_v< S >
+    auto operator*( vect< T >&& t_vec, const S& scalar ) -> vect< T >
+    {
+        t_vec = t_vec * scalar;
+        return std::move( t_vec );
+    }
+
+    template < SKAS::FlAd T, typename S >
+        requires std::is_arithmetic_v< S >
+    auto operator*( const S& scalar, vect< T >&& t_vec ) -> vect< T >
+    {
+        t_vec = t_vec * scalar;
+        return std::move( t_vec );
     }
 
     /**
-     * @brief dot product support for vect
-     * @param first vect
-     * @param last vect
+     * @brief dot product support for vect. expression operands are fused into the reduction
+     * @param first vect or vect expression
+     * @param last vect or vect expression
      * @return .numeric
      * @exception vectDimError thrown for incompatible sizes
      */
-    template < SKAS::FlAd T1, SKAS::FlAd T2 >
-    auto operator*( const vect< T1 >& first, const vect< T2 >& last ) -> T1
+    template < vect_operand X, vect_operand Y >
+    auto operator*( const X& first, const Y& last ) -> typename X::value_type
     {
-        if ( first.is_parallel( ) && last.is_parallel( ) ) return accel_vect::PV_dot( first, last );
+        using T = typename X::value_type;
         if( first.size( ) != last.size( ) )
         {
             throw vectDimError{"CANNOT DOT PRODUCT VECTORS OF DIFFERENT DIMENSION!"};
         }
-        T1 final = 0;
-        for ( int i = 0; i < first.size( ); ++i )
+        const exec::policy p = gpu::resolve( exec::common( first.get_policy( ), last.get_policy( ) ), gpu::op_kind::reduction, first.size( ) );
+        if constexpr ( is_vect_v< X > && std::same_as< X, Y > )
+        {
+            if ( p == exec::policy::device ) return accel_vect::PV_dot( first, last );
+        }
+        else if ( p == exec::policy::device )
         {
-            final += first[ i ] * last[ i ];
+            auto a = as_expr( first ).device( );
+            auto b = as_expr( last ).device( );
+            return accel_vect::PV_scalar_async< T >( [&]( T* dev_c ) {
+                gpu::transform_reduce_n( first.size( ), [=]( size_t i ) { return a( i ) * b( i ); }, std::plus< T >( ), T{0}, dev_c );
+            } ).wait( );
         }
-        return final;
+        auto a = as_expr( first ).host( );
+        auto b = as_expr( last ).host( );
+        return exec::reduce_n( p, first.size( ), T{0}, [=]( T& acc, size_t i ) { acc += a( i ) * b( i ); }, std::plus< T >( ) );
     }
 
     /**
@@ -353,12 +775,10 @@ namespace SKAS::vect
     template < SKAS::FlAd T1 >
     auto mag( const vect< T1 >& t_vec ) -> T1
     {
-        if ( t_vec.is_parallel( ) ) return accel_vect::PV_mag( t_vec );
-        double sum = 0;
-        for ( auto &elem : t_vec.interior )
-        {
-            sum += pow( elem, 2 );
-        }
+        const exec::policy p = gpu::resolve( t_vec.get_policy( ), gpu::op_kind::reduction, t_vec.size( ) );
+        if ( p == exec::policy::device ) return accel_vect::PV_mag( t_vec );
+        const T1* a = t_vec.data( );
+        double sum = exec::reduce_n( p, t_vec.size( ), double{0}, [=]( double& acc, size_t i ) { acc += double( a[ i ] ) * a[ i ]; }, std::plus< double >( ) );
         return sqrt( sum );
     }
 
@@ -370,7 +790,7 @@ namespace SKAS::vect
     template < SKAS::FlAd T1 >
     auto makeunit( const vect< T1 >& t_vec ) -> vect< T1 >
     {
-        return t_vec * ( 1.0 / mag( t_vec ) );
+        return vect< T1 >( t_vec * ( 1.0 / mag( t_vec ) ) );
     }
 
     /**
@@ -387,6 +807,10 @@ namespace SKAS::vect
         {
             return false;
         }
+        if constexpr ( std::same_as< T1, T2 > )
+        {
+            if ( first.shares( last ) ) return true;
+        }
         for ( int vecti = 0; vecti < first.size( ); ++vecti )
         {
             if ( std::abs( first[ vecti ] - last[ vecti ] ) > error )
@@ -433,6 +857,15 @@ namespace SKAS::vect
         return !vcomp( rhs, lhs );
     }
 
+    /**
+     * @brief comparison of a vect against a pending vect expression, which is evaluated first
+     */
+    template < SKAS::FlAd T, SKAS::expr::expression E >
+    auto operator==( const vect< T >& rhs, const E& lhs ) -> bool
+    {
+        return vcomp( rhs, vect< typename E::value_type >( lhs ) );
+    }
+
     template < SKAS::FlAd T1, SKAS::FlAd T2 >
     auto operator==( const std::vector< T1 >& rhs, const std::vector< T2 >& lhs ) -> bool
     {
@@ -453,6 +886,39 @@ namespace SKAS::vect
 
     // -----------------STATS--------------------------
 
+    /**
+     * @brief one pass over both vectors for their means, squared deviations and co-deviations
+     * @param a_vec vect
+     * @param b_vec vect
+     * @exception vectDimError thrown for incompatible sizings.
+     * @return util::moments
+     */
+    template < SKAS::FlAd T1, SKAS::FlAd T2 >
+    auto moments( const vect< T1 >& a_vec, const vect< T2 >& b_vec ) -> util::moments< T1 >
+    {
+        if ( a_vec.size( ) != b_vec.size( ) ) throw vectDimError{"CANNOT COMPUTE MOMENTS OF INCOMPATIBLE VECTORS"};
+        const exec::policy p = gpu::resolve( exec::common( a_vec.get_policy( ), b_vec.get_policy( ) ), gpu::op_kind::reduction, a_vec.size( ) );
+        if constexpr ( std::same_as< T1, T2 > )
+        {
+            if ( p == exec::policy::device ) return accel_vect::PV_moments( a_vec, b_vec );
+        }
+        const T1* a = a_vec.data( );
+        const T2* b = b_vec.data( );
+        return exec::reduce_n( p == exec::policy::device ? exec::policy::seq : p, a_vec.size( ), util::moments< T1 >{ },
+            [=]( util::moments< T1 >& acc, size_t i ) { acc.push( a[ i ], b[ i ] ); }, util::moments_merge< T1 >( ) );
+    }
+
+    /**
+     * @brief one pass over a vector for its mean and squared deviations
+     * @param t_vec vect
+     * @return util::moments with both sides describing t_vec
+     */
+    template < SKAS::FlAd T >
+    auto moments( const vect< T >& t_vec ) -> util::moments< T >
+    {
+        return moments( t_vec, t_vec );
+    }
+
     /**
      * @brief compute covariance between two vectors
      * @param a_vec vect 
@@ -463,21 +929,13 @@ namespace SKAS::vect
     template < SKAS::FlAd T1, SKAS::FlAd T2 >
     auto cov( const vect< T1 >& a_vec, const vect< T2 >& b_vec ) -> T1
     {
-        if ( a_vec.is_parallel( ) && b_vec.is_parallel( ) ) return accel_vect::PV_cov( a_vec, b_vec );
         if ( a_vec.size( ) != b_vec.size( ) ) throw vectDimError{"CANNOT COMPUTE COV OF INCOMPATIBLE VECTORS"};
-        T1 out = 0;
-        auto aavg = mean(a_vec);
-        auto bavg = mean(b_vec);
-        for ( int i = 0; i < a_vec.size( ); ++i )
-        {
-            out += ( a_vec[ i ] - aavg ) * ( b_vec[ i ] - bavg );
-        }
-        return out / ( a_vec.size( ) - 1.0 );
+        return moments( a_vec, b_vec ).cov( );
     }
 
 
     /**
-     * @brief compute correlation between two vectors
+     * @brief compute correlation between two vectors in a single pass
      * @param a_vec vect
      * @param b_vec vect
      * @exception vectDimError thrown for incompatible sizings.
@@ -486,7 +944,7 @@ namespace SKAS::vect
     template < SKAS::FlAd T1, SKAS::FlAd T2 >
     auto corr( const vect< T1 >& a_vec, const vect< T2 >& b_vec ) -> T1
     {
-        return cov( a_vec, b_vec ) / ( s(a_vec) * s(b_vec) );
+        return moments( a_vec, b_vec ).corr( );
     }
 
 
@@ -502,17 +960,7 @@ namespace SKAS::vect
         {
             return 0;
         }
-        if ( t_vector.is_parallel( ) ) return accel_vect::PV_s2( t_vector );
-        T m0 = t_vector[ 0 ];
-        T m1;
-        T s = 0;
-        for ( int i = 1; i < t_vector.size( ); ++i )
-        {
-            m1 = m0 + ( t_vector[ i ] - m0 ) / ( i + 1 );
-            s = s + ( t_vector[ i ] - m0 ) * ( t_vector[ i ] - m1 );
-            m0 = m1;
-        }
-        return s / ( t_vector.size( ) - 1 );
+        return moments( t_vector ).s2_a( );
     }
 
     /**
@@ -534,13 +982,7 @@ namespace SKAS::vect
     template < SKAS::FlAd T >
     auto mean( const vect< T >& t_vec ) -> T
     {
-        if ( t_vec.is_parallel( ) ) return accel_vect::PV_mean( t_vec ); 
-        T sum = 0;
-        for ( auto &elem : t_vec )
-        {
-            sum += elem;
-        }
-        return sum / t_vec.size( );
+        return moments( t_vec ).mean_a;
     }
 
     //-----------------------MISC-----------------------
@@ -551,7 +993,7 @@ namespace SKAS::vect
         os << "[";
         for ( int i = 0; i < vec.size( ); ++i ) 
         {
-            os << vec.interior[ i ];
+            os << vec[ i ];
             if ( i < vec.size( ) - 1 ) 
             {
                 os << ", ";
@@ -561,6 +1003,12 @@ namespace SKAS::vect
         return os;
     }
 
+    template < SKAS::expr::expression E >
+    auto operator<<( std::ostream& os, const E& expression ) -> std::ostream&
+    {
+        return os << vect< typename E::value_type >( expression );
+    }
+
     template < typename T >
     auto operator<<( std::ostream& os, const std::vector< T >& vec ) -> std::ostream&
     {
@@ -581,218 +1029,242 @@ namespace SKAS::vect
 
 namespace SKAS::vect::accel_vect
 {
+    // all kernels below work on the persistent device mirrors of their operands (see vect::dev_data( )).
+    // results are left on the device and only come back to the host when host-side access asks for them.
+    // scratch and result buffers come from gpu::ctx( ).pool, so steady-state workloads do not allocate.
+    // the *_into functions only enqueue work and return its event; the blocking PV_* wait on it, the *_async hand it back.
+    // results carry exec::common of their operands' policies, so device in gives device out.
+
+    /**
+     * @brief c = a + b on the device. c must already hold a.size( ) elements
+     */
     template < SKAS::FlAd T1 >
-    auto PV_add( const SKAS::vect::vect< T1 >& a, const SKAS::vect::vect< T1 >& b ) -> SKAS::vect::vect< T1 >
+    auto PV_add_into( const vect< T1 >& a, const vect< T1 >& b, vect< T1 >& c, const std::vector< sycl::event >& deps ) -> sycl::event
     {
-        if ( a.size( ) != b.size( ) ) throw vectDimError{"CANNOT + VECTORS OF UNEQUAL SIZE"};
+        if ( a.size( ) != b.size( ) || a.size( ) != c.size( ) ) throw vectDimError{"CANNOT + VECTORS OF UNEQUAL SIZE"};
 
-        sycl::queue q = gpu::ctx( ).q;
+        const T1* dev_a = a.dev_data( );
+        const T1* dev_b = b.dev_data( );
+        T1* dev_c = c.dev_discard( );
 
-        vect< T1 > c( a.size( ), true );
+        return hipsycl::algorithms::transform( gpu::ctx( ).q, dev_a, dev_a + a.size( ), dev_b, dev_c, std::plus<T1>(), deps );
+    }
 
-        T1* dev_a = sycl::malloc_device< T1 >( a.size( ), q );
-        T1* dev_b = sycl::malloc_device< T1 >( a.size( ), q );
-        T1* dev_c = sycl::malloc_device< T1 >( a.size( ), q );
+    /**
+     * @brief c = a - b on the device. c must already hold a.size( ) elements
+     */
+    template < SKAS::FlAd T1 >
+    auto PV_sub_into( const vect< T1 >& a, const vect< T1 >& b, vect< T1 >& c, const std::vector< sycl::event >& deps ) -> sycl::event
+    {
+        if ( a.size( ) != b.size( ) || a.size( ) != c.size( ) ) throw vectDimError{"CANNOT - VECTORS OF UNEQUAL SIZE"};
 
-        q.memcpy( dev_a, a.data( ), sizeof( T1 ) * a.size( ) );
-        q.memcpy( dev_b, b.data( ), sizeof( T1 ) * b.size( ) );
-        q.memcpy( dev_c, c.data( ), sizeof( T1 ) * c.size( ) );
+        const T1* dev_a = a.dev_data( );
+        const T1* dev_b = b.dev_data( );
+        T1* dev_c = c.dev_discard( );
 
-        hipsycl::algorithms::transform( q, dev_a, dev_a + a.size( ), dev_b, dev_c, std::plus<T1>() );
+        return hipsycl::algorithms::transform( gpu::ctx( ).q, dev_a, dev_a + a.size( ), dev_b, dev_c, std::minus<T1>(), deps );
+    }
 
-        q.memcpy( c.data( ), dev_c, sizeof( T1 ) * c.size( ) );
-        q.wait( );
+    /**
+     * @brief c = a * scalar on the device. c must already hold a.size( ) elements
+     */
+    template < SKAS::FlAd T1 >
+    auto PV_scale_into( const vect< T1 >& a, const T1 scalar, vect< T1 >& c, const std::vector< sycl::event >& deps ) -> sycl::event
+    {
+        if ( a.size( ) != c.size( ) ) throw vectDimError{"CANNOT SCALE INTO VECTOR OF UNEQUAL SIZE"};
 
-        sycl::free( dev_a, q );
-        sycl::free( dev_b, q );
-        sycl::free( dev_c, q );
+        const T1* dev_a = a.dev_data( );
+        T1* dev_c = c.dev_discard( );
 
-        return c;
+        auto f = util::make_multiplier< T1, T1 >( scalar );
+
+        return hipsycl::algorithms::transform( gpu::ctx( ).q, dev_a, dev_a + a.size( ), dev_c, f, deps );
     }
 
-    template < SKAS::FlAd T1 >
-    auto PV_sub( const vect< T1 >& a, const vect< T1 >& b ) -> vect< T1 >
+    /**
+     * @brief runs launch( dev_out ) into a pooled device scalar and copies it back without blocking.
+     * finish is applied on the host once the value has arrived
+     */
+    template < typename T, typename Launch >
+    auto PV_scalar_async( Launch launch, std::function< void( T& ) > finish ) -> gpu::pending< T >
     {
-        if ( a.size( ) != b.size( ) ) throw vectDimError{"CANNOT - VECTORS OF UNEQUAL SIZE"};
+        sycl::queue& q = gpu::ctx( ).q;
 
-        sycl::queue q = gpu::ctx( ).q;
+        T* dev_c = gpu::ctx( ).pool.allocate< T >( 1 );
+        auto host_c = std::make_shared< T >( );
 
-        vect< T1 > c( a.size( ), true );
+        launch( dev_c );
+        sycl::event ev = q.memcpy( host_c.get( ), dev_c, sizeof( T ) );
 
-        T1* dev_a = sycl::malloc_device< T1 >( a.size( ), q );
-        T1* dev_b = sycl::malloc_device< T1 >( a.size( ), q );
-        T1* dev_c = sycl::malloc_device< T1 >( a.size( ), q );
+        // safe to recycle right away: later users of the block are queued behind the memcpy
+        gpu::ctx( ).pool.deallocate( dev_c );
 
-        q.memcpy( dev_a, a.data( ), sizeof( T1 ) * a.size( ) );
-        q.memcpy( dev_b, b.data( ), sizeof( T1 ) * b.size( ) );
-        q.memcpy( dev_c, c.data( ), sizeof( T1 ) * c.size( ) );
+        return gpu::pending< T >( ev, host_c, finish );
+    }
 
-        hipsycl::algorithms::transform( q, dev_a, dev_a + a.size( ), dev_b, dev_c, std::minus<T1>() );
-        
-        q.memcpy( c.data( ), dev_c, sizeof( T1 ) * c.size( ) );
-        q.wait( );
+    template < SKAS::FlAd T1 >
+    auto PV_add_async( const vect< T1 >& a, const vect< T1 >& b, const std::vector< sycl::event >& deps ) -> gpu::pending< vect< T1 > >
+    {
+        auto c = std::make_shared< vect< T1 > >( a.size( ), exec::common( a.get_policy( ), b.get_policy( ) ) );
+        sycl::event ev = PV_add_into( a, b, *c, deps );
+        return gpu::pending< vect< T1 > >( ev, c );
+    }
 
-        sycl::free( dev_a, q );
-        sycl::free( dev_b, q );
-        sycl::free( dev_c, q );
+    template < SKAS::FlAd T1 >
+    auto PV_add( const SKAS::vect::vect< T1 >& a, const SKAS::vect::vect< T1 >& b ) -> SKAS::vect::vect< T1 >
+    {
+        vect< T1 > c( a.size( ), exec::common( a.get_policy( ), b.get_policy( ) ) );
+        PV_add_into( a, b, c, { } ).wait( );
+        return c;
+    }
 
+    template < SKAS::FlAd T1 >
+    auto PV_sub_async( const vect< T1 >& a, const vect< T1 >& b, const std::vector< sycl::event >& deps ) -> gpu::pending< vect< T1 > >
+    {
+        auto c = std::make_shared< vect< T1 > >( a.size( ), exec::common( a.get_policy( ), b.get_policy( ) ) );
+        sycl::event ev = PV_sub_into( a, b, *c, deps );
+        return gpu::pending< vect< T1 > >( ev, c );
+    }
+
+    template < SKAS::FlAd T1 >
+    auto PV_sub( const vect< T1 >& a, const vect< T1 >& b ) -> vect< T1 >
+    {
+        vect< T1 > c( a.size( ), exec::common( a.get_policy( ), b.get_policy( ) ) );
+        PV_sub_into( a, b, c, { } ).wait( );
         return c;
     }
 
+    template < SKAS::FlAd T1 >
+    auto PV_scale_async( const vect< T1 >& a, const T1 scalar, const std::vector< sycl::event >& deps ) -> gpu::pending< vect< T1 > >
+    {
+        auto c = std::make_shared< vect< T1 > >( a.size( ), a.get_policy( ) );
+        sycl::event ev = PV_scale_into( a, scalar, *c, deps );
+        return gpu::pending< vect< T1 > >( ev, c );
+    }
     
     template < SKAS::FlAd T1 >
     auto PV_scale( const SKAS::vect::vect< T1 >& a, const T1 scalar ) -> vect< T1 >
     {
-        sycl::queue q = gpu::ctx( ).q;
-
-        vect< T1 > c( a.size( ), true );
-
-        T1* dev_a = sycl::malloc_device< T1 >( a.size( ), q );
-
-        q.memcpy( dev_a, a.data( ), sizeof( T1 ) * a.size( ) );
-
-        auto f = util::make_multiplier< T1, T1 >( scalar );
-
-        hipsycl::algorithms::transform( q, dev_a, dev_a + a.size( ), dev_a, f );
+        vect< T1 > c( a.size( ), a.get_policy( ) );
+        PV_scale_into( a, scalar, c, { } ).wait( );
+        return c;
+    }
 
-        q.memcpy( c.data( ), dev_a, sizeof( T1 ) * c.size( ) );
-        q.wait( );
+    template < SKAS::FlAd T1 >
+    auto PV_dot_async( const vect< T1 >& a, const vect< T1 >& b, const std::vector< sycl::event >& deps ) -> gpu::pending< T1 >
+    {
+        if ( a.size( ) != b.size( ) ) throw vectDimError{"CANNOT DOT VECTORS OF UNEQUAL SIZE"};
 
-        sycl::free( dev_a, q );
+        const T1* dev_a = a.dev_data( );
+        const T1* dev_b = b.dev_data( );
+        const size_t n = a.size( );
 
-        return c;
+        return PV_scalar_async< T1 >( [&]( T1* dev_c ) {
+            hipsycl::algorithms::transform_reduce( gpu::ctx( ).q, gpu::ctx().ag, dev_a, dev_a + n, dev_b, dev_c, T1{0}, std::plus<T1>(), std::multiplies<T1>(), deps );
+        } );
     }
         
-        
     template < SKAS::FlAd T1 >
     auto PV_dot( const vect< T1 >& a, const vect< T1 >& b ) -> T1
     {
-        if ( a.size( ) != b.size( ) ) throw vectDimError{"CANNOT DOT VECTORS OF UNEQUAL SIZE"};
-
-        sycl::queue& q = gpu::ctx( ).q;
-
-        T1* dev_a = sycl::malloc_device< T1 >( a.size( ), q );
-        T1* dev_b = sycl::malloc_device< T1 >( a.size( ), q );
-        T1* dev_c = sycl::malloc_device< T1 >( 1, q );
-
-        q.memcpy( dev_a, a.data( ), sizeof( T1 ) * a.size( ) );
-        q.memcpy( dev_b, b.data( ), sizeof( T1 ) * b.size( ) );
-
-        hipsycl::algorithms::transform_reduce( q, gpu::ctx().ag, dev_a, dev_a + a.size( ), dev_b, dev_c, T1{0}, std::plus<T1>(), std::multiplies<T1>() );
+        return PV_dot_async( a, b ).wait( );
+    }
 
-        T1 out;
-        q.memcpy( &out, dev_c, sizeof( T1 ) );
-        q.wait( );
+    template < SKAS::FlAd T >
+    auto PV_mag_async( const vect< T >& a, const std::vector< sycl::event >& deps ) -> gpu::pending< T >
+    {
+        if ( a.size( ) == 0 ) return gpu::pending< T >( sycl::event{ }, std::make_shared< T >( 0 ) );
 
-        sycl::free( dev_a, q );
-        sycl::free( dev_b, q );
-        sycl::free( dev_c, q );
+        const T* dev_a = a.dev_data( );
+        const size_t n = a.size( );
 
-        return out;
+        return PV_scalar_async< T >( [&]( T* dev_c ) {
+            hipsycl::algorithms::transform_reduce( gpu::ctx( ).q, gpu::ctx().ag, dev_a, dev_a + n, dev_c, T{0}, std::plus<T>(), SKAS::util::sqr<T>(), deps );
+        }, []( T& out ) { out = sqrt( out ); } );
     }
 
     template < SKAS::FlAd T >
     auto PV_mag( const vect< T >& a ) -> T
     {
-        if ( a.size( ) == 0 ) return T{0};
-        if ( a.size( ) == 1 ) return a[0];
+        return PV_mag_async( a ).wait( );
+    }
 
-        sycl::queue& q = gpu::ctx( ).q;
+    /**
+     * @brief single device pass producing means, squared deviations and co-deviations of a and b.
+     * each work-item folds its slice with the Chan merge, then the partials are tree-reduced
+     */
+    template < SKAS::FlAd T1 >
+    auto PV_moments_async( const SKAS::vect::vect< T1 >& a, const SKAS::vect::vect< T1 >& b, const std::vector< sycl::event >& deps ) -> gpu::pending< SKAS::util::moments< T1 > >
+    {
+        if ( a.size( ) != b.size( ) ) throw vectDimError{"CANNOT COMPUTE MOMENTS OF INCOMPATIBLE SIZED VECTORS"};
 
-        T* dev_a = sycl::malloc_device< T >( a.size( ), q );
-        T* dev_c = sycl::malloc_device< T >( 1, q );
+        using M = SKAS::util::moments< T1 >;
+        const T1* dev_a = a.dev_data( );
+        const T1* dev_b = &a == &b ? dev_a : b.dev_data( );
+        const size_t n = a.size( );
 
-        q.memcpy( dev_a, a.data( ), sizeof( T ) * a.size( ) );
+        return PV_scalar_async< M >( [&]( M* dev_c ) {
+            gpu::transform_reduce_n( n, [=]( size_t i ) { return M::of( dev_a[ i ], dev_b[ i ] ); }, SKAS::util::moments_merge< T1 >( ), M{ }, dev_c, deps );
+        } );
+    }
 
-        hipsycl::algorithms::transform_reduce( q, gpu::ctx().ag, dev_a, dev_a + a.size( ), dev_c, T{0}, std::plus<T>(), SKAS::util::sqr<T>() );
+    template < SKAS::FlAd T1 >
+    auto PV_moments( const SKAS::vect::vect< T1 >& a, const SKAS::vect::vect< T1 >& b ) -> SKAS::util::moments< T1 >
+    {
+        return PV_moments_async( a, b ).wait( );
+    }
 
-        T out;
-        q.memcpy( &out, dev_c, sizeof( T ) );
-        q.wait( );
+    /**
+     * @brief pending statistic derived on the host from one pending moments reduction
+     */
+    template < SKAS::FlAd T1, typename Stat >
+    auto PV_moment_stat_async( const SKAS::vect::vect< T1 >& a, const SKAS::vect::vect< T1 >& b, Stat stat, const std::vector< sycl::event >& deps ) -> gpu::pending< T1 >
+    {
+        auto m = PV_moments_async( a, b, deps );
+        sycl::event ev = m.event( );
+        return gpu::pending< T1 >( ev, std::make_shared< T1 >( ), [m, stat]( T1& out ) mutable { out = stat( m.wait( ) ); } );
+    }
 
-        sycl::free( dev_a, q );
-        sycl::free( dev_c, q );
-        
-        return sqrt(out);
+    template < SKAS::FlAd T1 >
+    auto PV_cov_async( const SKAS::vect::vect< T1 >& a, const SKAS::vect::vect< T1 >& b, const std::vector< sycl::event >& deps ) -> gpu::pending< T1 >
+    {
+        return PV_moment_stat_async( a, b, []( const SKAS::util::moments< T1 >& m ) { return m.cov( ); }, deps );
     }
 
     template < SKAS::FlAd T1 >
     auto PV_cov( const SKAS::vect::vect< T1 >& a, const SKAS::vect::vect< T1 >& b ) -> T1
     {
-        if ( a.size( ) != b.size( ) ) throw vectDimError{"CANNOT COMPUTE COV OF INCOMPATIBLE SIZED VECTORS"};
-
-        sycl::queue& q = gpu::ctx( ).q;
-
-        auto f = util::tsum( mean( a ), mean( b ) );
-
-        T1* dev_xbar_a = sycl::malloc_device< T1 >( 1, q );
-        T1* dev_xbar_b = sycl::malloc_device< T1 >( 1, q );
-        T1* dev_a = sycl::malloc_device< T1 >( a.size( ), q );
-        T1* dev_b = sycl::malloc_device< T1 >( b.size( ), q );
-        T1* dev_c = sycl::malloc_device< T1 >( 1, q );
-        T1 zero = 0;
-
-        q.memcpy( dev_a, a.data( ), sizeof( T1 ) * a.size( ) );
-        q.memcpy( dev_b, b.data( ), sizeof( T1 ) * b.size( ) );
-        q.memcpy( dev_c, &zero, sizeof( T1 ) );
-
-        hipsycl::algorithms::transform_reduce( q, gpu::ctx().ag, dev_a, dev_a + a.size(), dev_b, dev_c, T1{0}, std::plus<T1>(), f );
-
-        T1 out;
-        q.memcpy( &out, dev_c, sizeof( T1 ) );
-        q.wait( );
+        return PV_cov_async( a, b ).wait( );
+    }
 
-        sycl::free( dev_a, q );
-        sycl::free( dev_b, q );
-        sycl::free( dev_c, q );
+    template < SKAS::FlAd T1 >
+    auto PV_corr_async( const SKAS::vect::vect< T1 >& a, const SKAS::vect::vect< T1 >& b, const std::vector< sycl::event >& deps ) -> gpu::pending< T1 >
+    {
+        return PV_moment_stat_async( a, b, []( const SKAS::util::moments< T1 >& m ) { return m.corr( ); }, deps );
+    }
 
-        return out / (a.size( ) - 1.0);
+    template < SKAS::FlAd T1 >
+    auto PV_s2_async( const SKAS::vect::vect< T1 >& t_vector, const std::vector< sycl::event >& deps ) -> gpu::pending< T1 >
+    {
+        return PV_moment_stat_async( t_vector, t_vector, []( const SKAS::util::moments< T1 >& m ) { return m.s2_a( ); }, deps );
     }
 
     template < SKAS::FlAd T1 >
     auto PV_s2( const SKAS::vect::vect< T1 >& t_vector ) -> T1
     {
-        sycl::queue& q = gpu::ctx().q;
-
-        auto f = util::ssum( mean( t_vector ) );
-
-        T1* dev_a = sycl::malloc_device< T1 >( t_vector.size( ), q );
-        T1* dev_c = sycl::malloc_device< T1 >( 1, q );
-
-        q.memcpy( dev_a, t_vector.data( ), sizeof( T1 ) * t_vector.size( ) );
-        
-        hipsycl::algorithms::transform_reduce( q, gpu::ctx().ag, dev_a, dev_a + t_vector.size( ), dev_c, T1{0}, std::plus<T1>(), f );
-
-        T1 out;
-        q.memcpy( &out, dev_c, sizeof( T1 ) );
-        q.wait( );
-
-        sycl::free( dev_a, q );
-        sycl::free( dev_c, q );
+        return PV_s2_async( t_vector ).wait( );
+    }
 
-        return out / (t_vector.size( ) - 1.0 );
+    template < SKAS::FlAd T1 >
+    auto PV_mean_async( const SKAS::vect::vect< T1 >& a, const std::vector< sycl::event >& deps ) -> gpu::pending< T1 >
+    {
+        return PV_moment_stat_async( a, a, []( const SKAS::util::moments< T1 >& m ) { return m.mean_a; }, deps );
     }
 
     template < SKAS::FlAd T1 >
     auto PV_mean( const SKAS::vect::vect< T1 >& a ) -> T1
     {
-        sycl::queue& q = gpu::ctx().q;
-
-        T1* dev_a = sycl::malloc_device< T1 >( a.size( ), q );
-        T1* dev_c = sycl::malloc_device< T1 >( 1, q );
-
-        q.memcpy( dev_a, a.data( ), sizeof( T1 ) * a.size( ) );
-
-        hipsycl::algorithms::reduce( q, gpu::ctx().ag, dev_a, dev_a + a.size( ), dev_c, T1{0}, std::plus< T1 >() );
-
-        T1 out;
-        q.memcpy( &out, dev_c, sizeof( T1 ) );
-        q.wait( );
-
-        sycl::free( dev_a, q );
-        sycl::free( dev_c, q );
-
-        return out / static_cast< T1 >(a.size( ));
+        return PV_mean_async( a ).wait( );
     }
         
 }; //NAMESPACE SKAS::vect::accel_vect
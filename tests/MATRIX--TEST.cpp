@@ -3,6 +3,10 @@
  */
 #include "vect.h"
 #include "matrix.h"
+#include "fixed.h"
+#include "batch.h"
+#include "sparse.h"
+#include "krylov.h"
 #include "testing.h"
 #include <typeinfo>
 #include <sycl/sycl.hpp>
@@ -103,6 +107,8 @@ auto main( ) -> int
     matrix< float > c4_2({3,3,3,4},2,2);
     expectT( "c4. testing sqrt( ).", sqrt(c4_1), c4_2 );
 
+    matrix< double > c4_2_d({3,3,3,4},2,2);
+
     matrix< double > c5_1({1,0,0,0, 0,1,0,0, 0,0,1,0 }, 3, 4 );
     matrix< double > c5_2({1,1,1},3,1);
     expectT( "c5. testing diag().", diag(c5_1), c5_2 );
@@ -139,5 +145,628 @@ auto main( ) -> int
     matrix< double > e4_2({2,2,34,3,134,213,4,3425,1324,3215,24,3245,129387,123,40987,987}, 4, 4, false );
     expectT( "e4. testing PM_mul.", e4_1 % e4_1, e4_2 % e4_2 );
 
+    matrix< double > e5_1({1,1,2, 3,4,0}, 2, 3, true);
+    matrix< double > e5_2({8,9, 8,9, 4,5}, 3, 2, true);
+    expectT( "e5. testing PM_mul on non-square matricies.", e5_1 % e5_2, c7_3 );
+
+    auto e6_1 = SKAS::matrix::accel_matr::PM_mul_async( e5_1, e5_2 );
+    auto e6_2 = SKAS::matrix::accel_matr::PM_add_async( e6_1.result( ), c7_3, { e6_1.event( ) } );
+    expectT( "e6. testing chained async PM_mul and PM_add.", e6_2.wait( ), c7_3 * double{2} );
+
+    matrix< double > e7_1( 0.0, 70, 45, true );
+    matrix< double > e7_2( 0.0, 45, 33, true );
+    for ( size_t i = 0; i < e7_1.nrow( ); ++i ) for ( size_t j = 0; j < e7_1.ncol( ); ++j ) e7_1.setelem( double( ( i * 3 + j ) % 7 ) - 3, i, j );
+    for ( size_t i = 0; i < e7_2.nrow( ); ++i ) for ( size_t j = 0; j < e7_2.ncol( ); ++j ) e7_2.setelem( double( ( i + j * 5 ) % 9 ) - 4, i, j );
+    matrix< double > e7_3( e7_1.storage( ), 70, 45 );
+    matrix< double > e7_4( e7_2.storage( ), 45, 33 );
+    expectT( "e7. testing tiled PM_mul across partial work-group tiles.", e7_1 % e7_2, e7_3 % e7_4 );
+
+    matrix< float > e8_a( {8,9, 8,9, 4,5}, 3, 2, true );
+    matrix< float > e8_b( {1,1,2, 3,4,0}, 2, 3, true );
+    matrix< float > e8_c( 1.0f, 2, 2, true );
+    SKAS::matrix::accel_matr::gemm_tiled< float >( true, true, 2, 2, 3, 2.0f, e8_a.storage( ).dev_data( ), 2, e8_b.storage( ).dev_data( ), 3, 1.0f, e8_c.storage( ).dev_data( ), 2, { } ).wait( );
+    expectT( "e8. testing tiled gemm reads transposed operands in place.", e8_c, matrix< float >( {49,113,57,127}, 2, 2 ) );
+
+    //-------------f. fused expressions
+    matrix< double > f1_1({1,2,3,4},2,2,true);
+    matrix< double > f1_2({1,1,1,1},2,2,true);
+    matrix< double > f1_3 = f1_1 * 2.0 + f1_2 - f1_1;
+    expectT( "f1. testing fused device matrix expression.", f1_3, matrix< double >({2,3,4,5},2,2) );
+
+    matrix< double > f2 = identity< double >( 2 ) - 2.0 * ( c4_2_d % c4_2_d );
+    expectT( "f2. testing fused expression over product.", f2, matrix< double >({-35,-42,-42,-49},2,2) );
+
+    //-------------g. execution policies
+    using SKAS::exec::policy;
+    matrix< double > g1_1({2,2,34,3,134,213,4,3425,1324,3215,24,3245,129387,123,40987,987}, 4, 4, policy::threaded );
+    expectT( "g1. testing threaded matrix multiply.", g1_1 % g1_1, e4_2 % e4_2 );
+
+    matrix< double > g2_1( 1.5, 67, 45, policy::simd );
+    matrix< double > g2_2( 2.0, 45, 23, policy::simd );
+    expectT( "g2. testing simd matrix multiply.", g2_1 % g2_2, matrix< double >( 135.0, 67, 23 ) );
+
+    expectT( "g3. testing product keeps operand policy.", ( g2_1 % g2_2 ).get_policy( ) == policy::simd, true );
+
+    auto g4 = SKAS::matrix::accel_matr::PM_add( c2_1, c2_2 );
+    expectT( "g4. testing PM_add result keeps operand policy.", g4.get_policy( ) == policy::seq, true );
+
+    matrix< double > g5( e1_1 );
+    expectT( "g5. testing matrix copy keeps device policy.", g5.is_parallel( ), true );
+
+    //-------------h. blocked host gemm
+    auto h_naive = []( const auto& x, const auto& y ) {
+        using T = typename std::decay_t< decltype( x ) >::value_type;
+        matrix< T > out( T{0}, x.nrow( ), y.ncol( ) );
+        for ( size_t i = 0; i < x.nrow( ); ++i )
+            for ( size_t j = 0; j < y.ncol( ); ++j )
+            {
+                T sum = 0;
+                for ( size_t k = 0; k < x.ncol( ); ++k ) sum += x.at( i, k ) * y.at( k, j );
+                out.setelem( sum, i, j );
+            }
+        return out;
+    };
+    matrix< double > h1_1( 0.0, 137, 301, policy::threaded );
+    matrix< double > h1_2( 0.0, 301, 97, policy::threaded );
+    for ( size_t i = 0; i < h1_1.nrow( ); ++i ) for ( size_t j = 0; j < h1_1.ncol( ); ++j ) h1_1.setelem( double( ( i * 7 + j * 3 ) % 11 ) - 5, i, j );
+    for ( size_t i = 0; i < h1_2.nrow( ); ++i ) for ( size_t j = 0; j < h1_2.ncol( ); ++j ) h1_2.setelem( double( ( i * 5 + j ) % 13 ) - 6, i, j );
+    expectT( "h1. testing blocked threaded double gemm across cache blocks.", h1_1 % h1_2, h_naive( h1_1, h1_2 ) );
+
+    matrix< float > h2_1( 0.0f, 67, 530, policy::seq );
+    matrix< float > h2_2( 0.0f, 530, 35, policy::seq );
+    for ( size_t i = 0; i < h2_1.nrow( ); ++i ) for ( size_t j = 0; j < h2_1.ncol( ); ++j ) h2_1.setelem( float( ( i + j ) % 5 ) - 2, i, j );
+    for ( size_t i = 0; i < h2_2.nrow( ); ++i ) for ( size_t j = 0; j < h2_2.ncol( ); ++j ) h2_2.setelem( float( ( i * 3 + j ) % 7 ) - 3, i, j );
+    expectT( "h2. testing blocked float gemm with ragged tiles.", h2_1 % h2_2, h_naive( h2_1, h2_2 ) );
+
+    matrix< double > h3_c( 1.0, 2, 2 );
+    SKAS::matrix::host_matr::gemm( policy::seq, true, true, 2, 2, 3, 2.0, c7_2.storage( ).data( ), 2, c7_1.storage( ).data( ), 3, 1.0, h3_c.storage( ).data( ), 2 );
+    expectT( "h3. testing transposed gemm with alpha and beta.", h3_c, matrix< double >( {49,113,57,127}, 2, 2 ) );
+
+    //-------------i. gemm api
+    using SKAS::matrix::gemm;
+    matrix< double > i1_c( 1.0, 2, 2 );
+    gemm( true, true, 2.0, c7_2, c7_1, 1.0, i1_c );
+    expectT( "i1. testing gemm with transposes, alpha and beta.", i1_c, matrix< double >( {49,113,57,127}, 2, 2 ) );
+
+    matrix< float > i2_a( {8,9,8,9,4,5}, 3, 2, true );
+    matrix< float > i2_b( {1,1,2,3,4,0}, 2, 3, true );
+    matrix< float > i2_c( 1.0f, 2, 2, true );
+    gemm( true, true, 2.0f, i2_a, i2_b, 1.0f, i2_c );
+    expectT( "i2. testing device gemm with transposes, alpha and beta.", i2_c, matrix< float >( {49,113,57,127}, 2, 2 ) );
+
+    matrix< double > i3_c;
+    gemm( false, true, 1.0, c7_1, c7_1, 0.0, i3_c );
+    expectT( "i3. testing gemm shapes an empty output when beta is zero.", i3_c, c7_1 % c7_1.t( ) );
+
+    expectThrow< SKAS::matrixDimError >( "i4. testing gemm rejects a mis-sized output it must accumulate into.", [&]( ) {
+        matrix< double > wrong( 0.0, 3, 3 );
+        gemm( false, false, 1.0, c7_1, c7_2, 1.0, wrong );
+    } );
+
+    //-------------j. matrix-vector products
+    using SKAS::vect::vect;
+    vect< double > j1_x( {1,2,3} );
+    expectT( "j1. testing matrix % vect.", c7_1 % j1_x, vect< double >( {9,11} ) );
+    expectT( "j2. testing vect % matrix as the transposed product.", vect< double >( {1,2} ) % c7_1, vect< double >( {7,9,2} ) );
+
+    matrix< float > j3_a( 0.0f, 41, 300, true );
+    vect< float > j3_x( 300, 0.0f, true );
+    for ( size_t i = 0; i < j3_a.nrow( ); ++i ) for ( size_t j = 0; j < j3_a.ncol( ); ++j ) j3_a.setelem( float( ( i + 2 * j ) % 7 ) - 3, i, j );
+    for ( size_t j = 0; j < j3_x.size( ); ++j ) j3_x[ j ] = float( j % 5 ) - 2;
+    matrix< float > j3_host( j3_a.storage( ), 41, 300, policy::seq );
+    vect< float > j3_xh( j3_x );
+    j3_xh.set_policy( policy::seq );
+    expectT( "j3. testing device row-reduction gemv against the host.", j3_a % j3_x, j3_host % j3_xh );
+
+    vect< float > j4_y( 300, 1.0f, true );
+    vect< float > j4_x( 41, 1.0f, true );
+    SKAS::matrix::gemv( true, 2.0f, j3_a, j4_x, -1.0f, j4_y );
+    vect< float > j4_yh( 300, 1.0f, policy::threaded );
+    SKAS::matrix::gemv( true, 2.0f, j3_host, vect< float >( 41, 1.0f, policy::threaded ), -1.0f, j4_yh );
+    expectT( "j4. testing transposed device gemv with alpha and beta against threaded host.", j4_y, j4_yh );
+
+    //-------------k. blocked householder qr
+    auto k_fill = []( matrix< double >& x ) {
+        for ( size_t i = 0; i < x.nrow( ); ++i ) for ( size_t j = 0; j < x.ncol( ); ++j ) x.setelem( double( ( i * 13 + j * 7 ) % 17 ) - 8 + ( i == j ? 20.0 : 0.0 ), i, j );
+    };
+    matrix< double > k1_a( 0.0, 75, 70, policy::threaded );
+    k_fill( k1_a );
+    auto k1_qr = qr_decomp( k1_a );
+    expectT( "k1. testing blocked qr reproduces the matrix across panels.", k1_qr[ 0 ] % k1_qr[ 1 ], k1_a );
+    matrix< double > k2_qtq;
+    gemm( true, false, 1.0, k1_qr[ 0 ], k1_qr[ 0 ], 0.0, k2_qtq );
+    expectT( "k2. testing blocked qr gives an orthogonal Q.", k2_qtq, identity< double >( 75 ) );
+    bool k3_upper = true;
+    for ( size_t i = 1; i < 75; ++i ) for ( size_t j = 0; j < std::min< size_t >( i, 70 ); ++j ) k3_upper = k3_upper && k1_qr[ 1 ].at( i, j ) == 0.0;
+    expectT( "k3. testing blocked qr gives an upper triangular R.", k3_upper, true );
+
+    matrix< double > k4_a( 0.0, 40, 36, true );
+    k_fill( k4_a );
+    auto k4_f = qr_factor( k4_a );
+    matrix< double > k4_c( k4_a );
+    qr_apply( k4_f, true, k4_c );
+    expectT( "k4. testing device blocked qr and Q^T applied in compact form.", k4_c, qr_r( k4_f ) );
+
+    auto k5_f = qr_factor( k4_a );
+    expectT( "k5. testing device qr keeps the factored matrix on the device.", k5_f.packed.storage( ).residence( ) == SKAS::vect::residency::device, true );
+
+    //-------------l. blocked cholesky
+    auto l_spd = []( const size_t n, const policy p ) {
+        matrix< double > b( 0.0, n, n, p );
+        for ( size_t i = 0; i < n; ++i ) for ( size_t j = 0; j < n; ++j ) b.setelem( double( ( i * 5 + j * 3 ) % 11 ) / 11.0 - 0.5, i, j );
+        matrix< double > out( 0.0, n, n, p );
+        gemm( false, true, 1.0, b, b, 0.0, out );
+        for ( size_t i = 0; i < n; ++i ) out.setelem( out.at( i, i ) + double( n ), i, i );
+        return out;
+    };
+    matrix< double > l1_a = l_spd( 90, policy::threaded );
+    matrix< double > l1_l = cholesky( l1_a );
+    matrix< double > l1_llt;
+    gemm( false, true, 1.0, l1_l, l1_l, 0.0, l1_llt );
+    expectT( "l1. testing threaded blocked cholesky across panels.", l1_llt, l1_a );
+
+    matrix< double > l2_a = l_spd( 45, policy::device );
+    matrix< double > l2_l = cholesky( l2_a );
+    matrix< double > l2_llt;
+    gemm( false, true, 1.0, l2_l, l2_l, 0.0, l2_llt );
+    expectT( "l2. testing device blocked cholesky.", l2_llt, l2_a );
+
+    matrix< double > l3_a = l_spd( 40, policy::seq );
+    expectT( "l3. testing spd inversion on blocked cholesky.", invert( l3_a, "spd" ) % l3_a, identity< double >( 40 ) );
+
+    expectThrow< SKAS::solutionError >( "l4. testing cholesky rejects an indefinite matrix.", [&]( ) { cholesky( matrix< double >( {1,2,2,1}, 2, 2 ) ); } );
+
+    //-------------m. factorization objects and solve
+    cholesky_factorization< double > m1_chol( l3_a );
+    vect< double > m1_x( 40, 0.0 );
+    for ( size_t i = 0; i < 40; ++i ) m1_x[ i ] = double( i % 7 ) - 3;
+    vect< double > m1_b = l3_a % m1_x;
+    expectT( "m1. testing cholesky factorization solves a vect.", m1_chol.solve( m1_b ), m1_x );
+    vect< double > m2_x = 2.0 * m1_x;
+    expectT( "m2. testing the same factorization solves a second right-hand side.", m1_chol.solve( l3_a % m2_x ), m2_x );
+
+    qr_factorization< double > m3_qr( k1_a );
+    vect< double > m3_x( 70, 0.0 );
+    for ( size_t i = 0; i < 70; ++i ) m3_x[ i ] = double( i % 5 ) - 2;
+    expectT( "m3. testing qr factorization solves a consistent tall system.", m3_qr.solve( k1_a % m3_x ), m3_x );
+
+    matrix< double > m4_b( 0.0, 40, 3, policy::device );
+    for ( size_t i = 0; i < 40; ++i ) for ( size_t j = 0; j < 3; ++j ) m4_b.setelem( double( i + j ), i, j );
+    matrix< double > m4_a( l3_a );
+    m4_a.set_policy( policy::device );
+    expectT( "m4. testing device solve of several right-hand sides.", m4_a % solve( m4_a, m4_b, "spd" ), m4_b );
+
+    expectT( "m5. testing inverse through a qr factorization.", qr_factorization< double >( d1_1 ).inverse( ), d1_2 );
+
+    //-------------n. blocked triangular solves
+    auto n_tri = []( const size_t n, const bool lower, const policy p ) {
+        matrix< double > t( 0.0, n, n, p );
+        for ( size_t i = 0; i < n; ++i )
+            for ( size_t j = 0; j < n; ++j )
+                if ( lower ? j <= i : j >= i ) t.setelem( i == j ? 4.0 + double( i % 3 ) : double( ( i * 3 + j ) % 5 ) / 5.0 - 0.4, i, j );
+        return t;
+    };
+    matrix< double > n1_l = n_tri( 100, true, policy::threaded );
+    matrix< double > n1_x( 0.0, 100, 7, policy::threaded );
+    for ( size_t i = 0; i < 100; ++i ) for ( size_t j = 0; j < 7; ++j ) n1_x.setelem( double( ( i + 2 * j ) % 9 ) - 4, i, j );
+    matrix< double > n1_b = n1_l % n1_x;
+    trsm( true, false, n1_l, n1_b );
+    expectT( "n1. testing blocked threaded lower trsm across blocks.", n1_b, n1_x );
+
+    matrix< double > n2_u = n_tri( 70, false, policy::device );
+    matrix< double > n2_x( 0.0, 70, 5, policy::device );
+    for ( size_t i = 0; i < 70; ++i ) for ( size_t j = 0; j < 5; ++j ) n2_x.setelem( double( ( 3 * i + j ) % 7 ) - 3, i, j );
+    matrix< double > n2_b;
+    gemm( true, false, 1.0, n2_u, n2_x, 0.0, n2_b );
+    trsm( false, true, n2_u, n2_b );
+    expectT( "n2. testing blocked device trsm with a transposed upper triangle.", n2_b, n2_x );
+
+    expectT( "n3. testing triangularinvert on blocked trsm.", triangularinvert( n1_l, true ) % n1_l, identity< double >( 100 ) );
+
+    matrix< double > n4_u = n_tri( 70, false, policy::device );
+    n4_u.setelem( 0.0, 65, 65 );
+    matrix< double > n4_b( 1.0, 70, 2, policy::device );
+    expectThrow< SKAS::solutionError >( "n4. testing device trsm rejects a zero on the diagonal.", [&]( ) { trsm( false, false, n4_u, n4_b ); } );
+
+    //-------------o. lu with partial pivoting
+    matrix< double > o1_a( 0.0, 85, 85, policy::threaded );
+    for ( size_t i = 0; i < 85; ++i ) for ( size_t j = 0; j < 85; ++j ) o1_a.setelem( double( ( i * 131 + j * 71 + i * j * 17 ) % 97 ) / 97.0 - 0.5, i, j );
+    lu_factorization< double > o1_lu( o1_a );
+    vect< double > o1_x( 85, 0.0 );
+    for ( size_t i = 0; i < 85; ++i ) o1_x[ i ] = double( i % 6 ) - 2.5;
+    expectT( "o1. testing blocked lu solve with pivoting across panels.", o1_lu.solve( o1_a % o1_x ), o1_x );
+
+    matrix< double > o2_a( {0,2,1, 1,1,1, 2,1,0}, 3, 3 );
+    expectNear( "o2. testing lu determinant with row interchanges.", det( o2_a ), 3.0, 1e-12 );
+    expectT( "o3. testing lu determinant of a singular matrix.", det( matrix< double >( {1,2,2,4}, 2, 2 ) ), 0.0 );
+
+    matrix< double > o4_a( o1_a );
+    o4_a.set_policy( policy::device );
+    expectT( "o4. testing device lu inverse.", invert( o4_a ) % o4_a, identity< double >( 85 ) );
+    expectT( "o5. testing lu is the default inversion.", invert( d1_1 ), d1_2 );
+
+    const lu_factors< double > o6_dev = lu_factor( o4_a );
+    const lu_factors< double > o6_host = lu_factor( o1_a );
+    expectT( "o6. testing device lu keeps the factored matrix on the device.", o6_dev.packed.storage( ).residence( ) == SKAS::vect::residency::device, true );
+    expectT( "o7. testing device lu pivots match the host.", o6_dev.pivots, o6_host.pivots );
+    expectT( "o8. testing device lu factors match the host.", o6_dev.packed, o6_host.packed );
+
+    //-------------p. building matricies
+    matrix< double > p1;
+    p1.reserve( 200, 3 );
+    const size_t p1_capacity = p1.capacity( );
+    for ( size_t i = 0; i < 200; ++i ) p1.appendrow( std::vector< double >{ double( i ), 1.0, -double( i ) } );
+    expectT( "p1. testing appendrow stays within reserved capacity.", p1.capacity( ), p1_capacity );
+    expectT( "p2. testing appendrow grows nrow.", p1.nrow( ), size_t{200} );
+    expectT( "p3. testing appendrow stores the row.", p1.at( 199, 2 ), -199.0 );
+
+    matrix< double > p2( {1,2,3,4}, 2, 2 );
+    p2.insertcol( std::vector< double >{ 9, 8 }, 1 );
+    p2.insertrow( std::vector< double >{ 7, 7, 7 }, 0 );
+    expectT( "p4. testing in-place insertcol and insertrow.", p2, matrix< double >( {7,7,7, 1,9,2, 3,8,4}, 3, 3 ) );
+
+    matrix_builder< double > p3_build( 2 );
+    p3_build.reserve( 3 );
+    p3_build.append( { 1.0, 2.0 } );
+    p3_build.append( std::vector< double >{ 3.0, 4.0 } );
+    p3_build.append( vect< double >( { 5.0, 6.0 } ) );
+    expectT( "p5. testing matrix_builder.", p3_build.build( ), matrix< double >( {1,2,3,4,5,6}, 3, 2 ) );
+
+    expectT( "p6. testing vstack.", vstack< double >( { c7_1, matrix< double >( {5,5,5}, 1, 3 ) } ), matrix< double >( {1,1,2, 3,4,0, 5,5,5}, 3, 3 ) );
+    expectT( "p7. testing hstack.", hstack< double >( { c7_1, matrix< double >( {6,7}, 2, 1 ) } ), matrix< double >( {1,1,2,6, 3,4,0,7}, 2, 4 ) );
+
+    //-------------q. row, col and block views
+    matrix< double > q1_a( {1,2,3, 4,5,6, 7,8,9, 10,11,12}, 4, 3 );
+    const matrix< double >& q1_c = q1_a;
+    expectT( "q1. testing a row view reads in place.", q1_c.row( 2 )[ 1 ], 8.0 );
+    expectT( "q2. testing a col view reads in place.", q1_c.col( 2 )[ 3 ], 12.0 );
+    expectT( "q3. testing col view size.", q1_c.col( 0 ).size( ), size_t{4} );
+    expectT( "q4. testing lazy arithmetic on views.", vect< double >( q1_c.row( 0 ) + q1_c.row( 1 ) * 2.0 ), vect< double >( {9, 12, 15} ) );
+    expectT( "q5. testing block view nrow.", q1_c.block( 0, 0, 3, 3 ).nrow( ), size_t{3} );
+    expectT( "q6. testing dot of a row and a col view.", d1_1.row( 1 ) * d1_1.col( 1 ), d1_1.getrow( 1 ) * d1_1.getcol( 1 ) );
+
+    q1_a.row( 0 ) = q1_c.row( 3 );
+    q1_a.col( 1 ) = vect< double >( {0, 0, 0, 0} );
+    q1_a.block( 1, 0, 2, 2 ) = matrix< double >( {-1,-2, -3,-4}, 2, 2 );
+    expectT( "q7. testing writes through row, col and block views.", q1_a, matrix< double >( {10,0,12, -1,-2,6, -3,-4,9, 10,0,12}, 4, 3 ) );
+
+    matrix< double > q5_a( 0.0, 4, 4, policy::threaded );
+    for ( size_t i = 0; i < 4; ++i ) for ( size_t j = 0; j < 4; ++j ) q5_a.setelem( double( 4 * i + j ), i, j );
+    matrix< double > q5_sum = q5_a.block( 0, 0, 2, 2 ) + q5_a.block( 2, 2, 2, 2 );
+    expectT( "q8. testing block materialization.", matrix< double >( q5_a.block( 1, 2, 2, 2 ) ), matrix< double >( {6,7, 10,11}, 2, 2 ) );
+    expectT( "q9. testing block arithmetic.", q5_sum, matrix< double >( {10,12, 18,20}, 2, 2 ) );
+
+    matrix< double > q6_a( 0.0, 96, 96, policy::device );
+    for ( size_t i = 0; i < 96; ++i ) for ( size_t j = 0; j < 96; ++j ) q6_a.setelem( double( ( i * 7 + j * 3 ) % 11 ) - 5, i, j );
+    matrix< double > q6_l( q6_a.block( 0, 0, 48, 40 ) ), q6_r( q6_a.block( 0, 40, 48, 40 ) ), q6_ref;
+    gemm( true, false, 1.0, q6_l, q6_r, 0.0, q6_ref );
+    gemm( true, false, 1.0, q6_a.block( 0, 0, 48, 40 ), q6_a.block( 0, 40, 48, 40 ), 0.0, q6_a.block( 48, 0, 40, 40 ) );
+    expectT( "q10. testing device gemm between blocks of one matrix.", matrix< double >( q6_a.block( 48, 0, 40, 40 ) ), q6_ref );
+
+    vect< double > q7_x( 40, 1.0 ), q7_y;
+    gemv( false, 1.0, q6_a.block( 48, 0, 40, 40 ), q7_x, 0.0, q7_y );
+    expectT( "q11. testing gemv on a block.", q7_y, q6_ref % q7_x );
+
+    expectThrow< SKAS::matrixDimError >( "q12. testing gemm rejects an output block overlapping an input.", [&]( ) {
+        gemm( false, false, 1.0, q6_a.block( 0, 0, 40, 40 ), q6_a.block( 0, 40, 40, 40 ), 0.0, q6_a.block( 30, 30, 40, 40 ) );
+    } );
+
+    //-------------r. shared storage
+    matrix< double > r1_a( 0.0, 64, 64, policy::threaded );
+    matrix< double > r1_b( r1_a );
+    expectT( "r1. testing matrix copies share storage.", r1_b.storage( ).shares( r1_a.storage( ) ), true );
+    expectT( "r2. testing getinterior shares storage.", r1_a.getinterior( ).shares( r1_a.storage( ) ), true );
+
+    r1_b.setelem( 1.0, 3, 3 );
+    expectT( "r3. testing a write leaves the source unchanged.", r1_a.at( 3, 3 ), 0.0 );
+    expectT( "r4. testing a write lands in the copy.", r1_b.at( 3, 3 ), 1.0 );
+    expectF( "r5. testing a write detaches the copy.", r1_a, r1_b );
+
+    //-------------s. moves and temporaries
+    matrix< double > s1_a( 1.0, 3, 3, policy::simd );
+    matrix< double > s1_b( std::move( s1_a ) );
+    expectT( "s1. testing matrix move leaves the source empty.", s1_a.is_empty( ), true );
+    expectT( "s2. testing matrix move keeps the shape.", s1_b.nrow( ), size_t{3} );
+    expectT( "s3. testing matrix move keeps the values.", s1_b.at( 2, 2 ), 1.0 );
+
+    matrix< double > s2 = ( matrix< double >( 2.0, 3, 3 ) + s1_b ) * 2.0 - s1_b;
+    expectT( "s4. testing arithmetic on temporary matricies.", s2, matrix< double >( 5.0, 3, 3 ) );
+
+    //-------------t. storage layouts
+    matrix< double > t1_r( {1,2,3, 4,5,6, 7,8,9, 10,11,12, 13,14,15}, 5, 3 );
+    matrix< double, col_major > t1_c = t1_r.relayout< col_major >( );
+    matrix< double, tiled< 2 > > t1_t = t1_r.relayout< tiled< 2 > >( );
+    expectT( "t1. testing column-major relayout keeps logical elements.", t1_c.at( 3, 1 ), 11.0 );
+    expectT( "t2. testing tiled relayout keeps logical elements.", t1_t.at( 4, 2 ), 15.0 );
+    expectT( "t3. testing column-major storage order.", t1_c.storage( )[ 1 ], 4.0 );
+    expectT( "t4. testing tiled storage order.", t1_t.storage( )[ 2 ], 4.0 );
+    expectT( "t5. testing a relayout round trip.", t1_t.relayout< col_major >( ).relayout< row_major >( ), t1_r );
+
+    t1_c.setelem( -1.0, 4, 0 );
+    t1_c.insertcol( vect< double >( {0, 0, 0, 0, 0} ), 1 );
+    t1_c.droprow( 2 );
+    t1_t.setelem( -1.0, 4, 0 );
+    t1_t.insertrow( vect< double >( {9, 9, 9} ), 0 );
+    expectT( "t6. testing edits on column-major and tiled matricies.", t1_c.relayout< row_major >( ), matrix< double >( {1,0,2,3, 4,0,5,6, 10,0,11,12, -1,0,14,15}, 4, 4 ) );
+    expectT( "t7. testing row insertion across tiles.", t1_t.relayout< row_major >( ), matrix< double >( {9,9,9, 1,2,3, 4,5,6, 7,8,9, 10,11,12, -1,14,15}, 6, 3 ) );
+
+    matrix< double > t5_a( 0.0, 37, 29, policy::threaded ), t5_b( 0.0, 29, 41, policy::threaded );
+    for ( size_t i = 0; i < 37; ++i ) for ( size_t j = 0; j < 29; ++j ) t5_a.setelem( double( ( i * 5 + j * 3 ) % 7 ) - 3, i, j );
+    for ( size_t i = 0; i < 29; ++i ) for ( size_t j = 0; j < 41; ++j ) t5_b.setelem( double( ( i * 2 + j ) % 5 ) - 2, i, j );
+    const matrix< double > t5_ref = t5_a % t5_b;
+    const auto t5_ac = t5_a.relayout< col_major >( );
+    const auto t5_bc = t5_b.relayout< col_major >( );
+    const auto t5_bt = t5_b.relayout< tiled< 8 > >( );
+    expectT( "t8. testing a column-major by row-major product.", ( t5_ac % t5_b ).relayout< row_major >( ), t5_ref );
+    expectT( "t9. testing a row-major by column-major product.", t5_a % t5_bc, t5_ref );
+    expectT( "t10. testing a column-major by tiled product.", ( t5_ac % t5_bt ).relayout< row_major >( ), t5_ref );
+
+    matrix< double, col_major > t6_c;
+    gemm( true, true, 1.0, t5_bc, t5_ac, 0.0, t6_c );
+    expectT( "t11. testing transposed gemm into a column-major output.", t6_c.relayout< row_major >( ), t5_ref.t( ) );
+
+    vect< double > t7_x( 29, 1.0 ), t7_z( 37, 1.0 );
+    expectT( "t12. testing a column-major matrix-vector product.", t5_ac % t7_x, t5_a % t7_x );
+    expectT( "t13. testing a vector by column-major matrix product.", t7_z % t5_ac, t7_z % t5_a );
+
+    matrix< double, col_major > t8_d = t5_ac + t5_ac * 2.0 - t5_ac;
+    expectT( "t14. testing element-wise arithmetic within a layout.", t8_d.relayout< row_major >( ), matrix< double >( t5_a * 2.0 ) );
+
+    //-------------u. fixed-size matricies
+    namespace fx = SKAS::fixed;
+
+    constexpr fx::matrix< double, 2, 2 > u1_a( 1, 2, 3, 4 );
+    static_assert( fx::det( u1_a ) == -2.0 && ( u1_a % u1_a )( 1, 0 ) == 15.0 && fx::cross( fx::vect< double, 3 >( 1, 0, 0 ), fx::vect< double, 3 >( 0, 1, 0 ) )[ 2 ] == 1.0 );
+    const matrix< double > u1_d( {1,2,3, 4,5,6}, 2, 3 );
+    const fx::matrix< double, 2, 3 > u1_f( u1_d );
+    const fx::matrix< double, 2, 3 > u1_c( u1_d.relayout< col_major >( ) );
+    expectT( "u1. testing fixed matrix from row- and column-major matricies.", u1_f, u1_c );
+    expectT( "u2. testing fixed matrix back to a dynamic matrix.", u1_f.toMatrix( ), u1_d );
+    expectT( "u3. testing fixed row view to a fixed vect.", fx::vect< double, 3 >( u1_f.row( 1 ).toVect( ) ), fx::vect< double, 3 >( 4, 5, 6 ) );
+
+    fx::matrix< double, 3, 4 > u4_a;
+    fx::matrix< double, 4, 2 > u4_b;
+    testFill( u4_a, 1, 2.0 );
+    testFill( u4_b, 4, 2.0 );
+    const fx::vect< double, 4 > u4_x( 1, -2, 3, 0.5 );
+    expectT( "u4. testing fixed matrix product against the dynamic one.", ( u4_a % u4_b ).toMatrix( ), u4_a.toMatrix( ) % u4_b.toMatrix( ) );
+    expectT( "u5. testing fixed matrix-vect product against the dynamic one.", ( u4_a % u4_x ).toVect( ), u4_a.toMatrix( ) % u4_x.toVect( ) );
+    expectT( "u6. testing fixed vect-matrix product against the dynamic one.", ( u4_a.col( 1 ) % u4_a ).toVect( ), u4_a.col( 1 ).toVect( ) % u4_a.toMatrix( ) );
+
+    fx::matrix< double, 3, 3 > u7_3;
+    fx::matrix< double, 4, 4 > u7_4;
+    fx::matrix< double, 6, 6 > u7_6;
+    testFill( u7_3, 2, 2.0 );
+    testFill( u7_4, 5, 2.0 );
+    testFill( u7_6, 3, 2.0 );
+    expectNear( "u7. testing closed-form 3x3 determinant against lu.", fx::det( u7_3 ), det( u7_3.toMatrix( ) ) );
+    expectNear( "u8. testing closed-form 4x4 determinant against lu.", fx::det( u7_4 ), det( u7_4.toMatrix( ) ) );
+    expectNear( "u9. testing eliminated 6x6 determinant against lu.", fx::det( u7_6 ), det( u7_6.toMatrix( ) ) );
+    expectNear( "u10. testing closed-form 2x2 inverse.", fx::invert( u1_a ) % u1_a, fx::matrix< double, 2, 2 >::identity( ) );
+    expectNear( "u11. testing closed-form 3x3 inverse.", fx::invert( u7_3 ) % u7_3, fx::matrix< double, 3, 3 >::identity( ) );
+    expectNear( "u12. testing closed-form 4x4 inverse.", u7_4 % fx::invert( u7_4 ), fx::matrix< double, 4, 4 >::identity( ) );
+    expectNear( "u13. testing eliminated 6x6 inverse.", fx::invert( u7_6 ) % u7_6, fx::matrix< double, 6, 6 >::identity( ) );
+
+    const fx::matrix< double, 3, 3 > u14_3 = u7_3 % u7_3.t( );
+    const fx::matrix< double, 6, 6 > u14_6 = u7_6 % u7_6.t( );
+    const fx::matrix< double, 2, 2 > u14_2( 4, 2, 2, 3 );
+    const auto u14_l3 = fx::cholesky( u14_3 );
+    expectNear( "u14. testing fixed 3x3 cholesky reproduces the matrix.", u14_l3 % u14_l3.t( ), u14_3 );
+    expectT( "u15. testing fixed cholesky is lower triangular.", u14_l3( 0, 2 ), 0.0 );
+    expectNear( "u16. testing fixed 6x6 cholesky against the dynamic one.", fx::matrix< double, 6, 6 >( cholesky( u14_6.toMatrix( ) ) ), fx::cholesky( u14_6 ) );
+    expectNear( "u17. testing fixed 2x2 cholesky reproduces the matrix.", fx::cholesky( u14_2 ) % fx::cholesky( u14_2 ).t( ), u14_2 );
+
+    const fx::vect< double, 6 > u18_b( 1, 2, 3, 4, 5, 6 );
+    const fx::vect< double, 3 > u18_c( 1, -1, 2 );
+    expectNear( "u18. testing fixed 6x6 solve against the dynamic one.", fx::solve( u7_6, u18_b ), fx::vect< double, 6 >( solve( u7_6.toMatrix( ), u18_b.toVect( ) ) ) );
+    expectNear( "u19. testing fixed 3x3 solve.", u7_3 % fx::solve( u7_3, u18_c ), u18_c );
+
+    expectThrow< SKAS::solutionError >( "u20. testing a singular fixed matrix throws on invert.", [&]( ) { fx::invert( fx::matrix< double, 3, 3 >( 1, 2, 3, 2, 4, 6, 0, 1, 1 ) ); } );
+    expectThrow< SKAS::solutionError >( "u21. testing an indefinite fixed matrix throws on cholesky.", [&]( ) { fx::cholesky( fx::matrix< double, 2, 2 >( 1, 2, 2, 1 ) ); } );
+
+    //-------------v. batched small matricies
+    std::vector< matrix< double > > v_items, v_rhs;
+    for ( size_t b = 0; b < 37; ++b )
+    {
+        matrix< double > a( 0.0, 12, 12 ), r( 0.0, 12, 3 );
+        testFill( a, b, 2.0 );
+        testFill( r, b + 5 );
+        v_items.push_back( a );
+        v_rhs.push_back( r );
+    }
+    const std::vector< std::pair< policy, std::string > > v_policies{ { policy::seq, "seq" }, { policy::threaded, "threaded" }, { policy::device, "device" } };
+
+    const batch< double > v1_a( v_items, policy::threaded ), v1_r( v_rhs, policy::threaded );
+    expectT( "v1. testing batch size.", v1_a.size( ), size_t{37} );
+    expectT( "v2. testing batch item stride.", v1_a.stride( ), size_t{144} );
+    expectT( "v3. testing batch get copies an item out.", v1_a.get( 5 ), v_items[ 5 ] );
+    expectT( "v4. testing batch item view indexing.", v1_a.item( 36 )( 2, 3 ), v_items[ 36 ].at( 2, 3 ) );
+
+    for ( const auto& [ v5_p, v5_name ] : v_policies )
+    {
+        batch< double > v5_a( v1_a ), v5_r( v1_r ), v5_c;
+        v5_a.set_policy( v5_p );
+        v5_r.set_policy( v5_p );
+        gemm( true, false, 2.0, v5_a, v5_r, 0.0, v5_c );
+        for ( size_t b = 0; b < 37; b += 9 ) expectNear( "v5. testing batched gemm on " + v5_name + ", item " + std::to_string( b ) + ".", v5_c.get( b ), v_items[ b ].t( ) % v_rhs[ b ] * 2.0 );
+    }
+
+    for ( const auto& [ v6_p, v6_name ] : v_policies )
+    {
+        if ( v6_p == policy::seq ) continue;
+        batch< double > v6_a( v1_a );
+        v6_a.set_policy( v6_p );
+        const batch< double > v6_x = solve( v6_a, v1_r );
+        for ( size_t b = 0; b < 37; b += 6 ) expectNear( "v6. testing batched lu solve on " + v6_name + ", item " + std::to_string( b ) + ".", v6_x.get( b ), solve( v_items[ b ], v_rhs[ b ] ) );
+    }
+
+    std::vector< matrix< double > > v7_spd;
+    for ( const matrix< double >& a : v_items ) v7_spd.push_back( a % a.t( ) );
+    for ( const auto& [ v7_p, v7_name ] : v_policies )
+    {
+        if ( v7_p == policy::seq ) continue;
+        const batch< double > v7_a( v7_spd, v7_p );
+        const batch< double > v7_l = cholesky( v7_a );
+        const batch< double > v7_x = solve( v7_a, v1_r, "spd" );
+        for ( size_t b = 0; b < 37; b += 5 )
+        {
+            expectNear( "v7. testing batched cholesky on " + v7_name + ", item " + std::to_string( b ) + ".", v7_l.get( b ), cholesky( v7_spd[ b ] ) );
+            expectNear( "v8. testing batched spd solve on " + v7_name + ", item " + std::to_string( b ) + ".", v7_spd[ b ] % v7_x.get( b ), v_rhs[ b ] );
+        }
+    }
+
+    const batch< double > v9_l = cholesky( batch< double >( v7_spd, policy::threaded ) );
+    batch< double > v9_x( v1_r ), v9_y( v1_r );
+    trsm( true, false, v9_l, v9_x );
+    trsm( true, true, v9_l, v9_y );
+    expectNear( "v9. testing batched lower triangular solve.", v9_l.get( 3 ) % v9_x.get( 3 ), v_rhs[ 3 ] );
+    expectNear( "v10. testing batched transposed triangular solve.", v9_l.get( 30 ).t( ) % v9_y.get( 30 ), v_rhs[ 30 ] );
+
+    std::vector< matrix< double > > v11_bad( v_items.begin( ), v_items.begin( ) + 4 );
+    v11_bad[ 2 ] = matrix< double >( 1.0, 12, 12 );
+    const batch< double > v11_r( std::vector< matrix< double > >( v_rhs.begin( ), v_rhs.begin( ) + 4 ) );
+    expectThrow< SKAS::solutionError >( "v11. testing a singular item fails the batched solve.", [&]( ) { solve( batch< double >( v11_bad, policy::device ), v11_r ); } );
+
+    //-------------w. sparse matricies
+    coo_builder< double > w1_b( 4, 5 );
+    w1_b.add( 2, 4, 1.5 );
+    w1_b.add( 0, 1, 2.0 );
+    w1_b.add( 2, 0, -1.0 );
+    w1_b.add( 0, 1, 1.0 );
+    w1_b.add( 3, 3, 4.0 );
+    const sparse_matrix< double > w1_s = w1_b.build( );
+    const matrix< double > w1_d( {0,3,0,0,0, 0,0,0,0,0, -1,0,0,0,1.5, 0,0,0,4,0}, 4, 5 );
+    expectT( "w1. testing coo assembly sums duplicates.", w1_s.nnz( ), size_t{4} );
+    expectT( "w2. testing coo assembly sorts the columns of each row.", w1_s.columns( ), std::vector< size_t >( {1, 0, 4, 3} ) );
+    expectT( "w3. testing element lookup of a summed entry.", w1_s.at( 0, 1 ), 3.0 );
+    expectT( "w4. testing element lookup of an empty entry.", w1_s.at( 1, 1 ), 0.0 );
+    expectT( "w5. testing build empties the builder.", w1_b.size( ), size_t{0} );
+    expectT( "w6. testing sparse to dense.", w1_s.todense( ), w1_d );
+    expectT( "w7. testing dense to sparse.", sparse_matrix< double >( w1_d ), w1_s );
+    expectT( "w8. testing sparse transpose.", w1_s.t( ).todense( ), w1_d.t( ) );
+
+    coo_builder< double > w9_b( 300, 260 );
+    for ( size_t i = 0; i < 300; ++i )
+    {
+        for ( size_t j = ( i * 7 ) % 13; j < 260; j += 13 + i % 5 ) w9_b.add( i, j, double( ( i + 2 * j ) % 9 ) - 4 );
+    }
+    const sparse_matrix< double > w9_s = w9_b.build( policy::threaded );
+    const matrix< double > w9_d = w9_s.todense( );
+    vect< double > w9_x( 260, 0.0 );
+    for ( size_t j = 0; j < 260; ++j ) w9_x[ j ] = double( j % 7 ) - 3;
+    for ( const auto& [ w9_p, w9_name ] : v_policies )
+    {
+        sparse_matrix< double > w9_a( w9_s );
+        w9_a.set_policy( w9_p );
+        vect< double > w9_xp( w9_x );
+        w9_xp.set_policy( w9_p );
+        expectT( "w9. testing spmv on " + w9_name + " against the dense product.", w9_a % w9_xp, vect< double >( w9_d % w9_x ) );
+    }
+
+    matrix< double > w10_b( 0.0, 260, 17 );
+    for ( size_t i = 0; i < 260; ++i ) for ( size_t j = 0; j < 17; ++j ) w10_b.setelem( double( ( i * 3 + j ) % 5 ) - 2, i, j );
+    sparse_matrix< double > w10_dev( w9_s );
+    w10_dev.set_policy( policy::device );
+    matrix< double > w10_bd( w10_b );
+    w10_bd.set_policy( policy::device );
+    expectT( "w10. testing spmm on the host.", w9_s % w10_b, matrix< double >( w9_d % w10_b ) );
+    expectT( "w11. testing spmm on the device.", w10_dev % w10_bd, matrix< double >( w9_d % w10_b ) );
+
+    const sparse_matrix< double > w12_t = w9_s.t( );
+    expectT( "w12. testing spgemm against the dense product.", ( w9_s % w12_t ).todense( ), matrix< double >( w9_d % w9_d.t( ) ) );
+    expectT( "w13. testing spgemm of the transpose against the dense product.", ( w12_t % w9_s ).todense( ), matrix< double >( w9_d.t( ) % w9_d ) );
+
+    vect< double > w14_y( 300, 1.0 );
+    spmv( 2.0, w9_s, w9_x, -1.0, w14_y );
+    expectT( "w14. testing spmv accumulation.", w14_y, vect< double >( w9_d % w9_x * 2.0 - vect< double >( 300, 1.0 ) ) );
+
+    //-------------x. krylov solvers
+    // 5-point laplacian on a 20 x 20 grid, and the same with a one-sided convection term
+    coo_builder< double > x1_b( 400, 400 ), x10_b( 400, 400 );
+    for ( size_t i = 0; i < 400; ++i )
+    {
+        x1_b.add( i, i, 4.0 );
+        x10_b.add( i, i, 4.0 );
+        for ( size_t j : { i + 1, i + 20 } )
+        {
+            if ( j >= 400 || ( j == i + 1 && j % 20 == 0 ) ) continue;
+            x1_b.add( i, j, -1.0 );
+            x1_b.add( j, i, -1.0 );
+            x10_b.add( i, j, -1.6 );
+            x10_b.add( j, i, -0.4 );
+        }
+    }
+    const sparse_matrix< double > x1_a = x1_b.build( );
+    const sparse_matrix< double > x10_a = x10_b.build( );
+    vect< double > x1_rhs( 400, 0.0 );
+    for ( size_t i = 0; i < 400; ++i ) x1_rhs[ i ] = double( i % 11 ) - 5;
+    const krylov_options< double > x1_opts{ 1e-10, 2000, 5, 30 };
+
+    for ( const auto& [ x1_p, x1_name ] : v_policies )
+    {
+        sparse_matrix< double > x1_ap( x1_a );
+        x1_ap.set_policy( x1_p );
+        vect< double > x1_x, x1_xj, x1_xi;
+        const krylov_result< double > x1_r = cg( x1_ap, x1_rhs, x1_x, x1_opts );
+        const krylov_result< double > x1_rj = cg( x1_ap, x1_rhs, x1_xj, x1_opts, jacobi< double >( x1_ap ) );
+        const krylov_result< double > x1_ri = cg( x1_ap, x1_rhs, x1_xi, x1_opts, ichol< double >( x1_ap ) );
+        expectT( "x1. testing cg converges on " + x1_name + ".", x1_r.converged, true );
+        expectNear( "x2. testing cg solves the system on " + x1_name + ".", x1_a % x1_x, x1_rhs, 1e-8 );
+        expectT( "x3. testing jacobi cg converges on " + x1_name + ".", x1_rj.converged, true );
+        expectNear( "x4. testing jacobi cg solves the system on " + x1_name + ".", x1_a % x1_xj, x1_rhs, 1e-8 );
+        expectT( "x5. testing ic(0) cg converges on " + x1_name + ".", x1_ri.converged, true );
+        expectNear( "x6. testing ic(0) cg solves the system on " + x1_name + ".", x1_a % x1_xi, x1_rhs, 1e-8 );
+        expectT( "x7. testing ic(0) cuts cg iterations on " + x1_name + ".", x1_ri.iterations < x1_r.iterations, true );
+    }
+
+    const sparse_matrix< double > x8_l = ichol< double >( x1_a ).factor( );
+    const matrix< double > x8_ld = x8_l.todense( );
+    const matrix< double > x8_llt = x8_ld % x8_ld.t( );
+    std::vector< double > x8_on_pattern;
+    for ( size_t i = 0; i < 400; ++i )
+    {
+        for ( size_t e = x1_a.row_offsets( )[ i ]; e < x1_a.row_offsets( )[ i + 1 ]; ++e ) x8_on_pattern.push_back( x8_llt.at( i, x1_a.columns( )[ e ] ) );
+    }
+    expectT( "x8. testing ic(0) keeps the lower pattern of A.", x8_l.nnz( ), ( x1_a.nnz( ) + 400 ) / 2 );
+    expectNear( "x9. testing ic(0) matches A on its sparsity pattern.", x8_on_pattern, x1_a.values( ), 1e-12 );
+
+    for ( const auto& [ x10_p, x10_name ] : v_policies )
+    {
+        sparse_matrix< double > x10_ap( x10_a );
+        x10_ap.set_policy( x10_p );
+        vect< double > x10_xb, x10_xg, x10_xgj;
+        const krylov_result< double > x10_rb = bicgstab( x10_ap, x1_rhs, x10_xb, x1_opts, jacobi< double >( x10_ap ) );
+        const krylov_result< double > x10_rg = gmres( x10_ap, x1_rhs, x10_xg, x1_opts );
+        const krylov_result< double > x10_rgj = gmres( x10_ap, x1_rhs, x10_xgj, x1_opts, jacobi< double >( x10_ap ) );
+        expectT( "x10. testing jacobi bicgstab converges on " + x10_name + ".", x10_rb.converged, true );
+        expectNear( "x11. testing jacobi bicgstab solves the system on " + x10_name + ".", x10_a % x10_xb, x1_rhs, 1e-8 );
+        expectT( "x12. testing gmres converges on " + x10_name + ".", x10_rg.converged, true );
+        expectNear( "x13. testing gmres solves the system on " + x10_name + ".", x10_a % x10_xg, x1_rhs, 1e-8 );
+        expectT( "x14. testing jacobi gmres converges on " + x10_name + ".", x10_rgj.converged, true );
+        expectNear( "x15. testing jacobi gmres solves the system on " + x10_name + ".", x10_a % x10_xgj, x1_rhs, 1e-8 );
+    }
+
+    matrix< double > x16_a( 0.0, 60, 60 );
+    testFill( x16_a, 0, 10.0 );
+    vect< double > x16_rhs( 60, 0.0 );
+    for ( size_t i = 0; i < 60; ++i ) x16_rhs[ i ] = double( i % 4 ) + 1;
+    matrix< double > x16_dev( x16_a );
+    x16_dev.set_policy( policy::device );
+    vect< double > x16_x, x16_xd( 60, 1.0 );
+    const krylov_result< double > x16_r = gmres( x16_a, x16_rhs, x16_x, x1_opts );
+    const krylov_result< double > x16_rd = bicgstab( x16_dev, x16_rhs, x16_xd, x1_opts );
+    expectT( "x16. testing gmres on a dense host operator converges.", x16_r.converged, true );
+    expectNear( "x17. testing gmres on a dense host operator solves the system.", x16_a % x16_x, x16_rhs, 1e-8 );
+    expectT( "x18. testing bicgstab on a dense device operator converges.", x16_rd.converged, true );
+    expectNear( "x19. testing bicgstab on a dense device operator solves the system.", x16_a % x16_xd, x16_rhs, 1e-8 );
+
+    vect< double > x20_x;
+    const krylov_result< double > x20_r = cg( x1_a, x1_rhs, x20_x, krylov_options< double >{ 1e-12, 7, 3, 30 } );
+    expectT( "x20. testing the iteration cap stops the solve.", x20_r.iterations, size_t{7} );
+    expectT( "x21. testing the iteration cap reports no convergence.", x20_r.converged, false );
+    expectT( "x22. testing the iteration cap reports the residual reached.", x20_r.residual > 1e-12, true );
+
+    expectThrow< SKAS::solutionError >( "x23. testing ic(0) rejects an indefinite matrix.", [&]( ) { ichol< double >( sparse_matrix< double >( 2, 2, {0,2,4}, {0,1,0,1}, {1.0,2.0,2.0,1.0} ) ); } );
+
     return EXIT_SUCCESS;
-}
\ No newline at end of file
+}
@@ -4,8 +4,34 @@
 #include "vect.h"
 #include "testing.h"
 #include <typeinfo>
+#include <utility>
+#include <string>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <atomic>
 #include <sycl/sycl.hpp>
 
+// every heap allocation of the test binary, for the allocation-free paths checked in section m
+static std::atomic< size_t > heap_allocs{ 0 };
+
+auto operator new( std::size_t bytes ) -> void*
+{
+    ++heap_allocs;
+    if ( void* p = std::malloc( bytes ? bytes : 1 ) ) return p;
+    throw std::bad_alloc{ };
+}
+
+auto operator delete( void* p ) noexcept -> void
+{
+    std::free( p );
+}
+
+auto operator delete( void* p, std::size_t ) noexcept -> void
+{
+    std::free( p );
+}
+
 auto main( ) -> int
 {
     using namespace SKAS::vect;
@@ -105,7 +131,237 @@ auto main( ) -> int
 
     vect< double > d7_1( {1,3,4,5,6}, true );
     double d7_2 = 3.7;
-    expectT( "d7. testing parallel s2.", s2( d7_1 ), d7_2 );
+    expectNear( "d7. testing parallel s2.", s2( d7_1 ), d7_2, 1e-12 );
+
+    //----------- e. device residency
+    vect< double > e1_1( {1,2,3,4}, true );
+    vect< double > e1_2( {4,3,2,1}, true );
+    vect< double > e1_3 = ( e1_1 + e1_2 ) - e1_2;
+    expectT( "e1. testing chained parallel ops stay on device.", e1_3.residence( ) == residency::device, true );
+
+    expectT( "e2. testing host access syncs device result.", std::as_const( e1_3 )[ 2 ], double{3} );
+
+    expectT( "e3. testing host access marks vect synced.", e1_3.residence( ) == residency::synced, true );
+
+    e1_3[ 0 ] = 10;
+    expectT( "e4. testing host write marks device mirror stale.", e1_3.residence( ) == residency::host, true );
+
+    vect< double > e5( {11,4,6,8}, true );
+    expectT( "e5. testing stale mirror is re-uploaded.", e1_3 + e1_1, e5 );
+
+    vect< double > e6 = e1_1 * double{2};
+    auto e6_copy = e6;
+    e6.release_device( );
+    expectT( "e6. testing copy of device-resident vect.", e6_copy, e6 );
+
+    //----------- f. pooled device memory
+    auto& f_pool = SKAS::gpu::ctx( ).pool;
+    vect< double > f1_1( 1000, 1.0, true );
+    vect< double > f1_2( 1000, 2.0, true );
+    vect< double > f1_3( 1000, true );
+    f1_3 = f1_1 + f1_2;
+    double f1_dot = f1_3 * f1_1;
+    auto f1_before = f_pool.stats( ).device_allocs;
+    for ( int i = 0; i < 10; ++i )
+    {
+        f1_3 = f1_1 + f1_2;
+        f1_dot = f1_3 * f1_1;
+    }
+    expectT( "f1. testing steady-state ops make no device allocations.", f_pool.stats( ).device_allocs, f1_before );
+
+    expectT( "f2. testing steady-state ops still compute.", f1_dot, double{3000} );
+
+    expectT( "f3. testing pool reuse of returned blocks.", f_pool.stats( ).hits > 0, true );
+
+    f_pool.trim( 0 );
+    expectT( "f4. testing trim releases cached blocks.", f_pool.stats( ).bytes_cached, size_t{0} );
+
+    //----------- g. asynchronous operations
+    using namespace SKAS::vect::accel_vect;
+    vect< double > g1_1( {1,2,3,4}, true );
+    vect< double > g1_2( {4,3,2,1}, true );
+    auto g1_sum = PV_add_async( g1_1, g1_2 );
+    auto g1_dot = PV_dot_async( g1_sum.result( ), g1_1, { g1_sum.event( ) } );
+    auto g1_mean = PV_mean_async( g1_1 );
+    auto g1_s2 = PV_s2_async( g1_2 );
+    SKAS::gpu::wait_all( g1_sum, g1_dot, g1_mean, g1_s2 );
+    expectT( "g1. testing async add.", g1_sum.wait( ), vect< double >( {5,5,5,5} ) );
+
+    expectT( "g2. testing async dot chained on async add.", g1_dot.wait( ), double{50} );
+
+    expectT( "g3. testing async mean.", g1_mean.wait( ), double{2.5} );
+
+    expectT( "g4. testing async s2 matches blocking s2.", g1_s2.wait( ), s2( g1_2 ) );
+
+    vect< float > g5_1( {1,5,6,2}, true );
+    vect< float > g5_2( {45,4,312,41}, true );
+    auto g5 = PV_cov_async( g5_1, g5_2 );
+    expectT( "g5. testing async cov.", g5.wait( ), cov( d6_1, d6_2 ) );
+
+    PV_dot_async( g1_1, g1_2 );
+    {
+        auto g6_dropped = PV_mean_async( g1_1 );
+    }
+    expectT( "g6. testing dropped un-waited scalar handles leave later ops intact.", PV_dot_async( g1_1, g1_2 ).wait( ), double{20} );
+
+    auto g7 = PV_dot_async( g1_1, g1_1 );
+    auto g7_copy = g7;
+    g7 = PV_mag_async( g1_2 );
+    expectT( "g7. testing a copied handle outlives reassignment of the original.", g7_copy.wait( ), double{30} );
+
+    //----------- h. fused expressions
+    vect< double > h1_1( {1,2,3,4}, false );
+    vect< double > h1_2( {4,3,2,1}, false );
+    vect< double > h1_3( {1,1,1,1}, false );
+    vect< double > h1_4 = h1_1 + h1_2 * 2.0 - h1_3;
+    vect< double > h1_5( {8,7,6,5} );
+    expectT( "h1. testing fused host expression.", h1_4, h1_5 );
+
+    vect< double > h2_1( {1,2,3,4}, true );
+    vect< double > h2_2( {4,3,2,1}, true );
+    vect< double > h2_3( {1,1,1,1}, true );
+    vect< double > h2_4 = h2_1 + h2_2 * 2.0 - h2_3;
+    expectT( "h2. testing fused device expression stays on device.", h2_4.residence( ) == residency::device, true );
+
+    expectT( "h3. testing fused device expression.", h2_4, h1_5 );
+
+    expectT( "h4. testing fused reduction of expressions.", ( h2_1 + h2_2 ) * ( h2_1 - h2_3 ), double{30} );
+
+    h1_1 = h1_1 + h1_1;
+    expectT( "h5. testing aliased assignment.", h1_1, vect< double >( {2,4,6,8} ) );
+
+    //----------- i. fused statistics
+    vect< double > i1_1( {2,4,4,4,5,5,7,9}, false );
+    vect< double > i1_2( {1,3,2,5,4,6,8,9}, false );
+    vect< double > i1_3( {2,4,4,4,5,5,7,9}, true );
+    vect< double > i1_4( {1,3,2,5,4,6,8,9}, true );
+    auto i1_m = moments( i1_1, i1_2 );
+    expectT( "i1. testing single-pass moments mean.", i1_m.mean_a, double{5} );
+
+    expectT( "i2. testing single-pass moments variance.", s2( i1_1 ), double{32.0/7.0} );
+
+    double i3 = cov( i1_1, i1_2 ) / ( s( i1_1 ) * s( i1_2 ) );
+    expectNear( "i3. testing single-pass corr.", corr( i1_1, i1_2 ), i3, 1e-12 );
+
+    expectNear( "i4. testing parallel corr.", corr( i1_3, i1_4 ), i3, 1e-12 );
+
+    vect< double > i5( 3000, true );
+    for ( size_t i = 0; i < i5.size( ); ++i ) i5[ i ] = double( i % 17 ) + 1e6;
+    vect< double > i5_seq( i5.toVect( ) );
+    expectNear( "i5. testing multi-group device moments merge.", s2( i5 ), s2( i5_seq ), 1e-6 );
+
+    vect< double > h6( 1000, 1.0, true );
+    expectT( "h6. testing multi-group fused reduction.", ( h6 + h6 ) * h6, double{2000} );
+
+    vect< float > h7_1( {1,2,3,4}, false );
+    vect< float > h7_2 = h7_1 + h1_5 - h1_3;
+    expectT( "h7. testing mixed-precision operands promote to the left type.", h7_2, vect< float >( {8,8,8,8} ) );
+
+    expectT( "h8. testing mixed-precision dot.", h7_1 * h1_5, float{60} );
+
+    //----------- j. execution policies
+    using SKAS::exec::policy;
+    vect< double > j1( {1,2,3}, policy::threaded );
+    auto j1_copy = j1;
+    expectT( "j1. testing copy keeps execution policy.", j1_copy.get_policy( ) == policy::threaded, true );
+
+    vect< double > j2_1( 100000, 1.0, policy::threaded );
+    vect< double > j2_2( 100000, 2.0, policy::threaded );
+    vect< double > j2_3 = j2_1 + j2_2 * 2.0;
+    expectT( "j2. testing threaded fused expression.", j2_3, vect< double >( 100000, 5.0 ) );
+
+    expectT( "j3. testing result carries operand policy.", j2_3.get_policy( ) == policy::threaded, true );
+
+    vect< float > j4( 1001, 2.0f, policy::simd );
+    expectT( "j4. testing simd dot product.", j4 * j4, float{4004} );
+
+    vect< double > j5_1( {1,2,3,4}, true );
+    vect< double > j5_2 = j5_1 + vect< double >( {1,1,1,1}, policy::simd );
+    expectT( "j5. testing mixed device and host operands run on the host policy.", j5_2.get_policy( ) == policy::simd, true );
+
+    vect< double > j6_1( 50000, policy::threaded );
+    for ( size_t i = 0; i < j6_1.size( ); ++i ) j6_1[ i ] = double( i % 101 ) * 0.5;
+    vect< double > j6_2( j6_1.toVect( ) );
+    expectNear( "j6. testing threaded s2 matches sequential s2.", s2( j6_1 ), s2( j6_2 ), 1e-9 );
+
+    //----------- k. automatic dispatch
+    using SKAS::gpu::op_kind;
+    auto& k_table = SKAS::gpu::ctx( ).dispatch;
+    const auto k_saved = k_table;
+    k_table.device( op_kind::elementwise ) = 1000;
+    k_table.device( op_kind::reduction ) = 1000;
+
+    vect< double > k1_1( {1,2,3,4}, policy::automatic );
+    vect< double > k1_2 = k1_1 + k1_1;
+    expectT( "k1. testing small automatic op stays on the host.", k1_2.residence( ) == residency::host, true );
+
+    expectT( "k2. testing automatic result keeps automatic policy.", k1_2.get_policy( ) == policy::automatic, true );
+
+    vect< double > k3_1( 2000, 1.5, policy::automatic );
+    vect< double > k3_2 = k3_1 + k3_1;
+    expectT( "k3. testing large automatic op runs on the device.", k3_2.residence( ) == residency::device, true );
+
+    expectT( "k4. testing automatic reduction.", k3_2 * k3_1, double{9000} );
+
+    const std::string k5_path = "SKAS_dispatch_test.cache";
+    SKAS::gpu::save_dispatch( k_table, k5_path );
+    auto k5 = SKAS::gpu::load_dispatch( k5_path, k_table.device_name );
+    std::remove( k5_path.c_str( ) );
+    expectT( "k5. testing dispatch cache round trip.", k5.has_value( ) && *k5 == k_table, true );
+    k_table = k_saved;
+
+    //----------- l. copy-on-write storage
+    vect< double > l1_1( {1,2,3,4}, policy::seq );
+    vect< double > l1_2 = l1_1;
+    expectT( "l1. testing copies share storage.", l1_2.shares( l1_1 ), true );
+
+    l1_2[ 0 ] = 9;
+    expectT( "l2. testing a write detaches the copy.", l1_2.shares( l1_1 ), false );
+    expectT( "l3. testing a write leaves the source unchanged.", l1_1[ 0 ], 1.0 );
+    expectT( "l4. testing a write lands in the copy.", l1_2[ 0 ], 9.0 );
+
+    vect< double > l3_1( 1000, 2.0, policy::device );
+    vect< double > l3_2 = l3_1 + l3_1;
+    vect< double > l3_3 = l3_2;
+    l3_3 = l3_3 * 0.5;
+    expectT( "l5. testing a device result stays device-resident.", l3_2.residence( ) == residency::device, true );
+    expectT( "l6. testing device copy on write leaves the source unchanged.", l3_2, vect< double >( 1000, 4.0 ) );
+    expectT( "l7. testing device copy on write updates the copy.", l3_3, vect< double >( 1000, 2.0 ) );
+
+    //----------- m. moves and allocation-free paths
+    vect< double > m_a( 4096, 1.0, policy::seq );
+    vect< double > m_b( 4096, 2.0, policy::seq );
+    vect< double > m_out( 4096, policy::seq );
+    m_out = m_a + m_b;
+
+    size_t m_before = heap_allocs;
+    vect< double > m1 = std::move( m_a );
+    m_a = std::move( m1 );
+    const size_t m1_allocs = heap_allocs - m_before;
+    expectT( "m1. testing vect moves do not allocate.", m1_allocs, size_t{0} );
+    expectT( "m2. testing vect move leaves the source empty.", m1.isEmpty( ), true );
+    expectT( "m3. testing vect move keeps the size.", m_a.size( ), size_t{4096} );
+
+    const double* m2_storage = std::as_const( m_a ).data( );
+    m_before = heap_allocs;
+    vect< double > m2 = std::move( m_a ) + m_b;
+    const size_t m2_allocs = heap_allocs - m_before;
+    expectT( "m4. testing a temporary operand does not allocate.", m2_allocs, size_t{0} );
+    expectT( "m5. testing a temporary operand is reused for the result.", std::as_const( m2 ).data( ), m2_storage );
+    expectT( "m6. testing arithmetic on a temporary operand.", m2, vect< double >( 4096, 3.0 ) );
+
+    m_before = heap_allocs;
+    m_out = m2 * 2.0 - m_b;
+    vect< double > m3_copy = m_out;
+    const size_t m3_allocs = heap_allocs - m_before;
+    expectT( "m7. testing assignment into a preallocated output and copies do not allocate.", m3_allocs, size_t{0} );
+    expectT( "m8. testing assignment into a preallocated output.", m3_copy, vect< double >( 4096, 4.0 ) );
+
+    m_before = heap_allocs;
+    m3_copy[ 0 ] = 0.0;
+    const size_t m4_allocs = heap_allocs - m_before;
+    expectF( "m9. testing the first write to a shared copy allocates its own storage.", m4_allocs, size_t{0} );
+    expectT( "m10. testing the first write to a shared copy leaves the source unchanged.", m_out[ 0 ], 4.0 );
 
     return EXIT_SUCCESS;
 }
\ No newline at end of file
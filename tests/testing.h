@@ -5,6 +5,8 @@
 #include <iostream>
 #include <string>
 #include <exception>
+#include <cmath>
+#include <algorithm>
 
 #ifndef TESTING_H
 #define TESTING_H
@@ -22,8 +24,8 @@ class TESTFAILURE : public std::exception
     }
 };
 
-template < typename T >
-auto expectT( std::string message, const T& obj_1, const T& obj_2 ) -> void
+template < typename T, typename U = T >
+auto expectT( std::string message, const T& obj_1, const U& obj_2 ) -> void
 {
     std::cout << "\033[33m[<][>][<][>][<]    " << message << "    [>][<][>][<][>]\033[0m" << std::endl;
     if ( obj_1 == obj_2 )
@@ -33,13 +35,16 @@ auto expectT( std::string message, const T& obj_1, const T& obj_2 ) -> void
     else
     {
         std::cout << "\033[31m[<][>][<][>][<]    FAILED    [>][<][>][<][>]\033[0m" << std::endl;
-        std::cout << "\033[91m | obj_1 = \n" << obj_1 << " |\n\n | obj_2 = \n" << obj_2 << " |\033[0m" << std::endl;
+        if constexpr ( requires { std::cout << obj_1 << obj_2; } )
+        {
+            std::cout << "\033[91m | obj_1 = \n" << obj_1 << " |\n\n | obj_2 = \n" << obj_2 << " |\033[0m" << std::endl;
+        }
         throw TESTFAILURE{ "\033[31m" + message + " -> FAILED: ARE NOT EQUAL.\033[0m" };
     }
 }
 
-template < typename T >
-auto expectF( std::string message, const T& obj_1, const T& obj_2 ) -> void
+template < typename T, typename U = T >
+auto expectF( std::string message, const T& obj_1, const U& obj_2 ) -> void
 {
     std::cout << "\033[33m[<][>][<][>][<]    " << message << "    [>][<][>][<][>]\033[0m" << std::endl;
     if ( obj_1 != obj_2 )
@@ -49,9 +54,99 @@ auto expectF( std::string message, const T& obj_1, const T& obj_2 ) -> void
     else
     {
         std::cout << "\033[31m[<][>][<][>][<]    FAILED    [>][<][>][<][>]\033[0m" << std::endl;
-        std::cout << "\033[91m | obj_1 = \n" << obj_1 << " |\n\n| obj_2 = \n" << obj_2 << " |\033[0m" << std::endl;
+        if constexpr ( requires { std::cout << obj_1 << obj_2; } )
+        {
+            std::cout << "\033[91m | obj_1 = \n" << obj_1 << " |\n\n| obj_2 = \n" << obj_2 << " |\033[0m" << std::endl;
+        }
         throw TESTFAILURE{ "\033[31m" + message + " -> FAILED: ARE EQUAL.\033[0m" };
     }
 }
 
+/**
+ * @brief fills a matrix with a deterministic pattern in [ -0.5, 0.5 ), plus diag on the diagonal
+ */
+template < typename M >
+auto testFill( M& m, size_t seed, double diag = 0.0 ) -> void
+{
+    for ( size_t i = 0; i < m.nrow( ); ++i )
+    {
+        for ( size_t j = 0; j < m.ncol( ); ++j )
+        {
+            const double val = double( ( i * 7 + j * 3 + seed ) % 13 ) / 13.0 - 0.5 + ( i == j ? diag : 0.0 );
+            if constexpr ( requires { m.setelem( val, i, j ); } ) m.setelem( val, i, j );
+            else m( i, j ) = val;
+        }
+    }
+}
+
+/**
+ * @brief element-wise comparison to within tol, relative to the expected magnitude once it exceeds 1
+ */
+template < typename T, typename U >
+auto isNear( const T& obj_1, const U& obj_2, double tol ) -> bool
+{
+    if constexpr ( requires { obj_1.nrow( ); obj_1.ncol( ); } )
+    {
+        if ( obj_1.nrow( ) != obj_2.nrow( ) || obj_1.ncol( ) != obj_2.ncol( ) ) return false;
+        for ( size_t i = 0; i < obj_1.nrow( ); ++i )
+        {
+            for ( size_t j = 0; j < obj_1.ncol( ); ++j )
+            {
+                if constexpr ( requires { obj_1.at( i, j ); } )
+                {
+                    if ( !isNear( double( obj_1.at( i, j ) ), double( obj_2.at( i, j ) ), tol ) ) return false;
+                }
+                else if ( !isNear( double( obj_1( i, j ) ), double( obj_2( i, j ) ), tol ) ) return false;
+            }
+        }
+        return true;
+    }
+    else if constexpr ( requires { obj_1.size( ); obj_1[ 0 ]; } )
+    {
+        if ( obj_1.size( ) != obj_2.size( ) ) return false;
+        for ( size_t i = 0; i < obj_1.size( ); ++i ) if ( !isNear( double( obj_1[ i ] ), double( obj_2[ i ] ), tol ) ) return false;
+        return true;
+    }
+    else return std::abs( double( obj_1 ) - double( obj_2 ) ) <= tol * std::max( 1.0, std::abs( double( obj_2 ) ) );
+}
+
+template < typename T, typename U = T >
+auto expectNear( std::string message, const T& obj_1, const U& obj_2, double tol = 1e-9 ) -> void
+{
+    std::cout << "\033[33m[<][>][<][>][<]    " << message << "    [>][<][>][<][>]\033[0m" << std::endl;
+    if ( isNear( obj_1, obj_2, tol ) )
+    {
+        std::cout << "\033[32m[<][>][<][>][<]    PASSED    [>][<][>][<][>]\033[0m" << std::endl;
+    }
+    else
+    {
+        std::cout << "\033[31m[<][>][<][>][<]    FAILED    [>][<][>][<][>]\033[0m" << std::endl;
+        if constexpr ( requires { std::cout << obj_1 << obj_2; } )
+        {
+            std::cout << "\033[91m | obj_1 = \n" << obj_1 << " |\n\n | obj_2 = \n" << obj_2 << " |\033[0m" << std::endl;
+        }
+        throw TESTFAILURE{ "\033[31m" + message + " -> FAILED: ARE NOT NEAR.\033[0m" };
+    }
+}
+
+/**
+ * @brief passes when f( ) throws an E. any other exception propagates
+ */
+template < typename E, typename F >
+auto expectThrow( std::string message, F f ) -> void
+{
+    std::cout << "\033[33m[<][>][<][>][<]    " << message << "    [>][<][>][<][>]\033[0m" << std::endl;
+    try
+    {
+        f( );
+    }
+    catch ( const E& )
+    {
+        std::cout << "\033[32m[<][>][<][>][<]    PASSED    [>][<][>][<][>]\033[0m" << std::endl;
+        return;
+    }
+    std::cout << "\033[31m[<][>][<][>][<]    FAILED    [>][<][>][<][>]\033[0m" << std::endl;
+    throw TESTFAILURE{ "\033[31m" + message + " -> FAILED: DID NOT THROW.\033[0m" };
+}
+
 #endif
\ No newline at end of file